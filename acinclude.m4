@@ -34,6 +34,40 @@ AC_DEFUN([QL_CHECK_ASINH],
     ])
 ])
 
+# QL_CHECK_OPENMP
+# ----------------------------------------------
+# Check whether the compiler supports OpenMP and, if so, add the
+# needed flag to CXXFLAGS.
+AC_DEFUN([QL_CHECK_OPENMP],
+[AC_MSG_CHECKING([for OpenMP flag])
+ ql_original_CXXFLAGS=$CXXFLAGS
+ ql_openmp_flag=no
+ for ql_flag in "-fopenmp" "-openmp" "-qopenmp" ; do
+     CXXFLAGS="$ql_original_CXXFLAGS $ql_flag"
+     AC_TRY_LINK(
+        [@%:@include <omp.h>],
+        [int n = omp_get_max_threads();],
+        [ql_openmp_flag=$ql_flag
+         break])
+ done
+ AC_MSG_RESULT([$ql_openmp_flag])
+ if test "$ql_openmp_flag" = "no" ; then
+     CXXFLAGS="$ql_original_CXXFLAGS"
+     AC_MSG_ERROR([OpenMP is not supported by the C++ compiler])
+ fi
+])
+
+# QL_CHECK_LAPACK
+# ----------------------------------------------
+# Check whether the BLAS and LAPACK libraries are available and, if
+# so, add them to LIBS.
+AC_DEFUN([QL_CHECK_LAPACK],
+[AC_SEARCH_LIBS([dgemm_], [openblas blas], [],
+    [AC_MSG_ERROR([BLAS library not found])])
+ AC_SEARCH_LIBS([dsyev_], [lapack openblas], [],
+    [AC_MSG_ERROR([LAPACK library not found])])
+])
+
 # QL_CHECK_BOOST_DEVEL
 # --------------------
 # Check whether the Boost headers are available
@@ -36,6 +36,7 @@
 #include <ql/instruments/vanillaswap.hpp>
 
 #include <boost/bind.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -53,6 +54,13 @@ namespace QuantLib {
         smile_(volatilityStructure_->smileSection(expiryDate_, swapTenor_)) {
         }
 
+    BlackVanillaOptionPricer::BlackVanillaOptionPricer(
+            Rate forwardValue,
+            const boost::shared_ptr<SmileSection>& smile)
+    : forwardValue_(forwardValue), smile_(smile) {
+        QL_REQUIRE(smile_, "no smile section given");
+    }
+
     Real BlackVanillaOptionPricer::operator()(Real strike,
                                               Option::Type optionType,
                                               Real deflator) const {
@@ -74,6 +82,12 @@ namespace QuantLib {
       cutoffForCaplet_(2), cutoffForFloorlet_(0),
       meanReversion_(meanReversion) {
           registerWith(meanReversion_);
+          registerWith(Settings::instance().evaluationDate());
+    }
+
+    void HaganPricer::update() {
+        smileSections_.clear();
+        CmsCouponPricer::update();
     }
 
     void HaganPricer::initialize(const FloatingRateCoupon& coupon){
@@ -86,6 +100,11 @@ namespace QuantLib {
         paymentDate_ = coupon_->date();
         const boost::shared_ptr<SwapIndex>& swapIndex = coupon_->swapIndex();
         rateCurve_ = *(swapIndex->forwardingTermStructure());
+        // the stored smile sections and replications depend on the
+        // curves of the index
+        registerWith(swapIndex);
+        if (swapIndex->exogenousDiscount())
+            registerWith(swapIndex->discountingTermStructure());
 
         Date today = Settings::instance().evaluationDate();
 
@@ -134,9 +153,16 @@ namespace QuantLib {
                 default:
                     QL_FAIL("unknown/illegal gFunction type");
             }
+            const std::pair<Date, Period> smileKey(fixingDate_, swapTenor_);
+            SmileSections::const_iterator smile =
+                smileSections_.find(smileKey);
+            if (smile == smileSections_.end()) {
+                smile = smileSections_.insert(std::make_pair(smileKey,
+                    swaptionVolatility()->smileSection(fixingDate_,
+                                                       swapTenor_))).first;
+            }
             vanillaOptionPricer_= boost::shared_ptr<VanillaOptionPricer>(new
-                BlackVanillaOptionPricer(swapRateValue_, fixingDate_, swapTenor_,
-                                        *swaptionVolatility()));
+                BlackVanillaOptionPricer(swapRateValue_, smile->second));
          }
     }
 
@@ -253,6 +279,28 @@ namespace QuantLib {
 
     }
 
+    void NumericHaganPricer::update() {
+        replications_.clear();
+        HaganPricer::update();
+    }
+
+    bool NumericHaganPricer::ReplicationKey::operator<(
+                                     const ReplicationKey& other) const {
+        if (fixingDate != other.fixingDate)
+            return fixingDate < other.fixingDate;
+        if (paymentDate != other.paymentDate)
+            return paymentDate < other.paymentDate;
+        if (optionType != other.optionType)
+            return optionType < other.optionType;
+        if (strike != other.strike)
+            return strike < other.strike;
+        if (forwardValue != other.forwardValue)
+            return forwardValue < other.forwardValue;
+        if (annuity != other.annuity)
+            return annuity < other.annuity;
+        return swapIndexName < other.swapIndexName;
+    }
+
     Real NumericHaganPricer::integrate(Real a,
         Real b, const ConundrumIntegrand& integrand) const {
             double result =.0;
@@ -308,6 +356,30 @@ namespace QuantLib {
     Real NumericHaganPricer::optionletPrice(
                                 Option::Type optionType, Real strike) const {
 
+        ReplicationKey key;
+        key.fixingDate = fixingDate_;
+        key.paymentDate = paymentDate_;
+        key.swapIndexName = coupon_->swapIndex()->name();
+        key.forwardValue = swapRateValue_;
+        key.annuity = annuity_;
+        key.strike = strike;
+        key.optionType = optionType;
+
+        std::map<ReplicationKey, Real>::const_iterator stored =
+            replications_.find(key);
+        if (stored == replications_.end()) {
+            stored = replications_.insert(std::make_pair(key,
+                         replicationValue(optionType, strike))).first;
+        }
+
+        // v. HAGAN, Conundrums..., formule 2.17a, 2.18a
+        return coupon_->accrualPeriod() * (discount_/annuity_) *
+            stored->second;
+    }
+
+    Real NumericHaganPricer::replicationValue(
+                                Option::Type optionType, Real strike) const {
+
         boost::shared_ptr<ConundrumIntegrand> integrand(new
             ConundrumIntegrand(vanillaOptionPricer_, rateCurve_, gFunction_,
                                fixingDate_, paymentDate_, annuity_,
@@ -332,9 +404,7 @@ namespace QuantLib {
         Real swaptionPrice =
             (*vanillaOptionPricer_)(strike, optionType, annuity_);
 
-        // v. HAGAN, Conundrums..., formule 2.17a, 2.18a
-        return coupon_->accrualPeriod() * (discount_/annuity_) *
-            ((1 + dFdK) * swaptionPrice + optionType*integralValue);
+        return (1 + dFdK) * swaptionPrice + optionType*integralValue;
     }
 
     Real NumericHaganPricer::swapletPrice() const {
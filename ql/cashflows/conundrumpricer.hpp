@@ -25,6 +25,7 @@
 
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <map>
 
 namespace QuantLib {
 
@@ -48,6 +49,9 @@ namespace QuantLib {
                 const Period& swapTenor,
                 const boost::shared_ptr<SwaptionVolatilityStructure>&
                                                          volatilityStructure);
+        BlackVanillaOptionPricer(
+                Rate forwardValue,
+                const boost::shared_ptr<SmileSection>& smile);
 
         Real operator()(Real strike,
                         Option::Type optionType,
@@ -213,6 +217,10 @@ namespace QuantLib {
             registerWith(meanReversion_);
             update();
         };
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
       protected:
         HaganPricer(
                 const Handle<SwaptionVolatilityStructure>& swaptionVol,
@@ -238,6 +246,13 @@ namespace QuantLib {
         Handle<Quote> meanReversion_;
         Period swapTenor_;
         boost::shared_ptr<VanillaOptionPricer> vanillaOptionPricer_;
+      private:
+        /* smile sections are shared by the coupons fixing on the
+           same date on the same swap tenor; they are dropped
+           whenever the pricer is notified of a change. */
+        typedef std::map<std::pair<Date, Period>,
+                         boost::shared_ptr<SmileSection> > SmileSections;
+        SmileSections smileSections_;
     };
 
 
@@ -245,6 +260,16 @@ namespace QuantLib {
     /*! Prices a cms coupon via static replication as in Hagan's
         "Conundrums..." article via numerical integration based on
         prices of vanilla swaptions
+
+        The replication integrals are memoized: coupons on the same
+        swap index with the same fixing and payment dates, forward
+        swap rate, annuity and strike reuse the stored value instead
+        of integrating again. The memo is cleared whenever the
+        volatility structure, the mean reversion, the evaluation date
+        or the swap index of any priced coupon (and thus its curves)
+        notify a change, so that it doesn't grow across scenarios.
+        Coupons sharing a replication only need to share the pricer;
+        the order in which they are priced doesn't matter.
     */
     class NumericHaganPricer : public HaganPricer {
       public:
@@ -258,6 +283,12 @@ namespace QuantLib {
 
        Real upperLimit() { return upperLimit_; }
        Real stdDeviations() { return stdDeviationsForUpperLimit_; }
+       //! \name Observer interface
+       //@{
+       void update();
+       //@}
+       //! number of replication integrals currently stored
+       Size storedReplications() const { return replications_.size(); }
 
       //private:
         class Function : public std::unary_function<Real, Real> {
@@ -304,11 +335,21 @@ namespace QuantLib {
         virtual Real optionletPrice(Option::Type optionType,
                                     Rate strike) const;
         virtual Real swapletPrice() const;
+        Real replicationValue(Option::Type optionType, Rate strike) const;
         Real resetUpperLimit(Real stdDeviationsForUpperLimit) const;
         Real refineIntegration(Real integralValue, const ConundrumIntegrand& integrand) const;
 
         mutable Real upperLimit_, stdDeviationsForUpperLimit_;
         const Real lowerLimit_, requiredStdDeviations_, precision_, refiningIntegrationTolerance_;
+
+        struct ReplicationKey {
+            Date fixingDate, paymentDate;
+            std::string swapIndexName;
+            Real forwardValue, annuity, strike;
+            Option::Type optionType;
+            bool operator<(const ReplicationKey& other) const;
+        };
+        mutable std::map<ReplicationKey, Real> replications_;
     };
 
     //! CMS-coupon pricer
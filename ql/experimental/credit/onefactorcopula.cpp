@@ -48,11 +48,68 @@ namespace QuantLib {
     //-------------------------------------------------------------------------
         calculate ();
         vector<Real> p (prob.size(), 0);
-        for (Size i = 0; i < p.size(); i++)
-            p[i] = conditionalProbability (prob[i], m);
+        conditionalProbability (prob, thresholds (prob), m, p);
         return p;
     }
 
+    //-------------------------------------------------------------------------
+    Matrix OneFactorCopula::conditionalProbability(const vector<Real>& prob,
+                                                   const vector<Real>& m)
+                                                                        const {
+    //-------------------------------------------------------------------------
+        calculate ();
+        vector<Real> y = thresholds (prob);
+        vector<Real> p (prob.size(), 0);
+        Matrix result (m.size(), prob.size());
+        for (Size j = 0; j < m.size(); j++) {
+            conditionalProbability (prob, y, m[j], p);
+            std::copy (p.begin(), p.end(), result.row_begin(j));
+        }
+        return result;
+    }
+
+    //-------------------------------------------------------------------------
+    vector<Real> OneFactorCopula::thresholds (const vector<Real>& prob) const {
+    //-------------------------------------------------------------------------
+        calculate ();
+        vector<Real> y (prob.size(), 0);
+        for (Size i = 0; i < y.size(); i++) {
+            // same cut-off as in the scalar version, see FIXME there
+            if (prob[i] >= 1e-10)
+                y[i] = inverseCumulativeY (prob[i]);
+        }
+        return y;
+    }
+
+    //-------------------------------------------------------------------------
+    void OneFactorCopula::conditionalProbability(const vector<Real>& prob,
+                                                 const vector<Real>& y,
+                                                 Real m,
+                                                 vector<Real>& p) const {
+    //-------------------------------------------------------------------------
+        QL_REQUIRE (prob.size() == y.size(),
+                    "number of probabilities (" << prob.size()
+                    << ") does not match number of thresholds ("
+                    << y.size() << ")");
+        calculate ();
+        p.resize (prob.size());
+
+        Real c = correlation_->value();
+        Real shift = sqrt(c) * m;
+        Real scale = sqrt (1. - c);
+
+        for (Size i = 0; i < p.size(); i++) {
+            if (prob[i] < 1e-10) {
+                p[i] = 0;
+                continue;
+            }
+            Real res = cumulativeZ ((y[i] - shift) / scale);
+            QL_REQUIRE (res >= 0 && res <= 1,
+                        "conditional probability " << res << "out of range");
+            p[i] = res;
+        }
+    }
+
     //-------------------------------------------------------------------------
     Real OneFactorCopula::cumulativeY (Real y) const {
     //-------------------------------------------------------------------------
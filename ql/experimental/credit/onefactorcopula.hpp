@@ -25,6 +25,7 @@
 #define quantlib_one_factor_copula_hpp
 
 #include <ql/experimental/credit/distribution.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/quote.hpp>
 
@@ -156,6 +157,34 @@ namespace QuantLib {
         std::vector<Real> conditionalProbability(const std::vector<Real>& prob,
                                                  Real m) const;
 
+        //! Conditional probabilities on a grid of factor values
+        /*! Returns the matrix \f$ \hat p_i(m_j) \f$ with one row per
+            factor value \f$ m_j \f$ and one column per probability
+            \f$ p_i \f$.  The inverse cumulative distribution of Y is
+            evaluated only once per probability.
+        */
+        Matrix conditionalProbability(const std::vector<Real>& prob,
+                                      const std::vector<Real>& m) const;
+
+        //! Default thresholds
+        /*! Returns \f$ F_Y^{-1}(p_i) \f$ for each probability.  Since
+            they do not depend on the factor value, they can be
+            computed once and passed to the overload of
+            conditionalProbability() taking thresholds.  Thresholds
+            for vanishing probabilities are set to zero and ignored.
+        */
+        std::vector<Real> thresholds(const std::vector<Real>& prob) const;
+
+        //! Conditional probabilities from precomputed thresholds
+        /*! The results are written into the passed vector, which is
+            resized if needed, so that it can be reused across factor
+            values without reallocation.
+        */
+        void conditionalProbability(const std::vector<Real>& prob,
+                                    const std::vector<Real>& thresholds,
+                                    Real m,
+                                    std::vector<Real>& result) const;
+
         /*! Integral over the density \f$ \rho(m) \f$ of M and the conditional
             probability related to p:
 
@@ -192,10 +221,11 @@ namespace QuantLib {
         Real integral(const F& f, std::vector<Real>& probabilities) const {
             calculate();
 
+            std::vector<Real> y = thresholds(probabilities);
+            std::vector<Real> conditional(probabilities.size());
             Real avg = 0.0;
             for (Size i = 0; i < steps_; i++) {
-                std::vector<Real> conditional
-                    = conditionalProbability(probabilities, m(i));
+                conditionalProbability(probabilities, y, m(i), conditional);
                 Real prob = f(conditional);
                 avg += prob * densitydm(i);
             }
@@ -219,9 +249,10 @@ namespace QuantLib {
             calculate();
 
             Distribution dist(f.buckets(), 0.0, f.maximum());
+            std::vector<Real> y = thresholds(probabilities);
+            std::vector<Real> conditional(probabilities.size());
             for (Size i = 0; i < steps(); i++) {
-                std::vector<Real> conditional
-                    = conditionalProbability(probabilities, m(i));
+                conditionalProbability(probabilities, y, m(i), conditional);
                 Distribution d = f(nominals, conditional);
                 for (Size j = 0; j < dist.size(); j++)
                     dist.addDensity(j, d.density(j) * densitydm(i));
@@ -27,6 +27,7 @@
 #include <ql/experimental/credit/onefactorgaussiancopula.hpp>
 #include <ql/experimental/credit/onefactorstudentcopula.hpp>
 #include <boost/bind.hpp>
+#include <boost/ref.hpp>
 #include <map>
 #include <algorithm>
 
@@ -75,13 +76,18 @@ namespace QuantLib {
       private:
         //! Weights the conditional portfolio loss by the mkt factor
         //    distribtion
-        Real integratorLoss(const Date& date, Real mktFactor) const {
-            return expectedConditionalLoss(date, mktFactor) *
+        Real integratorLoss(const std::vector<Probability>& uncDefProb,
+                            const std::vector<Real>& thresholds,
+                            Real mktFactor) const {
+            return expectedConditionalLoss(uncDefProb, thresholds,
+                                           mktFactor) *
                copula_->density(mktFactor);
         }
         //! Portfolio loss conditional to the market factor value
-        Real expectedConditionalLoss(const Date& date,
-                                     Real mktFactor) const;
+        Real expectedConditionalLoss(
+                                const std::vector<Probability>& uncDefProb,
+                                const std::vector<Real>& thresholds,
+                                Real mktFactor) const;
       public:
         void update();
 
@@ -99,13 +105,20 @@ namespace QuantLib {
             \f]
             and this is the way it is integrated here. The recursion formula makes
             it easier this way.
+            The unconditional default probabilities and the copula
+            thresholds only depend on the date and are computed once
+            outside the integration over the market factor.
         */
         Real expectedTrancheLoss(const Date& date) const {
+            std::vector<Probability> uncDefProb =
+                this->remainingBasket_->probabilities(date);
+            std::vector<Real> thresholds = copula_->thresholds(uncDefProb);
             return
                 integral_(boost::bind(
                     &RecursiveCdoEngine<CDOEngine, copulaT>::integratorLoss,
                     this,
-                    date,
+                    boost::cref(uncDefProb),
+                    boost::cref(thresholds),
                     _1)
                 );
         }
@@ -201,14 +214,16 @@ namespace QuantLib {
     //! Portfolio loss conditional to the market factor value
     template <class CDOEngine, class copulaT>
     Real RecursiveCdoEngine<CDOEngine, copulaT>::expectedConditionalLoss(
-                                 const Date& date,
+                                 const std::vector<Probability>& uncDefProb,
+                                 const std::vector<Real>& thresholds,
                                  Real mktFactor) const {
         const std::vector<std::string>& names = this->remainingBasket_->names();
 
         // eq. 10 p.68
         // attainable losses distribution, recursive algorithm
-        std::vector<Probability> uncDefProb =
-            this->remainingBasket_->probabilities(date);;
+        std::vector<Probability> condDefProb;
+        copula_->conditionalProbability(uncDefProb, thresholds, mktFactor,
+                                        condDefProb);
         std::map<Real, Probability> pIndepDistrib;
         // K=0
         pIndepDistrib.insert(std::make_pair(0., 1.));
@@ -218,9 +233,7 @@ namespace QuantLib {
             // to do: allow for matrix constructor and uncoment this
             // correlQuote_->setValue(oneFactorCorrels_[iName]);
 
-            Probability pDef =
-                copula_->conditionalProbability(uncDefProb[iName],
-                                                mktFactor);
+            Probability pDef = condDefProb[iName];
             // iterate on all possible losses in the distribution:
             std::map<Real, Probability> pDistTemp;
             std::map<Real, Probability>::iterator distIt =
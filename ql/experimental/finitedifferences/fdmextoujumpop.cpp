@@ -75,9 +75,6 @@ namespace QuantLib {
         const Array yInt   = gaussLaguerreIntegration_.x();
         const Array weights= gaussLaguerreIntegration_.weights();
 
-        integroPart_ = SparseMatrix(mesher_->layout()->size(),
-                                    mesher_->layout()->size());
-
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
         const FdmLinearOpIterator endIter = layout->end();
 
@@ -87,11 +84,23 @@ namespace QuantLib {
             yLoc[iter.coordinates()[1]] = mesher_->location(iter, 1);
         }
 
+        // the integral part couples the nodes along the y direction only;
+        // it is stored in compressed-row form, whose product is split
+        // among threads for the lines of the other directions.
+        std::vector<Size> rows, columns;
+        std::vector<Real> values;
+        const Size nonZeros = (2*yInt.size()+1)*layout->size();
+        rows.reserve(nonZeros);
+        columns.reserve(nonZeros);
+        values.reserve(nonZeros);
+
         for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
             ++iter) {
 
             const Size diag = iter.index();
-            integroPart_(diag, diag) -= lambda;
+            rows.push_back(diag);
+            columns.push_back(diag);
+            values.push_back(-lambda);
 
             const Real y = mesher_->location(iter, 1);
             const Integer yIndex = iter.coordinates()[1];
@@ -105,12 +114,17 @@ namespace QuantLib {
                                        yLoc.end()-1, ys) - yLoc.begin()-1;
 
                 const Real s = (ys-yLoc[l])/(yLoc[l+1]-yLoc[l]);
-                integroPart_(diag, layout->neighbourhood(iter, 1, l-yIndex))
-                    += weight*lambda*(1-s);
-                integroPart_(diag, layout->neighbourhood(iter, 1, l+1-yIndex))
-                    += weight*lambda*s;
+                rows.push_back(diag);
+                columns.push_back(layout->neighbourhood(iter, 1, l-yIndex));
+                values.push_back(weight*lambda*(1-s));
+                rows.push_back(diag);
+                columns.push_back(layout->neighbourhood(iter, 1, l+1-yIndex));
+                values.push_back(weight*lambda*s);
             }
         }
+
+        integroPart_ = CSRMatrix(layout->size(), layout->size(),
+                                 rows, columns, values);
 #endif
     }
 
@@ -230,12 +244,23 @@ namespace QuantLib {
     }
 #else
     Disposable<Array> FdmExtOUJumpOp::integro(const Array& r) const {
-        return prod(integroPart_, r);
+        return integroPart_.apply(r);
     }
 
     Disposable<SparseMatrix> FdmExtOUJumpOp::toMatrix() const {
         QL_REQUIRE(bcSet_.empty(), "boundary conditions are not supported");
-        SparseMatrix retVal = ouOp_->toMatrix()+dyMap_.toMatrix()+integroPart_;
+
+        const Size n = integroPart_.rows();
+        SparseMatrix integroPart(n, n, integroPart_.nonZeros());
+        for (Size i=0; i < n; ++i) {
+            for (Size k=integroPart_.rowPointers()[i];
+                 k < integroPart_.rowPointers()[i+1]; ++k) {
+                integroPart(i, integroPart_.columnIndices()[k])
+                    = integroPart_.values()[k];
+            }
+        }
+
+        SparseMatrix retVal = ouOp_->toMatrix()+dyMap_.toMatrix()+integroPart;
 
         return retVal;
     }
@@ -25,6 +25,7 @@
 #define quantlib_fdm_ext_ou_jump_op_hpp
 
 #include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <ql/math/integrals/gaussianquadratures.hpp>
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
@@ -95,7 +96,7 @@ namespace QuantLib {
         };
             
 #else
-        SparseMatrix integroPart_;
+        CSRMatrix integroPart_;
 #endif
     };
 }
@@ -27,6 +27,7 @@
 #include <ql/experimental/finitedifferences/fdmvppstepcondition.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearopiterator.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/utilities/parallelerrors.hpp>
 
 #include <boost/bind.hpp>
 
@@ -86,43 +87,52 @@ namespace QuantLib {
 
 
     void FdmVPPStepCondition::applyTo(Array& a, Time t) const {
-        boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
 
         const Size nStates = layout->dim()[stateDirection_];
-        const FdmLinearOpIterator endIter = layout->end();
-
-        for (FdmLinearOpIterator iter=layout->begin();iter != endIter; ++iter) {
-            a[iter.index()] += evolve(iter, t);
-        }
-
-        for (FdmLinearOpIterator iter=layout->begin();iter != endIter; ++iter) {
-            if (!iter.coordinates()[stateDirection_]) {
+        const Size spacing = layout->spacing()[stateDirection_];
+
+        // the lines along the state direction are independent
+        // dynamic programming problems, which can be handled by
+        // different threads.
+        const Integer nLines = Integer(layout->size()/nStates);
+        ParallelErrors errors;
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for if (a.size() > 10000)
+        #endif
+        for (Integer l=0; l < nLines; ++l) {
+            try {
+                const Size offset = (l/spacing)*spacing*nStates + l%spacing;
+                const FdmLinearOpIterator iter = layout->iter_at(offset);
 
                 Array x(nStates);
                 for (Size i=0; i < nStates; ++i) {
-                    x[i] = a[layout->neighbourhood(iter, stateDirection_, i)];
+                    x[i] = a[offset + i*spacing];
                 }
 
+                evolve(x, iter, t);
+
                 const Real gasPrice = gasPrice_->innerValue(iter, t);
                 x = changeState(gasPrice, x, t);
                 for (Size i=0; i < nStates; ++i) {
-                    a[layout->neighbourhood(iter, stateDirection_, i)] = x[i];
+                    a[offset + i*spacing] = x[i];
                 }
+            } catch (...) {
+                errors.record(l);
             }
         }
+        errors.rethrow();
     }
 
-    Real FdmVPPStepCondition::evolve(
-                               const FdmLinearOpIterator& iter, Time t) const {
+    void FdmVPPStepCondition::evolve(
+        Array& state, const FdmLinearOpIterator& iter, Time t) const {
 
-        const Size state = iter.coordinates()[stateDirection_];
-
-        if (stateEvolveFcts_[state].empty()) {
-            return 0.0;
-        }
-        else {
-            const Real sparkSpread = sparkSpreadPrice_->innerValue(iter, t);
-            return stateEvolveFcts_[state](sparkSpread);
+        const Real sparkSpread = sparkSpreadPrice_->innerValue(iter, t);
+        for (Size i=0; i < state.size(); ++i) {
+            if (!stateEvolveFcts_[i].empty()) {
+                state[i] += stateEvolveFcts_[i](sparkSpread);
+            }
         }
     }
 
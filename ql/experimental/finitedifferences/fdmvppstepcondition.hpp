@@ -56,7 +56,10 @@ namespace QuantLib {
         Real evolveAtPMin(Real sparkSpread) const;
         Real evolveAtPMax(Real sparkSpread) const;
 
-        Real evolve(const FdmLinearOpIterator& iter, Time t) const;
+        // the spark spread is evaluated once per line; like the gas
+        // price, it must not depend on the state coordinate of iter
+        void evolve(Array& state,
+                    const FdmLinearOpIterator& iter, Time t) const;
         Disposable<Array> changeState(Real gasPrice,
                                       const Array& state, Time t) const;
 
@@ -1,5 +1,6 @@
 /* This file is automatically generated; do not edit.     */
 /* Add the files to be included into Makefile.am instead. */
 
+#include <ql/experimental/risk/scenarioanalysis.hpp>
 #include <ql/experimental/risk/sensitivityanalysis.hpp>
 
@@ -0,0 +1,194 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/risk/scenarioanalysis.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/instrument.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <ql/settings.hpp>
+#include <ql/utilities/parallelerrors.hpp>
+#include <algorithm>
+#include <map>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+using std::vector;
+using boost::shared_ptr;
+
+namespace QuantLib {
+
+    namespace {
+
+        // sorts the shifts by quote and merges those on the same quote
+        QuoteShifts normalized(const QuoteShifts& shifts, Size nQuotes) {
+            QuoteShifts sorted(shifts);
+            std::sort(sorted.begin(), sorted.end());
+            QuoteShifts result;
+            for (Size i=0; i<sorted.size(); ++i) {
+                QL_REQUIRE(sorted[i].first < nQuotes,
+                           "quote index (" << sorted[i].first
+                           << ") out of range; only " << nQuotes
+                           << " quotes available");
+                if (!result.empty() && result.back().first == sorted[i].first)
+                    result.back().second += sorted[i].second;
+                else
+                    result.push_back(sorted[i]);
+            }
+            QuoteShifts nonZero;
+            for (Size i=0; i<result.size(); ++i)
+                if (result[i].second != 0.0)
+                    nonZero.push_back(result[i]);
+            return nonZero;
+        }
+
+        void revalue(const vector<shared_ptr<SimpleQuote> >& quotes,
+                     const vector<shared_ptr<Instrument> >& instruments,
+                     const vector<Real>& baseValues,
+                     const vector<const QuoteShifts*>& scenarios,
+                     Size begin, Size end,
+                     Matrix& npvs) {
+            vector<Size> shifted;
+            for (Size s=begin; s<end; ++s) {
+                const QuoteShifts& shifts = *scenarios[s];
+                // quotes shifted by the previous scenario only are
+                // restored; the others are left alone so that the
+                // objects depending on them are not recalculated.
+                for (Size i=0, j=0; i<shifted.size(); ++i) {
+                    while (j<shifts.size() && shifts[j].first<shifted[i])
+                        ++j;
+                    if (j==shifts.size() || shifts[j].first!=shifted[i])
+                        quotes[shifted[i]]->setValue(baseValues[shifted[i]]);
+                }
+                shifted.clear();
+                for (Size j=0; j<shifts.size(); ++j) {
+                    Size k = shifts[j].first;
+                    quotes[k]->setValue(baseValues[k] + shifts[j].second);
+                    shifted.push_back(k);
+                }
+                for (Size j=0; j<instruments.size(); ++j)
+                    npvs[s][j] = instruments[j]->NPV();
+            }
+            for (Size i=0; i<shifted.size(); ++i)
+                quotes[shifted[i]]->setValue(baseValues[shifted[i]]);
+        }
+
+    }
+
+    Disposable<Matrix> scenarioNPVs(const ScenarioMarketBuilder& builder,
+                                    const vector<QuoteShifts>& scenarios,
+                                    Size workers) {
+        if (workers == Null<Size>()) {
+            #if defined(_OPENMP)
+            workers = omp_get_max_threads();
+            #else
+            workers = 1;
+            #endif
+        }
+        QL_REQUIRE(workers > 0, "at least one worker required");
+
+        // make sure that the global singletons exist before any
+        // worker tries to access them
+        Settings::instance().evaluationDate();
+        IndexManager::instance();
+
+        // a first market is needed anyway to validate the scenarios
+        vector<vector<shared_ptr<SimpleQuote> > > quotes(1);
+        vector<vector<shared_ptr<Instrument> > > instruments(1);
+        builder.build(quotes[0], instruments[0]);
+        const Size nQuotes = quotes[0].size();
+        const Size nInstruments = instruments[0].size();
+        vector<Real> baseValues(nQuotes);
+        for (Size i=0; i<nQuotes; ++i) {
+            QL_REQUIRE(quotes[0][i], "null quote at position " << i);
+            QL_REQUIRE(quotes[0][i]->isValid(),
+                       "invalid quote at position " << i);
+            baseValues[i] = quotes[0][i]->value();
+        }
+
+        // identical scenarios are only revalued once; the map also
+        // sorts them so that similar ones end up on the same worker
+        std::map<QuoteShifts, Size> unique;
+        vector<std::map<QuoteShifts, Size>::iterator> scenarioRow;
+        scenarioRow.reserve(scenarios.size());
+        for (Size i=0; i<scenarios.size(); ++i)
+            scenarioRow.push_back(unique.insert(
+                std::make_pair(normalized(scenarios[i], nQuotes),
+                               Size(0))).first);
+        vector<const QuoteShifts*> uniqueScenarios;
+        uniqueScenarios.reserve(unique.size());
+        for (std::map<QuoteShifts, Size>::iterator i=unique.begin();
+             i!=unique.end(); ++i) {
+            i->second = uniqueScenarios.size();
+            uniqueScenarios.push_back(&(i->first));
+        }
+
+        const Size nScenarios = uniqueScenarios.size();
+        workers = std::max<Size>(std::min(workers, nScenarios), 1);
+
+        // the remaining markets are built serially, since the
+        // builder is not required to be thread-safe
+        quotes.resize(workers);
+        instruments.resize(workers);
+        for (Size w=1; w<workers; ++w) {
+            builder.build(quotes[w], instruments[w]);
+            QL_REQUIRE(quotes[w].size() == nQuotes,
+                       "builder returned " << quotes[w].size()
+                       << " quotes instead of " << nQuotes);
+            QL_REQUIRE(instruments[w].size() == nInstruments,
+                       "builder returned " << instruments[w].size()
+                       << " instruments instead of " << nInstruments);
+            for (Size i=0; i<nQuotes; ++i) {
+                QL_REQUIRE(quotes[w][i] && quotes[w][i]->isValid(),
+                           "null or invalid quote at position " << i);
+                QL_REQUIRE(quotes[w][i] != quotes[0][i],
+                           "quote at position " << i
+                           << " shared between markets");
+                QL_REQUIRE(quotes[w][i]->value() == baseValues[i],
+                           "quote at position " << i << " has value "
+                           << quotes[w][i]->value() << " instead of "
+                           << baseValues[i]);
+            }
+        }
+
+        Matrix uniqueNPVs(nScenarios, nInstruments);
+        ParallelErrors errors;
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for num_threads(workers)
+        #endif
+        for (Integer w=0; w<Integer(workers); ++w) {
+            try {
+                revalue(quotes[w], instruments[w], baseValues,
+                        uniqueScenarios,
+                        (w*nScenarios)/workers, ((w+1)*nScenarios)/workers,
+                        uniqueNPVs);
+            } catch (...) {
+                errors.record(w);
+            }
+        }
+        errors.rethrow("scenario revaluation worker");
+
+        Matrix result(scenarios.size(), nInstruments);
+        for (Size i=0; i<scenarios.size(); ++i)
+            std::copy(uniqueNPVs.row_begin(scenarioRow[i]->second),
+                      uniqueNPVs.row_end(scenarioRow[i]->second),
+                      result.row_begin(i));
+        return result;
+    }
+
+}
@@ -0,0 +1,84 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file scenarioanalysis.hpp
+    \brief scenario revaluation of a set of instruments
+*/
+
+#ifndef quantlib_scenario_analysis_hpp
+#define quantlib_scenario_analysis_hpp
+
+#include <ql/math/matrix.hpp>
+#include <ql/utilities/null.hpp>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class SimpleQuote;
+    class Instrument;
+
+    //! builder of the market-data graph used in scenario revaluation
+    /*! Market objects cannot be copied, since they are linked by
+        the observer pattern; therefore, each worker used by
+        scenarioNPVs() asks the builder for a graph of its own.
+
+        Every call to build() must return quotes and instruments
+        that do not share any term structure, index or engine with
+        the ones returned by other calls. The quotes are identified
+        by their position, which must be the same in every call.
+    */
+    class ScenarioMarketBuilder {
+      public:
+        virtual ~ScenarioMarketBuilder() {}
+        virtual void build(
+                std::vector<boost::shared_ptr<SimpleQuote> >& quotes,
+                std::vector<boost::shared_ptr<Instrument> >& instruments)
+                                                                  const = 0;
+    };
+
+    //! additive shifts to be applied to the quotes in a scenario
+    /*! each pair contains the position of a quote and its shift. */
+    typedef std::vector<std::pair<Size, Real> > QuoteShifts;
+
+    //! NPVs of a set of instruments under a set of scenarios
+    /*! returns a matrix whose rows correspond to scenarios and
+        whose columns correspond to the instruments returned by the
+        builder.
+
+        Each worker builds its own market and revalues a contiguous
+        block of scenarios. Quotes are only reset when they change,
+        so that the lazy objects which do not depend on them are
+        not recalculated; identical scenarios are only revalued
+        once, and scenarios are sorted before being distributed so
+        that consecutive ones tend to share shifted quotes.
+
+        Workers run in parallel if the library was compiled with
+        OpenMP support; by default, as many workers as the
+        available threads are used.
+
+        \warning the evaluation date and the index fixings are
+                 global and are shared by all workers; they must not
+                 be changed by the builder or by the instruments.
+    */
+    Disposable<Matrix> scenarioNPVs(const ScenarioMarketBuilder& builder,
+                                    const std::vector<QuoteShifts>& scenarios,
+                                    Size workers = Null<Size>());
+
+}
+
+#endif
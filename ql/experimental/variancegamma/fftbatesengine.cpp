@@ -0,0 +1,42 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/variancegamma/fftbatesengine.hpp>
+
+namespace QuantLib {
+
+    FFTBatesEngine::FFTBatesEngine(const boost::shared_ptr<BatesModel>& model,
+                                   Real logStrikeSpacing)
+    : detail::BatesFourierEngine<FFTHestonEngine>(model, logStrikeSpacing) {}
+
+    std::auto_ptr<FFTEngine> FFTBatesEngine::clone() const {
+        return std::auto_ptr<FFTEngine>(new FFTBatesEngine(
+            boost::dynamic_pointer_cast<BatesModel>(model_), lambda_));
+    }
+
+
+    COSBatesEngine::COSBatesEngine(const boost::shared_ptr<BatesModel>& model,
+                                   Size nTerms, Real truncation)
+    : detail::BatesFourierEngine<COSHestonEngine>(model, nTerms, truncation) {}
+
+    std::auto_ptr<FFTEngine> COSBatesEngine::clone() const {
+        return std::auto_ptr<FFTEngine>(new COSBatesEngine(
+            boost::dynamic_pointer_cast<BatesModel>(model_),
+            nTerms_, truncation_));
+    }
+
+}
@@ -0,0 +1,109 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fftbatesengine.hpp
+    \brief FFT and COS engines for vanilla options under the Bates model
+*/
+
+#ifndef quantlib_fft_bates_engine_hpp
+#define quantlib_fft_bates_engine_hpp
+
+#include <ql/experimental/variancegamma/ffthestonengine.hpp>
+#include <ql/models/equity/batesmodel.hpp>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        //! adds the compensated jump term of the Bates model
+        /*! This is the same term as in BatesEngine, for a complex
+            argument; it is shared by the FFT and COS engines.
+        */
+        template <class HestonEngine>
+        class BatesFourierEngine : public HestonEngine {
+          protected:
+            template <class A>
+            BatesFourierEngine(const boost::shared_ptr<BatesModel>& model,
+                               A a)
+            : HestonEngine(model, a) {}
+            template <class A, class B>
+            BatesFourierEngine(const boost::shared_ptr<BatesModel>& model,
+                               A a, B b)
+            : HestonEngine(model, a, b) {}
+
+            virtual std::complex<Real> addOnTerm(std::complex<Real> u) const;
+        };
+
+    }
+
+
+    //! FFT engine for vanilla options under the Bates model
+    /*! \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with the analytic Bates engine.
+    */
+    class FFTBatesEngine
+        : public detail::BatesFourierEngine<FFTHestonEngine> {
+    public:
+        FFTBatesEngine(const boost::shared_ptr<BatesModel>& model,
+                       Real logStrikeSpacing = 0.001);
+        virtual std::auto_ptr<FFTEngine> clone() const;
+    };
+
+
+    //! COS-method engine for vanilla options under the Bates model
+    /*! \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with the analytic Bates engine.
+    */
+    class COSBatesEngine
+        : public detail::BatesFourierEngine<COSHestonEngine> {
+    public:
+        COSBatesEngine(const boost::shared_ptr<BatesModel>& model,
+                       Size nTerms = 256,
+                       Real truncation = 16.0);
+        virtual std::auto_ptr<FFTEngine> clone() const;
+    };
+
+
+    // template definitions
+
+    namespace detail {
+
+        template <class HestonEngine>
+        std::complex<Real> BatesFourierEngine<HestonEngine>::addOnTerm(
+                                                std::complex<Real> u) const {
+            const BatesModel& model =
+                dynamic_cast<const BatesModel&>(*this->model_);
+
+            const Real nu     = model.nu();
+            const Real delta2 = 0.5*model.delta()*model.delta();
+            const Real lambda = model.lambda();
+            const std::complex<Real> g = std::complex<Real>(0, 1)*u;
+
+            return this->t_*lambda*(std::exp(nu*g + delta2*g*g) - 1.0
+                                    - g*(std::exp(nu + delta2) - 1.0));
+        }
+
+    }
+
+}
+
+
+#endif
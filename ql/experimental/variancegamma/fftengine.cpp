@@ -22,6 +22,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/math/interpolations/linearinterpolation.hpp>
 #include <ql/experimental/math/fastfouriertransform.hpp>
 #include <complex>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -31,6 +32,10 @@ namespace QuantLib {
             registerWith(process_);
     }
 
+    FFTEngine::FFTEngine(Real logStrikeSpacing)
+        : lambda_(logStrikeSpacing) {
+    }
+
     void FFTEngine::calculate() const
     {
         QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
@@ -64,6 +69,16 @@ namespace QuantLib {
         VanillaOption::engine::update();
     }
 
+    Real FFTEngine::underlyingValue() const
+    {
+        return process_->x0();
+    }
+
+    Real FFTEngine::minimumLogStrikeRange(Real) const
+    {
+        return 0.0;
+    }
+
     void FFTEngine::calculateUncached(boost::shared_ptr<StrikedTypePayoff> payoff,
         boost::shared_ptr<Exercise> exercise) const
     {
@@ -101,84 +116,37 @@ namespace QuantLib {
             payoffMap[option->exercise()->lastDate()].push_back(payoff);
         }
 
-        std::complex<Real> i1(0, 1);
-        Real alpha = 1.25;
-
         for (PayoffMap::const_iterator payIt = payoffMap.begin(); payIt != payoffMap.end(); payIt++)
         {
             Date expiryDate = payIt->first;
 
-            // Calculate n large enough for maximum strike, and round up to a power of 2
-            Real maxStrike = 0.0;
-            for (PayoffList::const_iterator it = payIt->second.begin();
-                it != payIt->second.end(); it++)
-            {
-                boost::shared_ptr<StrikedTypePayoff> payoff = *it;
-
-                if (payoff->strike() > maxStrike)
-                    maxStrike = payoff->strike();
-            }
-            Real nR = 2.0 * (std::log(maxStrike) + lambda_) / lambda_;
-      Size log2_n = (static_cast<Size>((std::log(nR) / std::log(2.0))) + 1);
-            Size n = 1 << log2_n;
-
-            // Strike range (equation 19,20)
-            Real b = n * lambda_ / 2.0;
-
-            // Grid spacing (equation 23)
-            Real eta = 2.0 * M_PI / (lambda_ * n);
-
             // Discount factor
             Real df = discountFactor(expiryDate);
             Real div = dividendYield(expiryDate);
 
-            // Input to fourier transform
-            std::vector<std::complex<Real> > fti;
-            fti.resize(n);
-
             // Precalculate any discount factors etc.
             precalculateExpiry(expiryDate);
 
-            for (Size i=0; i<n; i++)
-            {
-                Real v_j = eta * i;
-                Real sw = eta * (3.0 + ((i % 2) == 0 ? -1.0 : 1.0) - ((i == 0) ? 1.0 : 0.0)) / 3.0; 
-
-                std::complex<Real> psi = df * complexFourierTransform(v_j - (alpha + 1)* i1);
-                psi = psi / (alpha*alpha + alpha - v_j*v_j + i1 * (2 * alpha + 1.0) * v_j);
-
-                fti[i] = std::exp(i1 * b * v_j)  * sw * psi;
-            }
-
-            // Perform fft
-            std::vector<std::complex<Real> > results(n);
-            FastFourierTransform fft(log2_n);
-            fft.transform(fti.begin(), fti.end(), results.begin());
-
-            // Call prices
-            std::vector<Real> prices, strikes;
-            prices.resize(n);
-            strikes.resize(n);
-            for (Size i=0; i<n; i++)
-            {
-                Real k_u = -b + lambda_ * i;
-                prices[i] = (std::exp(-alpha * k_u) / M_PI) * results[i].real();
-                strikes[i] = std::exp(k_u);
-            }
-
+            std::vector<Real> strikes;
+            strikes.reserve(payIt->second.size());
             for (PayoffList::const_iterator it = payIt->second.begin();
                 it != payIt->second.end(); it++)
+                strikes.push_back((*it)->strike());
+
+            std::vector<Real> prices = callPrices(expiryDate, strikes);
+
+            for (Size i=0; i<payIt->second.size(); i++)
             {
-                boost::shared_ptr<StrikedTypePayoff> payoff = *it;
+                boost::shared_ptr<StrikedTypePayoff> payoff = payIt->second[i];
 
-                Real callPrice = LinearInterpolation(strikes.begin(), strikes.end(), prices.begin())(payoff->strike());
+                Real callPrice = prices[i];
                 switch (payoff->optionType())
                 {
                 case Option::Call:
                     resultMap_[expiryDate][payoff] = callPrice;
                     break;
                 case Option::Put:
-                    resultMap_[expiryDate][payoff] = callPrice - process_->x0() * div + payoff->strike() * df;
+                    resultMap_[expiryDate][payoff] = callPrice - underlyingValue() * div + payoff->strike() * df;
                     break;
                 default:
                     QL_FAIL("Invalid option type");
@@ -187,5 +155,65 @@ namespace QuantLib {
         }
     }
 
-}
+    std::vector<Real> FFTEngine::callPrices(
+                                  Date expiryDate,
+                                  const std::vector<Real>& strikes) const {
+        std::complex<Real> i1(0, 1);
+        Real alpha = 1.25;
+
+        // Calculate n large enough for maximum strike, and round up to a power of 2
+        Real maxStrike = *std::max_element(strikes.begin(), strikes.end());
+        Real range = std::max(std::log(maxStrike), minimumLogStrikeRange(alpha));
+        Real nR = 2.0 * (range + lambda_) / lambda_;
+        Size log2_n = (static_cast<Size>((std::log(nR) / std::log(2.0))) + 1);
+        Size n = 1 << log2_n;
+
+        // Strike range (equation 19,20)
+        Real b = n * lambda_ / 2.0;
+
+        // Grid spacing (equation 23)
+        Real eta = 2.0 * M_PI / (lambda_ * n);
+
+        // Discount factor
+        Real df = discountFactor(expiryDate);
+
+        // Input to fourier transform
+        std::vector<std::complex<Real> > fti;
+        fti.resize(n);
 
+        for (Size i=0; i<n; i++)
+        {
+            Real v_j = eta * i;
+            Real sw = eta * (3.0 + ((i % 2) == 0 ? -1.0 : 1.0) - ((i == 0) ? 1.0 : 0.0)) / 3.0; 
+
+            std::complex<Real> psi = df * complexFourierTransform(v_j - (alpha + 1)* i1);
+            psi = psi / (alpha*alpha + alpha - v_j*v_j + i1 * (2 * alpha + 1.0) * v_j);
+
+            fti[i] = std::exp(i1 * b * v_j)  * sw * psi;
+        }
+
+        // Perform fft
+        std::vector<std::complex<Real> > results(n);
+        FastFourierTransform fft(log2_n);
+        fft.transform(fti.begin(), fti.end(), results.begin());
+
+        // Call prices
+        std::vector<Real> prices, gridStrikes;
+        prices.resize(n);
+        gridStrikes.resize(n);
+        for (Size i=0; i<n; i++)
+        {
+            Real k_u = -b + lambda_ * i;
+            prices[i] = (std::exp(-alpha * k_u) / M_PI) * results[i].real();
+            gridStrikes[i] = std::exp(k_u);
+        }
+
+        LinearInterpolation interpolation(gridStrikes.begin(), gridStrikes.end(),
+                                          prices.begin());
+        std::vector<Real> callPrices(strikes.size());
+        for (Size i=0; i<strikes.size(); i++)
+            callPrices[i] = interpolation(strikes[i]);
+        return callPrices;
+    }
+
+}
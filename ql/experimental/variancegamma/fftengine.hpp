@@ -38,6 +38,12 @@ namespace QuantLib {
         you should collect all the options you wish to price in a list and call 
         the engine's precalculate method before calling the NPV method of the option.
 
+        Derived classes provide the characteristic function of the
+        logarithm of the underlying at expiry; by default call prices
+        are obtained from it by the Carr-Madan transform, but derived
+        classes can override callPrices() to use a different
+        inversion. Put prices are obtained by put-call parity.
+
         References:
         Carr, P. and D. B. Madan (1998),
         "Option Valuation using the fast Fourier transform,"
@@ -56,10 +62,24 @@ namespace QuantLib {
         virtual std::auto_ptr<FFTEngine> clone() const = 0;
 
     protected:
+        /*! for engines whose model is not described by a
+            one-dimensional process */
+        FFTEngine(Real logStrikeSpacing);
+
         virtual void precalculateExpiry(Date d) = 0;
         virtual std::complex<Real> complexFourierTransform(std::complex<Real> u) const = 0;
         virtual Real discountFactor(Date d) const = 0;
         virtual Real dividendYield(Date d) const = 0;
+        virtual Real underlyingValue() const;
+        /*! lower bound for the half-width of the log-strike grid
+            used by the Carr-Madan transform with the given damping
+            factor; by default the grid only covers the strikes. */
+        virtual Real minimumLogStrikeRange(Real alpha) const;
+        /*! returns the call prices for the given strikes
+            and expiry; it is called after precalculateExpiry(d). */
+        virtual std::vector<Real> callPrices(
+                                   Date d,
+                                   const std::vector<Real>& strikes) const;
         void calculateUncached(boost::shared_ptr<StrikedTypePayoff> payoff,
             boost::shared_ptr<Exercise> exercise) const;
 
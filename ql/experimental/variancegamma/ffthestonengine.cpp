@@ -0,0 +1,162 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/variancegamma/ffthestonengine.hpp>
+#include <ql/processes/hestonprocess.hpp>
+
+namespace QuantLib {
+
+    FFTHestonEngine::FFTHestonEngine(
+                                const boost::shared_ptr<HestonModel>& model,
+                                Real logStrikeSpacing)
+    : FFTEngine(logStrikeSpacing), model_(model) {
+        registerWith(model_);
+    }
+
+    std::auto_ptr<FFTEngine> FFTHestonEngine::clone() const {
+        return std::auto_ptr<FFTEngine>(new FFTHestonEngine(model_, lambda_));
+    }
+
+    void FFTHestonEngine::precalculateExpiry(Date d) {
+        boost::shared_ptr<HestonProcess> process = model_->process();
+
+        dividendDiscount_ = process->dividendYield()->discount(d);
+        riskFreeDiscount_ = process->riskFreeRate()->discount(d);
+        t_ = process->time(d);
+
+        kappa_ = model_->kappa();
+        theta_ = model_->theta();
+        sigma_ = model_->sigma();
+        rho_   = model_->rho();
+        v0_    = model_->v0();
+
+        QL_REQUIRE(sigma_ > 0.0, "Heston volatility of variance must be "
+                   "positive, " << sigma_ << " given");
+    }
+
+    std::complex<Real> FFTHestonEngine::complexFourierTransform(
+                                                std::complex<Real> u) const {
+        const std::complex<Real> i1(0, 1);
+        const Real s = model_->process()->s0()->value();
+        const Real sigma2 = sigma_*sigma_;
+
+        const std::complex<Real> iu = i1*u;
+        const std::complex<Real> beta = kappa_ - sigma_*rho_*iu;
+        const std::complex<Real> d = std::sqrt(beta*beta + sigma2*(iu + u*u));
+        const std::complex<Real> g = (beta - d)/(beta + d);
+        const std::complex<Real> e = std::exp(-d*t_);
+
+        const std::complex<Real> C = kappa_*theta_/sigma2
+            * ((beta - d)*t_ - 2.0*std::log((1.0 - g*e)/(1.0 - g)));
+        const std::complex<Real> D = (beta - d)/sigma2 * (1.0 - e)/(1.0 - g*e);
+
+        return std::exp(iu*std::log(s*dividendDiscount_/riskFreeDiscount_)
+                        + C + D*v0_ + addOnTerm(u));
+    }
+
+    std::complex<Real> FFTHestonEngine::addOnTerm(std::complex<Real>) const {
+        return std::complex<Real>(0.0, 0.0);
+    }
+
+    Real FFTHestonEngine::discountFactor(Date d) const {
+        return model_->process()->riskFreeRate()->discount(d);
+    }
+
+    Real FFTHestonEngine::dividendYield(Date d) const {
+        return model_->process()->dividendYield()->discount(d);
+    }
+
+    Real FFTHestonEngine::underlyingValue() const {
+        return model_->process()->s0()->value();
+    }
+
+    Real FFTHestonEngine::minimumLogStrikeRange(Real alpha) const {
+        return std::log(1.0e8/3.0)/alpha;
+    }
+
+
+    COSHestonEngine::COSHestonEngine(
+                                const boost::shared_ptr<HestonModel>& model,
+                                Size nTerms, Real truncation)
+    : FFTHestonEngine(model), nTerms_(nTerms), truncation_(truncation) {
+        QL_REQUIRE(nTerms_ > 1, "at least two expansion terms required");
+        QL_REQUIRE(truncation_ > 0.0, "positive truncation required");
+    }
+
+    std::auto_ptr<FFTEngine> COSHestonEngine::clone() const {
+        return std::auto_ptr<FFTEngine>(
+                         new COSHestonEngine(model_, nTerms_, truncation_));
+    }
+
+    std::vector<Real> COSHestonEngine::callPrices(
+                                  Date d,
+                                  const std::vector<Real>& strikes) const {
+        const Real df = discountFactor(d);
+        const Real forward = underlyingValue()*dividendYield(d)/df;
+
+        // mean and variance of the log-price from the derivatives
+        // of the cumulant-generating function at the origin
+        const Real h = 1.0e-3;
+        const std::complex<Real> lp = std::log(complexFourierTransform(h));
+        const std::complex<Real> lm = std::log(complexFourierTransform(-h));
+        const Real c1 = (lp - lm).imag()/(2.0*h);
+        const Real c2 = std::max(-(lp + lm).real()/(h*h), QL_EPSILON);
+
+        const Real a = c1 - truncation_*std::sqrt(c2);
+        const Real b = c1 + truncation_*std::sqrt(c2);
+        const Real w = b - a;
+
+        // strike-independent part of the expansion coefficients
+        const std::complex<Real> i1(0, 1);
+        std::vector<Real> u(nTerms_), coeff(nTerms_);
+        for (Size k=0; k<nTerms_; ++k) {
+            u[k] = k*M_PI/w;
+            coeff[k] = (complexFourierTransform(u[k])
+                        * std::exp(-i1*u[k]*a)).real();
+        }
+        coeff[0] *= 0.5;
+
+        // put prices, since the put payoff is bounded on the
+        // truncated interval; calls follow from put-call parity
+        std::vector<Real> prices(strikes.size());
+        for (Size j=0; j<strikes.size(); ++j) {
+            const Real logStrike = std::log(strikes[j]);
+            Real put = 0.0;
+            if (logStrike > a) {
+                const Real y = std::min(logStrike, b);
+                const Real ey = std::exp(y), ea = std::exp(a);
+
+                // cos(k*x) and sin(k*x) by rotation
+                const Real x = M_PI*(y - a)/w;
+                const std::complex<Real> rot(std::cos(x), std::sin(x));
+                std::complex<Real> z(1.0, 0.0);
+
+                for (Size k=0; k<nTerms_; ++k) {
+                    const Real chi = (z.real()*ey - ea + u[k]*z.imag()*ey)
+                                   / (1.0 + u[k]*u[k]);
+                    const Real psi = (k == 0) ? y - a : z.imag()/u[k];
+                    put += coeff[k]*(strikes[j]*psi - chi);
+                    z *= rot;
+                }
+                put *= 2.0/w;
+            }
+            prices[j] = df*(put + forward - strikes[j]);
+        }
+        return prices;
+    }
+
+}
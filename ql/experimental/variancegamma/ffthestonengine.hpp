@@ -0,0 +1,124 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file ffthestonengine.hpp
+    \brief FFT and COS engines for vanilla options under the Heston model
+*/
+
+#ifndef quantlib_fft_heston_engine_hpp
+#define quantlib_fft_heston_engine_hpp
+
+#include <ql/experimental/variancegamma/fftengine.hpp>
+#include <ql/models/equity/hestonmodel.hpp>
+
+namespace QuantLib {
+
+    //! FFT engine for vanilla options under the Heston model
+    /*! The characteristic function is written in the form given by
+        Albrecher et al., which avoids the branch-cut discontinuity
+        of the complex logarithm for long maturities.
+
+        References:
+
+        H. Albrecher, P. Mayer, W. Schoutens and J. Tistaert,
+        The Little Heston Trap, Wilmott Magazine, January 2007.
+
+        \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with the analytic Heston engine.
+    */
+    class FFTHestonEngine : public FFTEngine {
+    public:
+        FFTHestonEngine(const boost::shared_ptr<HestonModel>& model,
+                        Real logStrikeSpacing = 0.001);
+        virtual std::auto_ptr<FFTEngine> clone() const;
+
+    protected:
+        virtual void precalculateExpiry(Date d);
+        virtual std::complex<Real> complexFourierTransform(
+                                                 std::complex<Real> u) const;
+        virtual Real discountFactor(Date d) const;
+        virtual Real dividendYield(Date d) const;
+        virtual Real underlyingValue() const;
+        /*! the alternating Simpson weights of the transform alias
+            the damped call prices with a period equal to the grid
+            half-width b, biasing all of them by about
+            \f$ -S e^{-\alpha b}/3 \f$; with b only covering the
+            strikes this is about 1e-3 for typical Heston parameters.
+            The grid is widened to keep it below 1e-8 of the spot,
+            which roughly doubles the transform size for strikes
+            around 100. */
+        virtual Real minimumLogStrikeRange(Real alpha) const;
+        /*! logarithm of a multiplicative term of the characteristic
+            function, e.g., for jumps; the default returns zero. */
+        virtual std::complex<Real> addOnTerm(std::complex<Real> u) const;
+
+        boost::shared_ptr<HestonModel> model_;
+        Time t_;
+
+    private:
+        DiscountFactor dividendDiscount_;
+        DiscountFactor riskFreeDiscount_;
+        Real kappa_, theta_, sigma_, rho_, v0_;
+    };
+
+
+    //! COS-method engine for vanilla options under the Heston model
+    /*! The call prices for all strikes with the same expiry are
+        obtained from a single Fourier-cosine expansion of the
+        density of the log-price; the characteristic function is
+        evaluated once per expansion term and expiry, and each
+        further strike only costs a trigonometric recurrence.
+
+        The expansion interval is centred on the mean of the
+        log-price and its half-width is the given number of standard
+        deviations; both cumulants are estimated from the
+        characteristic function, so that derived engines only need
+        to provide an add-on term.
+
+        References:
+
+        F. Fang and C. W. Oosterlee, A Novel Pricing Method for
+        European Options Based on Fourier-Cosine Series Expansions,
+        SIAM J. Sci. Comput. 31(2), 2008.
+
+        \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with the analytic Heston engine.
+    */
+    class COSHestonEngine : public FFTHestonEngine {
+    public:
+        COSHestonEngine(const boost::shared_ptr<HestonModel>& model,
+                        Size nTerms = 256,
+                        Real truncation = 16.0);
+        virtual std::auto_ptr<FFTEngine> clone() const;
+
+    protected:
+        virtual std::vector<Real> callPrices(
+                                   Date d,
+                                   const std::vector<Real>& strikes) const;
+
+        Size nTerms_;
+        Real truncation_;
+    };
+
+}
+
+
+#endif
@@ -35,11 +35,45 @@ namespace QuantLib {
                          const Handle<YieldTermStructure>& h)
     : InterestRateIndex(familyName, tenor, settlementDays, currency,
                         fixingCalendar, dayCounter),
-      convention_(convention), termStructure_(h), endOfMonth_(endOfMonth) {
+      convention_(convention), termStructure_(h), endOfMonth_(endOfMonth),
+      cacheFixings_(false) {
         registerWith(termStructure_);
       }
 
+    void IborIndex::update() {
+        clearFixingCache();
+        InterestRateIndex::update();
+    }
+
+    void IborIndex::enableFixingCache(bool b) {
+        cacheFixings_ = b;
+        clearFixingCache();
+    }
+
+    void IborIndex::disableFixingCache() {
+        enableFixingCache(false);
+    }
+
+    void IborIndex::clearFixingCache() {
+        ParallelLock::Guard guard(cacheLock_);
+        fixingCache_.clear();
+        periodFixingCache_.clear();
+    }
+
     Rate IborIndex::forecastFixing(const Date& fixingDate) const {
+        Rate result = Null<Rate>();
+        if (cacheFixings_) {
+            {
+                ParallelLock::SharedGuard guard(cacheLock_);
+                std::map<Date, Rate>::const_iterator i =
+                    fixingCache_.find(fixingDate);
+                if (i != fixingCache_.end())
+                    result = i->second;
+            }
+            if (result != Null<Rate>())
+                return result;
+        }
+
         Date d1 = valueDate(fixingDate);
         Date d2 = maturityDate(d1);
         Time t = dayCounter_.yearFraction(d1, d2);
@@ -48,7 +82,13 @@ namespace QuantLib {
                    d1 << " and " << d2 <<
                    ":\n non positive time (" << t <<
                    ") using " << dayCounter_.name() << " daycounter");
-        return forecastFixing(d1, d2, t);
+        result = forecastFixing(d1, d2, t);
+
+        if (cacheFixings_) {
+            ParallelLock::Guard guard(cacheLock_);
+            fixingCache_[fixingDate] = result;
+        }
+        return result;
     }
 
     Date IborIndex::maturityDate(const Date& valueDate) const {
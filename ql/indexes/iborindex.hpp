@@ -28,6 +28,8 @@
 
 #include <ql/indexes/interestrateindex.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/utilities/parallellock.hpp>
+#include <map>
 
 namespace QuantLib {
 
@@ -56,17 +58,42 @@ namespace QuantLib {
         //! the curve used to forecast fixings
         Handle<YieldTermStructure> forwardingTermStructure() const;
         //@}
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
         //! \name Other methods
         //@{
         //! returns a copy of itself linked to a different forwarding curve
         virtual boost::shared_ptr<IborIndex> clone(
                         const Handle<YieldTermStructure>& forwarding) const;
         // @}
+        /*! \name Fixing cache
+
+            When enabled, forecast fixings are stored and returned
+            again for the same fixing date (or, for coupons, for the
+            same value and end dates) until the forwarding curve
+            notifies a change.  Lookups can be performed concurrently
+            from several threads when the library is compiled with
+            OpenMP; they share a lock owned by the index, which is
+            only acquired exclusively to store new fixings.
+            Clones start with the cache disabled.
+        */
+        //@{
+        void enableFixingCache(bool b = true);
+        void disableFixingCache();
+        bool fixingCacheEnabled() const { return cacheFixings_; }
+        //@}
       protected:
         BusinessDayConvention convention_;
         Handle<YieldTermStructure> termStructure_;
         bool endOfMonth_;
       private:
+        void clearFixingCache();
+        bool cacheFixings_;
+        mutable std::map<Date, Rate> fixingCache_;
+        mutable std::map<std::pair<Date, Date>, Rate> periodFixingCache_;
+        ParallelLock cacheLock_;
         // overload to avoid date/time (re)calculation
         /* This can be called with cached coupon dates (and it does
            give quite a performance boost to coupon calculations) but
@@ -108,9 +135,29 @@ namespace QuantLib {
                                           Time t) const {
         QL_REQUIRE(!termStructure_.empty(),
                    "null term structure set to this instance of " << name());
-        DiscountFactor disc1 = termStructure_->discount(d1);
-        DiscountFactor disc2 = termStructure_->discount(d2);
-        return (disc1/disc2 - 1.0) / t;
+        if (!cacheFixings_) {
+            DiscountFactor disc1 = termStructure_->discount(d1);
+            DiscountFactor disc2 = termStructure_->discount(d2);
+            return (disc1/disc2 - 1.0) / t;
+        }
+
+        const std::pair<Date, Date> key(d1, d2);
+        Rate result = Null<Rate>();
+        {
+            ParallelLock::SharedGuard guard(cacheLock_);
+            std::map<std::pair<Date, Date>, Rate>::const_iterator i =
+                periodFixingCache_.find(key);
+            if (i != periodFixingCache_.end())
+                result = i->second;
+        }
+        if (result == Null<Rate>()) {
+            DiscountFactor disc1 = termStructure_->discount(d1);
+            DiscountFactor disc2 = termStructure_->discount(d2);
+            result = (disc1/disc2 - 1.0) / t;
+            ParallelLock::Guard guard(cacheLock_);
+            periodFixingCache_[key] = result;
+        }
+        return result;
     }
 
 }
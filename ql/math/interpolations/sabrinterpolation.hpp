@@ -140,6 +140,13 @@ namespace QuantLib {
                 QL_REQUIRE(forward_>0.0, "at the money forward rate must be "
                            "positive: " << io::rate(forward_) << " not allowed");
 
+                // strikes are checked once here, so that the smile can
+                // be evaluated for all of them at once during the fit
+                strikes_.assign(this->xBegin_, this->xEnd_);
+                for (Size i=0; i<strikes_.size(); ++i)
+                    QL_REQUIRE(strikes_[i]>0.0, "strike must be positive: " <<
+                               io::rate(strikes_[i]) << " not allowed");
+
                 // we should also check that y contains positive values only
 
                 // we must update weights if it is vegaWeighted
@@ -171,8 +178,9 @@ namespace QuantLib {
                 } else {
 
                     SABRError costFunction(this);
-                    transformation_ = boost::shared_ptr<ParametersTransformation>(new
-                        SabrParametersTransformation);
+                    transformation_ =
+                        boost::shared_ptr<SabrParametersTransformation>(new
+                            SabrParametersTransformation);
 
                     Array guess(4);
                     guess[0] = alpha_;
@@ -227,27 +235,31 @@ namespace QuantLib {
             Real secondDerivative(Real) const {
                 QL_FAIL("SABR secondDerivative not implemented");
             }
+            // smile values at the interpolation strikes
+            std::vector<Real> modelVolatilities() const {
+                return unsafeSabrVolatilities(strikes_, forward_, t_,
+                                              alpha_, beta_, nu_, rho_);
+            }
             // calculate total squared weighted difference (L2 norm)
             Real interpolationSquaredError() const {
+                const std::vector<Real> vols = modelVolatilities();
                 Real error, totalError = 0.0;
-                std::vector<Real>::const_iterator x = this->xBegin_;
                 std::vector<Real>::const_iterator y = this->yBegin_;
                 std::vector<Real>::const_iterator w = weights_.begin();
-                for (; x != this->xEnd_; ++x, ++y, ++w) {
-                    error = (value(*x) - *y);
+                for (Size i=0; i<vols.size(); ++i, ++y, ++w) {
+                    error = (vols[i] - *y);
                     totalError += error*error * (*w);
                 }
                 return totalError;
             }
             // calculate weighted differences
             Disposable<Array> interpolationErrors(const Array&) const {
-                Array results(this->xEnd_ - this->xBegin_);
-                std::vector<Real>::const_iterator x = this->xBegin_;
-                Array::iterator r = results.begin();
+                const std::vector<Real> vols = modelVolatilities();
+                Array results(vols.size());
                 std::vector<Real>::const_iterator y = this->yBegin_;
                 std::vector<Real>::const_iterator w = weights_.begin();
-                for (; x != this->xEnd_; ++x, ++r, ++w, ++y) {
-                    *r = (value(*x) - *y)* std::sqrt(*w);
+                for (Size i=0; i<vols.size(); ++i, ++w, ++y) {
+                    results[i] = (vols[i] - *y)* std::sqrt(*w);
                 }
                 return results;
             }
@@ -259,11 +271,11 @@ namespace QuantLib {
             }
 
             Real interpolationMaxError() const {
+                const std::vector<Real> vols = modelVolatilities();
                 Real error, maxError = QL_MIN_REAL;
-                I1 i = this->xBegin_;
                 I2 j = this->yBegin_;
-                for (; i != this->xEnd_; ++i, ++j) {
-                    error = std::fabs(value(*i) - *j);
+                for (Size i=0; i<vols.size(); ++i, ++j) {
+                    error = std::fabs(vols[i] - *j);
                     maxError = std::max(maxError, error);
                 }
                 return maxError;
@@ -298,6 +310,16 @@ namespace QuantLib {
 
                     return y_;
                 }
+
+                //! derivatives of the direct transformation
+                Array directDerivatives(const Array& x) const {
+                    Array dy(4);
+                    dy[0] = 2.0*x[0];
+                    dy[1] = -2.0*x[1]*std::exp(-(x[1]*x[1]));
+                    dy[2] = 2.0*x[2];
+                    dy[3] = eps2_ * std::cos(x[3]);
+                    return dy;
+                }
             };
 
             class SABRError : public CostFunction {
@@ -323,14 +345,64 @@ namespace QuantLib {
                     return sabr_->interpolationErrors(x);
                 }
 
+                // the derivatives below are those of the Hagan
+                // expansion; no finite differences are needed
+                void gradient(Array& grad, const Array& x) const {
+                    std::vector<Real> vols;
+                    const Matrix jac = volatilityJacobian(x, vols);
+                    std::fill(grad.begin(), grad.end(), 0.0);
+                    std::vector<Real>::const_iterator y = sabr_->yBegin_;
+                    std::vector<Real>::const_iterator w =
+                        sabr_->weights_.begin();
+                    for (Size i=0; i<vols.size(); ++i, ++y, ++w) {
+                        const Real error = 2.0*(vols[i] - *y)*(*w);
+                        for (Size j=0; j<4; ++j)
+                            grad[j] += error*jac[i][j];
+                    }
+                }
+
+                void jacobian(Matrix& jac, const Array& x) const {
+                    std::vector<Real> vols;
+                    jac = volatilityJacobian(x, vols);
+                    std::vector<Real>::const_iterator w =
+                        sabr_->weights_.begin();
+                    for (Size i=0; i<jac.rows(); ++i, ++w) {
+                        const Real sqrtW = std::sqrt(*w);
+                        for (Size j=0; j<4; ++j)
+                            jac[i][j] *= sqrtW;
+                    }
+                }
+
               private:
+                // derivatives of the smile w.r.t. the optimizer variables
+                Disposable<Matrix> volatilityJacobian(
+                                               const Array& x,
+                                               std::vector<Real>& vols) const {
+                    const Array y = sabr_->transformation_->direct(x);
+                    sabr_->alpha_ = y[0];
+                    sabr_->beta_  = y[1];
+                    sabr_->nu_    = y[2];
+                    sabr_->rho_   = y[3];
+                    Matrix jac = unsafeSabrVolatilityJacobian(
+                                     sabr_->strikes_, sabr_->forward_,
+                                     sabr_->t_, y[0], y[1], y[2], y[3],
+                                     &vols);
+                    const Array dy =
+                        sabr_->transformation_->directDerivatives(x);
+                    for (Size i=0; i<jac.rows(); ++i)
+                        for (Size j=0; j<4; ++j)
+                            jac[i][j] *= dy[j];
+                    return jac;
+                }
+
                 SABRInterpolationImpl* sabr_;
             };
             boost::shared_ptr<EndCriteria> endCriteria_;
             boost::shared_ptr<OptimizationMethod> optMethod_;
             const Real& forward_;
             bool vegaWeighted_;
-            boost::shared_ptr<ParametersTransformation> transformation_;
+            boost::shared_ptr<SabrParametersTransformation> transformation_;
+            std::vector<Real> strikes_;
             NoConstraint constraint_;
 
         };
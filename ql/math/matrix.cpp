@@ -22,6 +22,7 @@
 */
 
 #include <ql/math/matrix.hpp>
+#include <ql/math/matrixutilities/lapack.hpp>
 #if defined(QL_PATCH_MSVC)
 #pragma warning(push)
 #pragma warning(disable:4180)
@@ -39,6 +40,63 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // rows and columns of the tiles used by the matrix product;
+        // three tiles of doubles fit comfortably in a 32kB L1 cache
+        const Size blockSize = 32;
+
+    }
+
+    const Disposable<Matrix> operator*(const Matrix& m1,
+                                       const Matrix& m2) {
+        QL_REQUIRE(m1.columns() == m2.rows(),
+                   "matrices with different sizes (" <<
+                   m1.rows() << "x" << m1.columns() << ", " <<
+                   m2.rows() << "x" << m2.columns() << ") cannot be "
+                   "multiplied");
+        const Size rows = m1.rows(), inner = m1.columns(),
+                   columns = m2.columns();
+        Matrix result(rows, columns, 0.0);
+        if (rows == 0 || inner == 0 || columns == 0)
+            return result;
+
+        #if defined(QL_USE_LAPACK)
+        // row-major C = A B is column-major C^T = B^T A^T
+        const char trans = 'N';
+        const int m = int(columns), n = int(rows), k = int(inner);
+        const double one = 1.0, zero = 0.0;
+        dgemm_(&trans, &trans, &m, &n, &k, &one,
+               m2.begin(), &m, m1.begin(), &k, &zero, result.begin(), &m);
+        #else
+        // i-k-j ordering on tiles: the innermost loop runs along
+        // contiguous rows of m2 and result and can be vectorized by
+        // the compiler. Each element still accumulates its products
+        // in order of increasing k, as a plain inner product would.
+        for (Size ii=0; ii<rows; ii+=blockSize) {
+            const Size iEnd = std::min(ii+blockSize, rows);
+            for (Size kk=0; kk<inner; kk+=blockSize) {
+                const Size kEnd = std::min(kk+blockSize, inner);
+                for (Size jj=0; jj<columns; jj+=blockSize) {
+                    const Size jEnd = std::min(jj+blockSize, columns);
+                    for (Size i=ii; i<iEnd; ++i) {
+                        Matrix::const_row_iterator a = m1.row_begin(i);
+                        Matrix::row_iterator c = result.row_begin(i);
+                        for (Size k=kk; k<kEnd; ++k) {
+                            const Real aik = a[k];
+                            Matrix::const_row_iterator b = m2.row_begin(k);
+                            for (Size j=jj; j<jEnd; ++j)
+                                c[j] += aik*b[j];
+                        }
+                    }
+                }
+            }
+        }
+        #endif
+
+        return result;
+    }
+
     Disposable<Matrix> inverse(const Matrix& m) {
         #if !defined(QL_NO_UBLAS_SUPPORT)
 
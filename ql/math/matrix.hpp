@@ -151,7 +151,11 @@ namespace QuantLib {
     const Disposable<Array> operator*(const Array&, const Matrix&);
     /*! \relates Matrix */
     const Disposable<Array> operator*(const Matrix&, const Array&);
-    /*! \relates Matrix */
+    /*! \relates Matrix
+
+        The product is computed by a cache-blocked loop or, if the
+        library was configured with QL_USE_LAPACK, by the BLAS.
+    */
     const Disposable<Matrix> operator*(const Matrix&, const Matrix&);
 
     // misc. operations
@@ -520,22 +524,6 @@ namespace QuantLib {
         return result;
     }
 
-    inline const Disposable<Matrix> operator*(const Matrix& m1,
-                                              const Matrix& m2) {
-        QL_REQUIRE(m1.columns() == m2.rows(),
-                   "matrices with different sizes (" <<
-                   m1.rows() << "x" << m1.columns() << ", " <<
-                   m2.rows() << "x" << m2.columns() << ") cannot be "
-                   "multiplied");
-        Matrix result(m1.rows(),m2.columns());
-        for (Size i=0; i<result.rows(); i++)
-            for (Size j=0; j<result.columns(); j++)
-                result[i][j] =
-                    std::inner_product(m1.row_begin(i), m1.row_end(i),
-                                       m2.column_begin(j), 0.0);
-        return result;
-    }
-
     inline const Disposable<Matrix> transpose(const Matrix& m) {
         Matrix result(m.columns(),m.rows());
         #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
@@ -18,6 +18,7 @@
 */
 
 #include <ql/math/matrixutilities/choleskydecomposition.hpp>
+#include <ql/math/matrixutilities/lapack.hpp>
 
 namespace QuantLib {
 
@@ -34,6 +35,29 @@ namespace QuantLib {
                            "input matrix is not symmetric");
         #endif
 
+        #if defined(QL_USE_LAPACK)
+        if (size > 0) {
+            // S is symmetric, so its column-major view is S itself;
+            // the upper factor U computed by LAPACK (S = U^T U) is
+            // the lower factor in row-major storage.
+            Matrix factor = S;
+            const char uplo = 'U';
+            const int n = int(size);
+            int info = 0;
+            dpotrf_(&uplo, &n, factor.begin(), &n, &info);
+            QL_REQUIRE(info >= 0,
+                       "illegal argument " << -info << " in dpotrf");
+            if (info == 0) {
+                for (i=0; i<size; i++)
+                    for (j=i+1; j<size; j++)
+                        factor[i][j] = 0.0;
+                return factor;
+            }
+            // not positive definite: the loop below either fails
+            // or handles the semi-definite case if flexible
+        }
+        #endif
+
         Matrix result(size, size, 0.0);
         Real sum;
         for (i=0; i<size; i++) {
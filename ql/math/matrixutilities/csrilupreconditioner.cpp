@@ -0,0 +1,99 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/csrilupreconditioner.hpp>
+#include <ql/utilities/null.hpp>
+
+namespace QuantLib {
+
+    CSRILUPreconditioner::CSRILUPreconditioner(const CSRMatrix& A)
+    : diagonal_(A.rows()) {
+
+        QL_REQUIRE(A.rows() == A.columns(),
+                   "ILU preconditioner works only with square matrices");
+
+        const Size n = A.rows();
+        const std::vector<Size>& ptr = A.rowPointers();
+        const std::vector<Size>& col = A.columnIndices();
+        std::vector<Real> lu = A.values();
+
+        for (Size i=0; i<n; ++i) {
+            Size k = ptr[i];
+            while (k < ptr[i+1] && col[k] < i)
+                ++k;
+            QL_REQUIRE(k < ptr[i+1] && col[k] == i,
+                       "diagonal entry of row " << i << " is not stored");
+            diagonal_[i] = k;
+        }
+
+        // IKJ variant of the Gaussian elimination, restricted to the
+        // sparsity pattern; position[j] locates column j in row i.
+        std::vector<Size> position(n, Null<Size>());
+        for (Size i=0; i<n; ++i) {
+            for (Size k=ptr[i]; k<ptr[i+1]; ++k)
+                position[col[k]] = k;
+
+            for (Size k=ptr[i]; k<diagonal_[i]; ++k) {
+                const Size l = col[k];
+                lu[k] /= lu[diagonal_[l]];
+                for (Size m=diagonal_[l]+1; m<ptr[l+1]; ++m) {
+                    const Size p = position[col[m]];
+                    if (p != Null<Size>())
+                        lu[p] -= lu[k]*lu[m];
+                }
+            }
+            QL_REQUIRE(lu[diagonal_[i]] != 0.0,
+                       "zero pivot in row " << i);
+
+            for (Size k=ptr[i]; k<ptr[i+1]; ++k)
+                position[col[k]] = Null<Size>();
+        }
+
+        std::vector<Size> rows(lu.size());
+        for (Size i=0; i<n; ++i)
+            std::fill(rows.begin()+ptr[i], rows.begin()+ptr[i+1], i);
+        lu_ = CSRMatrix(n, n, rows, col, lu);
+    }
+
+    Disposable<Array> CSRILUPreconditioner::apply(const Array& b) const {
+        const Size n = lu_.rows();
+        QL_REQUIRE(b.size() == n, "inconsistent size of rhs");
+
+        const std::vector<Size>& ptr = lu_.rowPointers();
+        const std::vector<Size>& col = lu_.columnIndices();
+        const std::vector<Real>& val = lu_.values();
+
+        Array x(n);
+        // forward substitution with the unit lower triangle
+        for (Size i=0; i<n; ++i) {
+            Real t = b[i];
+            for (Size k=ptr[i]; k<diagonal_[i]; ++k)
+                t -= val[k]*x[col[k]];
+            x[i] = t;
+        }
+        // backward substitution with the upper triangle
+        for (Size i=n; i>0; --i) {
+            const Size r = i-1;
+            Real t = x[r];
+            for (Size k=diagonal_[r]+1; k<ptr[r+1]; ++k)
+                t -= val[k]*x[col[k]];
+            x[r] = t/val[diagonal_[r]];
+        }
+        return x;
+    }
+
+}
@@ -0,0 +1,57 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file csrilupreconditioner.hpp
+    \brief ILU(0) preconditioner for compressed-sparse-row matrices
+*/
+
+#ifndef quantlib_csr_ilu_preconditioner_hpp
+#define quantlib_csr_ilu_preconditioner_hpp
+
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+
+namespace QuantLib {
+
+    //! ILU(0) preconditioner for compressed-sparse-row matrices
+    /*! The incomplete factors L and U share the sparsity pattern of
+        the given matrix, whose diagonal entries must be stored; L
+        has a unit diagonal, which is not stored.
+
+        References:
+        Saad, Yousef. 1996, Iterative methods for sparse linear systems,
+        http://www-users.cs.umn.edu/~saad/books.html
+
+        \test the preconditioner is used with GMRES to solve a
+              linear system and the solution is checked.
+    */
+    class CSRILUPreconditioner {
+      public:
+        CSRILUPreconditioner(const CSRMatrix& A);
+
+        //! L and U in the same storage, as in the given matrix
+        const CSRMatrix& LU() const { return lu_; }
+
+        Disposable<Array> apply(const Array& b) const;
+
+      private:
+        CSRMatrix lu_;
+        std::vector<Size> diagonal_;
+    };
+
+}
+
+#endif
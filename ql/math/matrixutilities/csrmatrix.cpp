@@ -0,0 +1,188 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    CSRMatrix::CSRMatrix()
+    : rows_(0), columns_(0), rowPointers_(1, 0) {}
+
+    CSRMatrix::CSRMatrix(Size rows, Size columns,
+                         const std::vector<Size>& rowIndices,
+                         const std::vector<Size>& columnIndices,
+                         const std::vector<Real>& values)
+    : rows_(rows), columns_(columns), rowPointers_(rows+1, 0) {
+
+        const Size n = values.size();
+        QL_REQUIRE(rowIndices.size() == n && columnIndices.size() == n,
+                   "inconsistent number of row indices ("
+                   << rowIndices.size() << "), column indices ("
+                   << columnIndices.size() << ") and values ("
+                   << n << ")");
+
+        // bucket the entries by row
+        for (Size k=0; k<n; ++k) {
+            QL_REQUIRE(rowIndices[k] < rows_ && columnIndices[k] < columns_,
+                       "entry (" << rowIndices[k] << ", "
+                       << columnIndices[k] << ") out of range");
+            ++rowPointers_[rowIndices[k]+1];
+        }
+        for (Size i=0; i<rows_; ++i)
+            rowPointers_[i+1] += rowPointers_[i];
+
+        std::vector<Size> next(rowPointers_.begin(), rowPointers_.end()-1);
+        std::vector<std::pair<Size, Real> > entries(n);
+        for (Size k=0; k<n; ++k)
+            entries[next[rowIndices[k]]++] =
+                std::make_pair(columnIndices[k], values[k]);
+
+        // sort each row by column and merge duplicates
+        columnIndices_.reserve(n);
+        values_.reserve(n);
+        Size begin = 0;
+        for (Size i=0; i<rows_; ++i) {
+            const Size end = rowPointers_[i+1];
+            std::sort(entries.begin()+begin, entries.begin()+end);
+            rowPointers_[i] = columnIndices_.size();
+            for (Size k=begin; k<end; ++k) {
+                if (k > begin && entries[k].first == columnIndices_.back())
+                    values_.back() += entries[k].second;
+                else {
+                    columnIndices_.push_back(entries[k].first);
+                    values_.push_back(entries[k].second);
+                }
+            }
+            begin = end;
+        }
+        rowPointers_[rows_] = columnIndices_.size();
+    }
+
+    CSRMatrix::CSRMatrix(const Array& diagonal)
+    : rows_(diagonal.size()), columns_(diagonal.size()),
+      rowPointers_(diagonal.size()+1), columnIndices_(diagonal.size()),
+      values_(diagonal.begin(), diagonal.end()) {
+        for (Size i=0; i<rows_; ++i)
+            rowPointers_[i] = columnIndices_[i] = i;
+        rowPointers_[rows_] = rows_;
+    }
+
+    const CSRMatrix& CSRMatrix::operator*=(Real x) {
+        for (Size k=0; k<values_.size(); ++k)
+            values_[k] *= x;
+        return *this;
+    }
+
+    Real CSRMatrix::operator()(Size i, Size j) const {
+        QL_REQUIRE(i < rows_ && j < columns_,
+                   "entry (" << i << ", " << j << ") out of range");
+        const std::vector<Size>::const_iterator begin =
+            columnIndices_.begin() + rowPointers_[i];
+        const std::vector<Size>::const_iterator end =
+            columnIndices_.begin() + rowPointers_[i+1];
+        const std::vector<Size>::const_iterator pos =
+            std::lower_bound(begin, end, j);
+        return (pos != end && *pos == j)
+            ? values_[pos - columnIndices_.begin()] : 0.0;
+    }
+
+    Disposable<Array> CSRMatrix::apply(const Array& x) const {
+        QL_REQUIRE(x.size() == columns_,
+                   "array of size " << x.size() << " cannot be multiplied "
+                   "by a " << rows_ << "x" << columns_ << " matrix");
+        Array y(rows_);
+
+        const Size* ptr = &rowPointers_[0];
+        const Size* col = columnIndices_.empty() ? 0 : &columnIndices_[0];
+        const Real* val = values_.empty() ? 0 : &values_[0];
+        const Integer n = Integer(rows_);
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for if (n > 10000)
+        #endif
+        for (Integer i=0; i<n; ++i) {
+            Real t = 0.0;
+            for (Size k=ptr[i]; k<ptr[i+1]; ++k)
+                t += val[k]*x[col[k]];
+            y[i] = t;
+        }
+        return y;
+    }
+
+    void CSRMatrix::swap(CSRMatrix& from) {
+        using std::swap;
+        swap(rows_, from.rows_);
+        swap(columns_, from.columns_);
+        rowPointers_.swap(from.rowPointers_);
+        columnIndices_.swap(from.columnIndices_);
+        values_.swap(from.values_);
+    }
+
+
+    const Disposable<CSRMatrix> operator+(const CSRMatrix& m1,
+                                          const CSRMatrix& m2) {
+        QL_REQUIRE(m1.rows() == m2.rows() && m1.columns() == m2.columns(),
+                   "matrices with different sizes (" <<
+                   m1.rows() << "x" << m1.columns() << ", " <<
+                   m2.rows() << "x" << m2.columns() << ") cannot be "
+                   "added");
+
+        // both operands are sorted by row and column, so the
+        // entries can be merged row by row
+        std::vector<Size> rowIndices, columnIndices;
+        std::vector<Real> values;
+        rowIndices.reserve(m1.nonZeros() + m2.nonZeros());
+        columnIndices.reserve(m1.nonZeros() + m2.nonZeros());
+        values.reserve(m1.nonZeros() + m2.nonZeros());
+
+        for (Size i=0; i<m1.rows(); ++i) {
+            Size k1 = m1.rowPointers()[i], k2 = m2.rowPointers()[i];
+            const Size end1 = m1.rowPointers()[i+1],
+                       end2 = m2.rowPointers()[i+1];
+            while (k1 < end1 || k2 < end2) {
+                Size j;
+                Real value;
+                if (k2 == end2 || (k1 < end1 && m1.columnIndices()[k1]
+                                                < m2.columnIndices()[k2])) {
+                    j = m1.columnIndices()[k1];
+                    value = m1.values()[k1++];
+                } else if (k1 == end1 || m2.columnIndices()[k2]
+                                           < m1.columnIndices()[k1]) {
+                    j = m2.columnIndices()[k2];
+                    value = m2.values()[k2++];
+                } else {
+                    j = m1.columnIndices()[k1];
+                    value = m1.values()[k1++] + m2.values()[k2++];
+                }
+                rowIndices.push_back(i);
+                columnIndices.push_back(j);
+                values.push_back(value);
+            }
+        }
+        CSRMatrix result(m1.rows(), m1.columns(),
+                         rowIndices, columnIndices, values);
+        return result;
+    }
+
+    const Disposable<CSRMatrix> operator*(Real x, const CSRMatrix& m) {
+        CSRMatrix result = m;
+        result *= x;
+        return result;
+    }
+
+}
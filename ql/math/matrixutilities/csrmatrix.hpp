@@ -0,0 +1,116 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file csrmatrix.hpp
+    \brief sparse matrix in compressed-sparse-row format
+*/
+
+#ifndef quantlib_csr_matrix_hpp
+#define quantlib_csr_matrix_hpp
+
+#include <ql/math/array.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! sparse matrix in compressed-sparse-row format
+    /*! The non-zero entries of row \f$ i \f$ are stored, ordered by
+        column, in positions rowPointers()[i] to rowPointers()[i+1]-1
+        of columnIndices() and values().
+
+        Unlike SparseMatrix, the structure is built once from the
+        full list of entries and is not modified afterwards, which
+        makes assembly from the finite-difference operators cheap
+        and the matrix-vector product a simple loop over contiguous
+        storage.  If the library is compiled with OpenMP, the rows
+        of large matrices are distributed among threads.
+
+        \test the matrix-vector product is checked against the
+              finite-difference operators it is assembled from.
+    */
+    class CSRMatrix {
+      public:
+        //! \name Constructors
+        //@{
+        //! creates a null matrix
+        CSRMatrix();
+        /*! builds the matrix from its entries in coordinate form;
+            entries with the same row and column are summed. */
+        CSRMatrix(Size rows, Size columns,
+                  const std::vector<Size>& rowIndices,
+                  const std::vector<Size>& columnIndices,
+                  const std::vector<Real>& values);
+        //! creates a diagonal matrix
+        explicit CSRMatrix(const Array& diagonal);
+        //@}
+        //! \name Algebraic operators
+        //@{
+        const CSRMatrix& operator*=(Real);
+        //@}
+        //! \name Inspectors
+        //@{
+        Size rows() const { return rows_; }
+        Size columns() const { return columns_; }
+        Size nonZeros() const { return values_.size(); }
+        const std::vector<Size>& rowPointers() const { return rowPointers_; }
+        const std::vector<Size>& columnIndices() const {
+            return columnIndices_;
+        }
+        const std::vector<Real>& values() const { return values_; }
+        //! returns zero for entries that are not stored
+        Real operator()(Size i, Size j) const;
+        //@}
+        //! \name Utilities
+        //@{
+        Disposable<Array> apply(const Array& x) const;
+        void swap(CSRMatrix&);
+        //@}
+      private:
+        Size rows_, columns_;
+        std::vector<Size> rowPointers_, columnIndices_;
+        std::vector<Real> values_;
+    };
+
+    // algebraic operators
+
+    /*! \relates CSRMatrix */
+    const Disposable<CSRMatrix> operator+(const CSRMatrix&,
+                                          const CSRMatrix&);
+    /*! \relates CSRMatrix */
+    const Disposable<CSRMatrix> operator*(Real, const CSRMatrix&);
+
+    /*! \relates CSRMatrix */
+    Disposable<Array> prod(const CSRMatrix& A, const Array& x);
+
+    /*! \relates CSRMatrix */
+    void swap(CSRMatrix&, CSRMatrix&);
+
+
+    // inline definitions
+
+    inline Disposable<Array> prod(const CSRMatrix& A, const Array& x) {
+        return A.apply(x);
+    }
+
+    inline void swap(CSRMatrix& m1, CSRMatrix& m2) {
+        m1.swap(m2);
+    }
+
+}
+
+
+#endif
@@ -0,0 +1,120 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/gmres.hpp>
+#include <ql/math/matrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    GMRES::GMRES(const GMRES::MatrixMult& A, Size maxIter, Real relTol,
+                 const GMRES::MatrixMult& preConditioner)
+    : A_(A), M_(preConditioner), maxIter_(maxIter), relTol_(relTol) {
+        QL_REQUIRE(maxIter_ > 0, "maxIter must be greater than zero");
+    }
+
+    GMRESResult GMRES::solve(const Array& b, const Array& x0) const {
+        return solveWithRestart(maxIter_, b, x0);
+    }
+
+    GMRESResult GMRES::solveWithRestart(Size restart, const Array& b,
+                                        const Array& x0) const {
+        QL_REQUIRE(restart > 0, "restart must be greater than zero");
+
+        const Real bnorm2 = norm2(b);
+        if (bnorm2 == 0.0) {
+            GMRESResult result = { 0, 0.0, b };
+            return result;
+        }
+
+        Array x = ((!x0.empty()) ? x0 : Array(b.size(), 0.0));
+        Array r = b - A_(x);
+        Real error = norm2(r)/bnorm2;
+        Size iterations = 0;
+
+        while (error >= relTol_ && iterations < maxIter_) {
+            const Size m = std::min(restart, maxIter_ - iterations);
+            const Real beta = norm2(r);
+
+            // Arnoldi process with modified Gram-Schmidt; the
+            // Hessenberg matrix is reduced to triangular form by
+            // Givens rotations as it is built.
+            std::vector<Array> v(1, r/beta), z;
+            Matrix h(m+1, m, 0.0);
+            std::vector<Real> c(m), s(m);
+            Array g(m+1, 0.0);
+            g[0] = beta;
+
+            Size j = 0;
+            while (j < m) {
+                z.push_back(M_ ? M_(v[j]) : v[j]);
+                Array w = A_(z[j]);
+                for (Size i=0; i<=j; ++i) {
+                    h[i][j] = DotProduct(w, v[i]);
+                    w -= h[i][j]*v[i];
+                }
+                const Real hNext = norm2(w);
+                h[j+1][j] = hNext;
+
+                for (Size i=0; i<j; ++i) {
+                    const Real t = c[i]*h[i][j] + s[i]*h[i+1][j];
+                    h[i+1][j] = -s[i]*h[i][j] + c[i]*h[i+1][j];
+                    h[i][j] = t;
+                }
+                const Real nu = std::sqrt(h[j][j]*h[j][j]
+                                          + h[j+1][j]*h[j+1][j]);
+                c[j] = h[j][j]/nu;
+                s[j] = h[j+1][j]/nu;
+                h[j][j] = nu;
+                h[j+1][j] = 0.0;
+                g[j+1] = -s[j]*g[j];
+                g[j] *= c[j];
+
+                ++j;
+                ++iterations;
+                error = std::fabs(g[j])/bnorm2;
+                if (error < relTol_ || hNext == 0.0)
+                    break;
+                v.push_back(w/hNext);
+            }
+
+            // back substitution for the coefficients of the update
+            Array y(j);
+            for (Size k=j; k>0; --k) {
+                const Size i = k-1;
+                Real t = g[i];
+                for (Size l=i+1; l<j; ++l)
+                    t -= h[i][l]*y[l];
+                y[i] = t/h[i][i];
+            }
+            for (Size i=0; i<j; ++i)
+                x += y[i]*z[i];
+
+            r = b - A_(x);
+            error = norm2(r)/bnorm2;
+        }
+
+        QL_REQUIRE(error < relTol_, "could not converge");
+
+        GMRESResult result = { iterations, error, x };
+        return result;
+    }
+
+    Real GMRES::norm2(const Array& a) const {
+        return std::sqrt(DotProduct(a, a));
+    }
+}
@@ -0,0 +1,59 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file lapack.hpp
+    \brief BLAS and LAPACK routines used by the matrix utilities
+
+    The declarations are only available when the library is
+    configured with QL_USE_LAPACK.  The Fortran routines work on
+    column-major storage; a row-major Matrix is therefore seen by
+    them as its transpose.
+*/
+
+#ifndef quantlib_math_lapack_hpp
+#define quantlib_math_lapack_hpp
+
+#include <ql/qldefines.hpp>
+
+#if defined(QL_USE_LAPACK)
+
+extern "C" {
+
+    void dgemm_(const char* transa, const char* transb,
+                const int* m, const int* n, const int* k,
+                const double* alpha, const double* a, const int* lda,
+                const double* b, const int* ldb,
+                const double* beta, double* c, const int* ldc);
+
+    void dpotrf_(const char* uplo, const int* n,
+                 double* a, const int* lda, int* info);
+
+    void dsyev_(const char* jobz, const char* uplo, const int* n,
+                double* a, const int* lda, double* w,
+                double* work, const int* lwork, int* info);
+
+    void dgesvd_(const char* jobu, const char* jobvt,
+                 const int* m, const int* n, double* a, const int* lda,
+                 double* s, double* u, const int* ldu,
+                 double* vt, const int* ldvt,
+                 double* work, const int* lwork, int* info);
+
+}
+
+#endif
+
+#endif
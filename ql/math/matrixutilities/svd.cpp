@@ -34,6 +34,7 @@
 
 
 #include <ql/math/matrixutilities/svd.hpp>
+#include <ql/math/matrixutilities/lapack.hpp>
 
 namespace QuantLib {
 
@@ -94,6 +95,33 @@ namespace QuantLib {
         s_ = Array(n_);
         U_ = Matrix(m_,n_, 0.0);
         V_ = Matrix(n_,n_);
+
+        #if defined(QL_USE_LAPACK)
+
+        /* The column-major view of A is A^T = U' S V'^T, so that
+           A = V' S U'^T. The n x m column-major V'^T has the same
+           storage as the m x n row-major U, while V is U'
+           transposed.  The singular values and U S V^T are the same
+           as with the built-in algorithm, but each pair of singular
+           vectors (u_i, v_i) may have the opposite sign.
+        */
+        const char job = 'S';
+        int info = 0, lwork = -1;
+        Real optimalWork;
+        Matrix u(n_, n_);
+        dgesvd_(&job, &job, &n_, &m_, A.begin(), &n_, s_.begin(),
+                u.begin(), &n_, U_.begin(), &n_,
+                &optimalWork, &lwork, &info);
+        lwork = int(optimalWork);
+        Array lapackWork(lwork);
+        dgesvd_(&job, &job, &n_, &m_, A.begin(), &n_, s_.begin(),
+                u.begin(), &n_, U_.begin(), &n_,
+                lapackWork.begin(), &lwork, &info);
+        QL_ENSURE(info == 0, "dgesvd failed (info = " << info << ")");
+        V_ = transpose(u);
+
+        #else
+
         Array e(n_);
         Array work(m_);
         Integer i, j, k;
@@ -480,6 +508,8 @@ namespace QuantLib {
                 break;
             }
         }
+
+        #endif
     }
 
     const Matrix& SVD::U() const {
@@ -48,8 +48,13 @@ namespace QuantLib {
     /*! Refer to Golub and Van Loan: Matrix computation,
         The Johns Hopkins University Press
 
+        The sign of each pair of left and right singular vectors is
+        not specified; in particular, it can differ between the
+        built-in algorithm and the LAPACK one (QL_USE_LAPACK).
+
         \test the correctness of the returned values is tested by
-              checking their properties.
+              checking their properties and by comparison with
+              analytic values.
     */
     class SVD {
       public:
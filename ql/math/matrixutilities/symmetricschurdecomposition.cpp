@@ -19,6 +19,7 @@
 */
 
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
+#include <ql/math/matrixutilities/lapack.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -30,6 +31,27 @@ namespace QuantLib {
         QL_REQUIRE(s.rows()==s.columns(), "input matrix must be square");
 
         Size size = s.rows();
+
+        #if defined(QL_USE_LAPACK)
+
+        // the column-major view of a symmetric matrix is the matrix
+        // itself; on exit, the eigenvectors are the rows of ss.
+        Matrix ss = s;
+        const char jobz = 'V', uplo = 'U';
+        const int n = int(size);
+        int lwork = -1, info = 0;
+        Real optimalWork;
+        dsyev_(&jobz, &uplo, &n, ss.begin(), &n, diagonal_.begin(),
+               &optimalWork, &lwork, &info);
+        lwork = int(optimalWork);
+        std::vector<Real> work(lwork);
+        dsyev_(&jobz, &uplo, &n, ss.begin(), &n, diagonal_.begin(),
+               &work[0], &lwork, &info);
+        QL_ENSURE(info == 0, "dsyev failed (info = " << info << ")");
+        eigenVectors_ = transpose(ss);
+
+        #else
+
         for (Size q=0; q<size; q++) {
             diagonal_[q] = s[q][q];
             eigenVectors_[q][q] = 1.0;
@@ -111,6 +133,7 @@ namespace QuantLib {
         QL_ENSURE(ite<=maxIterations,
                   "Too many iterations (" << maxIterations << ") reached");
 
+        #endif
 
         // sort (eigenvalues, eigenvectors)
         std::vector<std::pair<Real, std::vector<Real> > > temp(size);
@@ -26,8 +26,10 @@ namespace QuantLib {
 
     LevenbergMarquardt::LevenbergMarquardt(Real epsfcn,
                                            Real xtol,
-                                           Real gtol)
-    : info_(0), epsfcn_(epsfcn), xtol_(xtol), gtol_(gtol) {}
+                                           Real gtol,
+                                           bool useCostFunctionsJacobian)
+    : info_(0), epsfcn_(epsfcn), xtol_(xtol), gtol_(gtol),
+      useCostFunctionsJacobian_(useCostFunctionsJacobian) {}
 
     Integer LevenbergMarquardt::getInfo() const {
         return info_;
@@ -75,6 +77,10 @@ namespace QuantLib {
         // in n variables by the Levenberg-Marquardt algorithm.
         MINPACK::LmdifCostFunction lmdifCostFunction = 
             boost::bind(&LevenbergMarquardt::fcn, this, _1, _2, _3, _4, _5);
+        MINPACK::LmdifCostFunction lmdifJacFunction;
+        if (useCostFunctionsJacobian_)
+            lmdifJacFunction = boost::bind(&LevenbergMarquardt::jacFcn,
+                                           this, _1, _2, _3, _4, _5);
         MINPACK::lmdif(m, n, xx.get(), fvec.get(),
                        static_cast<double>(endCriteria.functionEpsilon()),
                        static_cast<double>(xtol_),
@@ -85,7 +91,7 @@ namespace QuantLib {
                        nprint, &info, &nfev, fjac.get(),
                        ldfjac, ipvt.get(), qtf.get(),
                        wa1.get(), wa2.get(), wa3.get(), wa4.get(),
-                       lmdifCostFunction);
+                       lmdifCostFunction, lmdifJacFunction);
         info_ = info;
         // check requirements & endCriteria evaluation
         QL_REQUIRE(info != 0, "MINPACK: improper input parameters");
@@ -123,5 +129,23 @@ namespace QuantLib {
         }
     }
 
+    void LevenbergMarquardt::jacFcn(int m, int n, double* x, double* fjac,
+                                    int*) {
+        Array xt(n);
+        std::copy(x, x+n, xt.begin());
+        // as in fcn, the values are frozen at their initial ones
+        // outside the constraint, so that their jacobian vanishes
+        if (currentProblem_->constraint().test(xt)) {
+            Matrix jac(m, n);
+            currentProblem_->costFunction().jacobian(jac, xt);
+            // MINPACK expects the jacobian in column-major order
+            for (Integer j=0; j<n; ++j)
+                for (Integer i=0; i<m; ++i)
+                    fjac[j*m+i] = jac[i][j];
+        } else {
+            std::fill(fjac, fjac+m*n, 0.0);
+        }
+    }
+
 }
 
@@ -32,12 +32,18 @@ namespace QuantLib {
     /*! This implementation is based on MINPACK
         (<http://www.netlib.org/minpack>,
         <http://www.netlib.org/cephes/linalg.tgz>)
+
+        If useCostFunctionsJacobian is true, the jacobian provided
+        by the cost function is used instead of the forward-difference
+        approximation; this pays off when the cost function overloads
+        CostFunction::jacobian with an analytic expression.
     */
     class LevenbergMarquardt : public OptimizationMethod {
       public:
         LevenbergMarquardt(Real epsfcn = 1.0e-8,
                            Real xtol = 1.0e-8,
-                           Real gtol = 1.0e-8);
+                           Real gtol = 1.0e-8,
+                           bool useCostFunctionsJacobian = false);
         virtual EndCriteria::Type minimize(Problem& P,
                                            const EndCriteria& endCriteria //= EndCriteria()
                                            );
@@ -48,11 +54,17 @@ namespace QuantLib {
                  double* x,
                  double* fvec,
                  int* iflag);
+        void jacFcn(int m,
+                    int n,
+                    double* x,
+                    double* fjac,
+                    int* iflag);
       private:
         Problem* currentProblem_;
         Array initCostValues_;
         mutable Integer info_;
         const Real epsfcn_, xtol_, gtol_;
+        const bool useCostFunctionsJacobian_;
     };
 
 }
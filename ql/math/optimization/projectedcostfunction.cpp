@@ -60,6 +60,30 @@ namespace QuantLib {
         return costFunction_.values(actualParameters_);
     }
 
+    void ProjectedCostFunction::gradient(Array& grad,
+                                         const Array& freeParameters) const {
+        mapFreeParameters(freeParameters);
+        Array fullGradient(actualParameters_.size());
+        costFunction_.gradient(fullGradient, actualParameters_);
+        Size i = 0;
+        for (Size j=0; j<parametersFreedoms_.size(); j++)
+            if(!parametersFreedoms_[j])
+                grad[i++] = fullGradient[j];
+    }
+
+    void ProjectedCostFunction::jacobian(Matrix& jac,
+                                         const Array& freeParameters) const {
+        mapFreeParameters(freeParameters);
+        Matrix fullJacobian(jac.rows(), actualParameters_.size());
+        costFunction_.jacobian(fullJacobian, actualParameters_);
+        for (Size k=0; k<jac.rows(); k++) {
+            Size i = 0;
+            for (Size j=0; j<parametersFreedoms_.size(); j++)
+                if(!parametersFreedoms_[j])
+                    jac[k][i++] = fullJacobian[k][j];
+        }
+    }
+
     Disposable<Array> ProjectedCostFunction::project
                                             (const Array& parameters) const{
         QL_REQUIRE(parameters.size()==parametersFreedoms_.size(),
@@ -45,6 +45,10 @@ namespace QuantLib {
             virtual Real value(const Array& freeParameters) const;
             virtual Disposable<Array>
                                    values(const Array& freeParameters) const;
+            virtual void gradient(Array& grad,
+                                  const Array& freeParameters) const;
+            virtual void jacobian(Matrix& jac,
+                                  const Array& freeParameters) const;
             //@}
 
             //! returns the subset of free parameters corresponding
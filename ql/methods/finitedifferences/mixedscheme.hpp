@@ -53,6 +53,11 @@ namespace QuantLib {
         array_type solveFor(const array_type&);
         static Operator identity(Size size);
 
+        // in-place operator interface, used by step();
+        // result and argument can be the same array
+        void applyTo(const array_type&, array_type& result);
+        void solveFor(const array_type&, array_type& result);
+
         // operator algebra
         Operator operator*(Real, const Operator&);
         Operator operator+(const Operator&, const Operator&);
@@ -114,7 +119,7 @@ namespace QuantLib {
             }
             for (i=0; i<bcs_.size(); i++)
                 bcs_[i]->applyBeforeApplying(explicitPart_);
-            a = explicitPart_.applyTo(a);
+            explicitPart_.applyTo(a, a);
             for (i=0; i<bcs_.size(); i++)
                 bcs_[i]->applyAfterApplying(a);
         }
@@ -163,4 +163,14 @@ namespace QuantLib {
         return retVal;
     }
 #endif
+
+    Disposable<CSRMatrix> Fdm2dBlackScholesOp::toCSRMatrix() const {
+        CSRMatrix retVal =
+              opX_.toCSRMatrix() + opY_.toCSRMatrix()
+            + corrMapT_.toCSRMatrix()
+            + CSRMatrix(Array(mesher_->layout()->size(),
+                              currentForwardRate_));
+
+        return retVal;
+    }
 }
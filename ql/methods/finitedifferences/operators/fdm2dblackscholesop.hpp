@@ -58,6 +58,7 @@ namespace QuantLib {
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<SparseMatrix> toMatrix() const;
 #endif
+    Disposable<CSRMatrix> toCSRMatrix() const;
       private:
         const boost::shared_ptr<FdmMesher> mesher_;
         const boost::shared_ptr<GeneralizedBlackScholesProcess> p1_, p2_;
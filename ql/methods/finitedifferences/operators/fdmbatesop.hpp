@@ -55,6 +55,9 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        //! not available: the jump integral is not a sparse operator
+        Disposable<CSRMatrix> toCSRMatrix() const;
+
       private:
         class IntegroIntegrand {
           public:
@@ -115,6 +118,12 @@ namespace QuantLib {
                                                  Real s) const {
         return hestonOp_->preconditioner(r, s);
     }
+
+    inline Disposable<CSRMatrix> FdmBatesOp::toCSRMatrix() const {
+        QL_FAIL("the jump integral of the Bates operator can't be "
+                "assembled as a sparse matrix; "
+                "use the BiCGstab solver instead of GMRES");
+    }
     
 }
 
@@ -0,0 +1,85 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmblackscholesfwdop.hpp
+    \brief Black Scholes Fokker-Planck operator
+*/
+
+#ifndef quantlib_fdm_black_scholes_fwd_op_hpp
+#define quantlib_fdm_black_scholes_fwd_op_hpp
+
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
+
+namespace QuantLib {
+
+    //! Black Scholes Fokker-Planck operator
+    /*! Adjoint of FdmBlackScholesOp: it evolves forward in time the
+        Arrow-Debreu density \f$ \psi(t, x) \f$ of the logarithm of
+        the underlying,
+        \f[
+            \frac{\partial \psi}{\partial t} =
+            - \frac{\partial}{\partial x}
+                \left[ \left(r - q - \frac{\sigma^2}{2}\right) \psi \right]
+            + \frac{1}{2} \frac{\partial^2}{\partial x^2}
+                \left[ \sigma^2 \psi \right] - r \psi.
+        \f]
+        Its integral over \f$ x \f$ is the discount factor to
+        \f$ t \f$; see FdmForwardSolver. The spatial terms are
+        discretized by FokkerPlanckOp, i.e., with zero flux through
+        the boundaries.
+    */
+    class FdmBlackScholesFwdOp : public FdmLinearOpComposite {
+      public:
+        FdmBlackScholesFwdOp(
+            const boost::shared_ptr<FdmMesher>& mesher,
+            const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            Real strike,
+            bool localVol = false,
+            Real illegalLocalVolOverwrite = -Null<Real>(),
+            Size direction = 0);
+
+        Size size() const;
+        void setTime(Time t1, Time t2);
+
+        Disposable<Array> apply(const Array& r) const;
+        Disposable<Array> apply_mixed(const Array& r) const;
+        Disposable<Array> apply_direction(Size direction,
+                                          const Array& r) const;
+        Disposable<Array> solve_splitting(Size direction,
+                                          const Array& r, Real s) const;
+        Disposable<Array> preconditioner(const Array& r, Real s) const;
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+        Disposable<SparseMatrix> toMatrix() const;
+#endif
+        Disposable<CSRMatrix> toCSRMatrix() const;
+      private:
+        const boost::shared_ptr<FdmMesher> mesher_;
+        const boost::shared_ptr<YieldTermStructure> rTS_, qTS_;
+        const boost::shared_ptr<BlackVolTermStructure> volTS_;
+        const boost::shared_ptr<LocalVolTermStructure> localVol_;
+        const Array x_;
+        TripleBandLinearOp mapT_;
+        const Real strike_;
+        const Real illegalLocalVolOverwrite_;
+        const Size direction_;
+    };
+}
+
+#endif
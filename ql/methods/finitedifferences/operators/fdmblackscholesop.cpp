@@ -132,4 +132,8 @@ namespace QuantLib {
         return mapT_.toMatrix();
     }
 #endif
+
+    Disposable<CSRMatrix> FdmBlackScholesOp::toCSRMatrix() const {
+        return mapT_.toCSRMatrix();
+    }
 }
@@ -120,5 +120,11 @@ namespace QuantLib {
         return retVal;
     }
 #endif
+
+    Disposable<CSRMatrix> FdmG2Op::toCSRMatrix() const {
+        CSRMatrix retVal = mapX_.toCSRMatrix() + mapY_.toCSRMatrix()
+                         + corrMap_.toCSRMatrix();
+        return retVal;
+    }
 }
 
@@ -54,6 +54,7 @@ namespace QuantLib {
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<SparseMatrix> toMatrix() const;
 #endif
+        Disposable<CSRMatrix> toCSRMatrix() const;
       private:
         const Size direction1_, direction2_;
         const Array x_, y_;
@@ -0,0 +1,169 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmhestonfwdop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/operators/fokkerplanckop.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        /* coefficients of the first derivative at the minus, center
+           and plus points. They are chosen so that the trapezoidal
+           integral of the derivative only depends on the values at
+           the boundaries, as for the exact derivative. */
+        void conservativeDerivative(Size co, Size n, Real hm, Real hp,
+                                    Real c[3]) {
+            if (co == 0) {
+                c[0] = 0.0; c[1] = -1.0/hp; c[2] = 1.0/hp;
+            }
+            else if (co == n-1) {
+                c[0] = -1.0/hm; c[1] = 1.0/hm; c[2] = 0.0;
+            }
+            else {
+                c[0] = -1.0/(hm+hp); c[1] = 0.0; c[2] = 1.0/(hm+hp);
+            }
+        }
+
+        /* SecondOrderMixedDerivativeOp is second-order accurate on
+           non-uniform grids but does not preserve the integral of the
+           density, which introduces an error of first order in the
+           expected value of the underlying. */
+        class ConservativeMixedDerivativeOp : public NinePointLinearOp {
+          public:
+            ConservativeMixedDerivativeOp(
+                                 Size d0, Size d1,
+                                 const boost::shared_ptr<FdmMesher>& mesher)
+            : NinePointLinearOp(d0, d1, mesher) {
+                const boost::shared_ptr<FdmLinearOpLayout> layout
+                    = mesher->layout();
+                const FdmLinearOpIterator endIter = layout->end();
+
+                for (FdmLinearOpIterator iter = layout->begin();
+                     iter!=endIter; ++iter) {
+                    const Size i = iter.index();
+
+                    Real c0[3], c1[3];
+                    conservativeDerivative(
+                        iter.coordinates()[d0_], layout->dim()[d0_],
+                        mesher->dminus(iter, d0_), mesher->dplus(iter, d0_),
+                        c0);
+                    conservativeDerivative(
+                        iter.coordinates()[d1_], layout->dim()[d1_],
+                        mesher->dminus(iter, d1_), mesher->dplus(iter, d1_),
+                        c1);
+
+                    a00_[i] = c0[0]*c1[0]; a10_[i] = c0[1]*c1[0];
+                    a20_[i] = c0[2]*c1[0]; a01_[i] = c0[0]*c1[1];
+                    a11_[i] = c0[1]*c1[1]; a21_[i] = c0[2]*c1[1];
+                    a02_[i] = c0[0]*c1[2]; a12_[i] = c0[1]*c1[2];
+                    a22_[i] = c0[2]*c1[2];
+                }
+            }
+        };
+
+    }
+
+    FdmHestonFwdOp::FdmHestonFwdOp(
+        const boost::shared_ptr<FdmMesher>& mesher,
+        const boost::shared_ptr<HestonProcess> & hestonProcess)
+    : mesher_(mesher),
+      rTS_(hestonProcess->riskFreeRate().currentLink()),
+      qTS_(hestonProcess->dividendYield().currentLink()),
+      dxDrift_(-0.5*mesher->locations(1)),
+      dxDiffusion_(0.5*mesher->locations(1)),
+      dyMap_(FokkerPlanckOp(1, mesher,
+                            hestonProcess->kappa()
+                            *(hestonProcess->theta() - mesher->locations(1)),
+                            0.5*hestonProcess->sigma()*hestonProcess->sigma()
+                            *mesher->locations(1))),
+      mapX_(0, mesher),
+      mapY_(1, mesher),
+      correlationMap_(ConservativeMixedDerivativeOp(0, 1, mesher)
+                        .multR(hestonProcess->rho()*hestonProcess->sigma()
+                               *mesher->locations(1))) {
+    }
+
+    void FdmHestonFwdOp::setTime(Time t1, Time t2) {
+        const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
+        const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
+
+        const FokkerPlanckOp dxMap(0, mesher_, r - q + dxDrift_, dxDiffusion_);
+        mapX_.axpyb(Array(), dxMap, dxMap, Array(1, -0.5*r));
+        mapY_.axpyb(Array(), dyMap_, dyMap_, Array(1, -0.5*r));
+    }
+
+    Size FdmHestonFwdOp::size() const {
+        return 2;
+    }
+
+    Disposable<Array> FdmHestonFwdOp::apply(const Array& u) const {
+        return mapY_.apply(u) + mapX_.apply(u) + correlationMap_.apply(u);
+    }
+
+    Disposable<Array> FdmHestonFwdOp::apply_direction(Size direction,
+                                                      const Array& r) const {
+        if (direction == 0)
+            return mapX_.apply(r);
+        else if (direction == 1)
+            return mapY_.apply(r);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    Disposable<Array> FdmHestonFwdOp::apply_mixed(const Array& r) const {
+        return correlationMap_.apply(r);
+    }
+
+    Disposable<Array>
+        FdmHestonFwdOp::solve_splitting(Size direction,
+                                        const Array& r, Real a) const {
+
+        if (direction == 0) {
+            return mapX_.solve_splitting(r, a, 1.0);
+        }
+        else if (direction == 1) {
+            return mapY_.solve_splitting(r, a, 1.0);
+        }
+        else
+            QL_FAIL("direction too large");
+    }
+
+    Disposable<Array>
+        FdmHestonFwdOp::preconditioner(const Array& r, Real dt) const {
+
+        return solve_splitting(0, r, dt);
+    }
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    Disposable<SparseMatrix> FdmHestonFwdOp::toMatrix() const {
+        SparseMatrix retVal = mapY_.toMatrix() + mapX_.toMatrix()
+                            + correlationMap_.toMatrix();
+
+        return retVal;
+    }
+#endif
+
+    Disposable<CSRMatrix> FdmHestonFwdOp::toCSRMatrix() const {
+        CSRMatrix retVal = mapY_.toCSRMatrix() + mapX_.toCSRMatrix()
+                         + correlationMap_.toCSRMatrix();
+
+        return retVal;
+    }
+}
@@ -0,0 +1,87 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmhestonfwdop.hpp
+    \brief Heston Fokker-Planck operator
+*/
+
+#ifndef quantlib_fdm_heston_fwd_op_hpp
+#define quantlib_fdm_heston_fwd_op_hpp
+
+#include <ql/processes/hestonprocess.hpp>
+#include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+#include <ql/methods/finitedifferences/operators/ninepointlinearop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
+
+namespace QuantLib {
+
+    //! Heston Fokker-Planck operator
+    /*! Adjoint of FdmHestonOp: it evolves forward in time the
+        Arrow-Debreu density \f$ \psi(t, x, v) \f$ of the logarithm
+        of the underlying and of the variance,
+        \f[
+        \begin{array}{rcl}
+            \frac{\partial \psi}{\partial t} & = &
+            - \frac{\partial}{\partial x}
+                \left[ \left(r - q - \frac{v}{2}\right) \psi \right]
+            - \frac{\partial}{\partial v}
+                \left[ \kappa (\theta - v) \psi \right] \\
+            & & + \frac{1}{2} \frac{\partial^2}{\partial x^2} [v \psi]
+            + \rho \sigma \frac{\partial^2}{\partial x \partial v} [v \psi]
+            + \frac{\sigma^2}{2} \frac{\partial^2}{\partial v^2} [v \psi]
+            - r \psi.
+        \end{array}
+        \f]
+        The terms in a single direction are discretized by
+        FokkerPlanckOp, i.e., with zero flux through the boundaries;
+        the mixed term is expected to vanish there. The variance
+        grid should start at zero, so that no probability is lost
+        at the lower variance boundary.
+    */
+    class FdmHestonFwdOp : public FdmLinearOpComposite {
+      public:
+        FdmHestonFwdOp(
+            const boost::shared_ptr<FdmMesher>& mesher,
+            const boost::shared_ptr<HestonProcess>& hestonProcess);
+
+        Size size() const;
+        void setTime(Time t1, Time t2);
+
+        Disposable<Array> apply(const Array& r) const;
+        Disposable<Array> apply_mixed(const Array& r) const;
+
+        Disposable<Array> apply_direction(Size direction,
+                                          const Array& r) const;
+        Disposable<Array> solve_splitting(Size direction,
+                                          const Array& r, Real s) const;
+        Disposable<Array> preconditioner(const Array& r, Real s) const;
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+        Disposable<SparseMatrix> toMatrix() const;
+#endif
+        Disposable<CSRMatrix> toCSRMatrix() const;
+      private:
+        const boost::shared_ptr<FdmMesher> mesher_;
+        const boost::shared_ptr<YieldTermStructure> rTS_, qTS_;
+        const Array dxDrift_, dxDiffusion_;
+        const TripleBandLinearOp dyMap_;
+        TripleBandLinearOp mapX_, mapY_;
+        const NinePointLinearOp correlationMap_;
+    };
+}
+
+#endif
@@ -166,4 +166,13 @@ namespace QuantLib {
         return retVal;
     }
 #endif
+
+    Disposable<CSRMatrix> FdmHestonHullWhiteOp::toCSRMatrix() const {
+        CSRMatrix retVal =
+                dyMap_.toCSRMatrix() + dxMap_.getMap().toCSRMatrix()
+              + hullWhiteOp_.toCSRMatrix()
+              + hestonCorrMap_.toCSRMatrix() + equityIrCorrMap_.toCSRMatrix();
+
+        return retVal;
+    }
 }
@@ -83,6 +83,7 @@ namespace QuantLib {
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<SparseMatrix> toMatrix() const;
 #endif
+        Disposable<CSRMatrix> toCSRMatrix() const;
       private:
         const Real v0_, kappa_, theta_, sigma_, rho_;
         const boost::shared_ptr<HullWhite> hwModel_;
@@ -34,8 +34,11 @@ namespace QuantLib {
         const boost::shared_ptr<FdmQuantoHelper>& quantoHelper)
     : varianceValues_(0.5*mesher->locations(1)),
       dxMap_ (FirstDerivativeOp(0, mesher)),
-      dxxMap_(SecondDerivativeOp(0, mesher).mult(0.5*mesher->locations(1))),
+      varianceMap_(
+          SecondDerivativeOp(0, mesher).mult(0.5*mesher->locations(1))),
       mapT_  (0, mesher),
+      drift_((quantoHelper) ? mesher->layout()->size() : 1),
+      discountRate_(1),
       mesher_(mesher),
       rTS_(rTS),
       qTS_(qTS),
@@ -54,21 +57,26 @@ namespace QuantLib {
             }
         }
         volatilityValues_ = Sqrt(2*varianceValues_);
+        varianceMap_ = varianceMap_.add(dxMap_.mult(-varianceValues_));
     }
 
     void FdmHestonEquityPart::setTime(Time t1, Time t2) {
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
         const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
 
+        // the bands of mapT_ are overwritten in place
         if (quantoHelper_) {
-            mapT_.axpyb(r - q - varianceValues_
-                - quantoHelper_->quantoAdjustment(
-                volatilityValues_, t1, t2),
-                dxMap_, dxxMap_, Array(1, -0.5*r));
+            const Array quantoAdjustment =
+                quantoHelper_->quantoAdjustment(volatilityValues_, t1, t2);
+            for (Size i=0; i < drift_.size(); ++i)
+                drift_[i] = r - q - quantoAdjustment[i];
         }
         else {
-            mapT_.axpyb(r - q - varianceValues_, dxMap_, dxxMap_, Array(1, -0.5*r));
+            drift_[0] = r - q;
         }
+        discountRate_[0] = -0.5*r;
+
+        mapT_.axpyb(drift_, dxMap_, varianceMap_, discountRate_);
     }
 
     const TripleBandLinearOp& FdmHestonEquityPart::getMap() const {
@@ -84,12 +92,14 @@ namespace QuantLib {
              .add(FirstDerivativeOp(1, mesher)
                   .mult(kappa*(theta - mesher->locations(1))))),
       mapT_(1, mesher),
+      discountRate_(1),
       rTS_(rTS) {
     }
 
     void FdmHestonVariancePart::setTime(Time t1, Time t2) {
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
-        mapT_.axpyb(Array(), dyMap_, dyMap_, Array(1,-0.5*r));
+        discountRate_[0] = -0.5*r;
+        mapT_.axpyb(Array(), dyMap_, dyMap_, discountRate_);
     }
 
     const TripleBandLinearOp& FdmHestonVariancePart::getMap() const {
@@ -171,4 +181,12 @@ namespace QuantLib {
         return retVal;
     }
 #endif
+
+    Disposable<CSRMatrix> FdmHestonOp::toCSRMatrix() const {
+        CSRMatrix retVal =
+              dyMap_.getMap().toCSRMatrix() + dxMap_.getMap().toCSRMatrix()
+            + correlationMap_.toCSRMatrix();
+
+        return retVal;
+    }
 }
@@ -49,8 +49,12 @@ namespace QuantLib {
       protected:
         Array varianceValues_, volatilityValues_;
         const FirstDerivativeOp  dxMap_;
-        const TripleBandLinearOp dxxMap_;
+        // time-independent part of the operator, i.e., the diffusion
+        // and the variance term of the drift
+        TripleBandLinearOp varianceMap_;
         TripleBandLinearOp mapT_;
+        // preallocated coefficients of the time-dependent part
+        Array drift_, discountRate_;
 
         const boost::shared_ptr<FdmMesher> mesher_;
         const boost::shared_ptr<YieldTermStructure> rTS_, qTS_;
@@ -70,6 +74,7 @@ namespace QuantLib {
       protected:
         const TripleBandLinearOp dyMap_;
         TripleBandLinearOp mapT_;
+        Array discountRate_;
 
         const boost::shared_ptr<YieldTermStructure> rTS_;
     };
@@ -98,6 +103,7 @@ namespace QuantLib {
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<SparseMatrix> toMatrix() const;
 #endif
+        Disposable<CSRMatrix> toCSRMatrix() const;
       private:
         NinePointLinearOp correlationMap_;
         FdmHestonVariancePart dyMap_;
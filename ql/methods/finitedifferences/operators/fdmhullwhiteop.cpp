@@ -99,5 +99,9 @@ namespace QuantLib {
         return mapT_.toMatrix();
     }
 #endif
+
+    Disposable<CSRMatrix> FdmHullWhiteOp::toCSRMatrix() const {
+        return mapT_.toCSRMatrix();
+    }
 }
 
@@ -55,6 +55,7 @@ namespace QuantLib {
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<SparseMatrix> toMatrix() const;
 #endif
+        Disposable<CSRMatrix> toCSRMatrix() const;
       private:
         const Size direction_;
         const Array x_;
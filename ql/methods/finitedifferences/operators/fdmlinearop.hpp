@@ -28,6 +28,7 @@
 
 #include <ql/math/array.hpp>
 #include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 
 namespace QuantLib {
 
@@ -42,6 +43,9 @@ namespace QuantLib {
             QL_FAIL("not implemented");
         }
 #endif
+        virtual Disposable<CSRMatrix> toCSRMatrix() const {
+            QL_FAIL("not implemented");
+        }
     };
 }
 
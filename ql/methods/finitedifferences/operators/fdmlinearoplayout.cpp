@@ -20,6 +20,7 @@
 */
 
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/errors.hpp>
 
 namespace QuantLib {
 
@@ -85,4 +86,20 @@ namespace QuantLib {
 
         return retVal;
     }
+
+    Disposable<FdmLinearOpIterator> FdmLinearOpLayout::iter_at(
+                                                        Size index) const {
+        QL_REQUIRE(index <= size_, "index " << index
+                   << " is out of range [0, " << size_ << "]");
+
+        std::vector<Size> coordinates(dim_.size());
+        for (Size i=dim_.size(), rest=index; i > 0; --i) {
+            coordinates[i-1] = rest/spacing_[i-1];
+            rest -= coordinates[i-1]*spacing_[i-1];
+        }
+
+        FdmLinearOpIterator retVal(dim_, coordinates, index);
+
+        return retVal;
+    }
 }
@@ -79,6 +79,10 @@ namespace QuantLib {
         Disposable<FdmLinearOpIterator> iter_neighbourhood(
             const FdmLinearOpIterator& iterator, Size i, Integer offset) const;
 
+        // iterator pointing to the given index, e.g. to start
+        // one chunk of a loop which is split among threads
+        Disposable<FdmLinearOpIterator> iter_at(Size index) const;
+
       private:
         Size size_;
         std::vector<Size> dim_, spacing_;
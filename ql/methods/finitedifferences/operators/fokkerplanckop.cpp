@@ -0,0 +1,92 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/operators/fokkerplanckop.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        /* flux a*psi_l - b*psi_u between a point and its upper
+           neighbour at distance h. The centered convective flux is
+           used as long as both coefficients are non-negative. */
+        void interfaceFlux(Real muL, Real muU, Real dL, Real dU, Real h,
+                           Real& a, Real& b) {
+            const Real mu = 0.5*(muL + muU);
+            a = dL/h;
+            b = dU/h;
+            if (mu <= 2.0*b && mu >= -2.0*a) {
+                a += 0.5*mu;
+                b -= 0.5*mu;
+            }
+            else if (mu > 0.0)
+                a += mu;
+            else
+                b -= mu;
+        }
+
+    }
+
+    FokkerPlanckOp::FokkerPlanckOp(
+        Size direction,
+        const boost::shared_ptr<FdmMesher>& mesher,
+        const Array& drift,
+        const Array& diffusion)
+    : TripleBandLinearOp(direction, mesher) {
+
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+        QL_REQUIRE(drift.size() == layout->size()
+                   && diffusion.size() == layout->size(),
+                   "drift and diffusion must be given for each grid point");
+
+        const Size n = layout->dim()[direction_];
+        const FdmLinearOpIterator endIter = layout->end();
+
+        for (FdmLinearOpIterator iter = layout->begin(); iter!=endIter; ++iter) {
+            const Size i = iter.index();
+            const Size co = iter.coordinates()[direction_];
+
+            lower_[i] = diag_[i] = upper_[i] = 0.0;
+            if (n == 1)
+                continue;
+
+            const Real hm = (co == 0)
+                ? 0.0 : mesher->dminus(iter, direction_);
+            const Real hp = (co == n-1)
+                ? 0.0 : mesher->dplus(iter, direction_);
+            const Real w = 0.5*(hm + hp);
+
+            Real a, b;
+            if (co > 0) {
+                const Size im = i0_[i];
+                interfaceFlux(drift[im], drift[i],
+                              diffusion[im], diffusion[i], hm, a, b);
+                lower_[i] =  a/w;
+                diag_[i]  = -b/w;
+            }
+            if (co < n-1) {
+                const Size ip = i2_[i];
+                interfaceFlux(drift[i], drift[ip],
+                              diffusion[i], diffusion[ip], hp, a, b);
+                diag_[i]  -= a/w;
+                upper_[i]  = b/w;
+            }
+        }
+    }
+}
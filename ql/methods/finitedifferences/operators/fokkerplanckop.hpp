@@ -0,0 +1,56 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fokkerplanckop.hpp
+    \brief one-dimensional Fokker-Planck operator
+*/
+
+#ifndef quantlib_fokker_planck_op_hpp
+#define quantlib_fokker_planck_op_hpp
+
+#include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+
+namespace QuantLib {
+
+    //! one-dimensional Fokker-Planck operator
+    /*! Finite-volume discretization of
+        \f[
+            - \frac{\partial}{\partial x} \left[ \mu(x) \psi \right]
+            + \frac{\partial^2}{\partial x^2} \left[ D(x) \psi \right]
+        \f]
+        along the given direction, with zero flux through the
+        boundaries. The cells are centered on the grid points and
+        their sizes are the trapezoidal weights; therefore, the
+        operator preserves the integral of the density exactly.
+
+        The convective flux between two points is centered unless
+        this would make the scheme non-monotone, in which case it is
+        upwinded; this keeps the density positive where diffusion
+        vanishes, e.g., at zero variance.
+
+        Drift and diffusion are given for each point of the layout.
+    */
+    class FokkerPlanckOp : public TripleBandLinearOp {
+      public:
+        FokkerPlanckOp(Size direction,
+                       const boost::shared_ptr<FdmMesher>& mesher,
+                       const Array& drift,
+                       const Array& diffusion);
+    };
+}
+
+#endif
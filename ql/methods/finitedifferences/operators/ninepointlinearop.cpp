@@ -71,7 +71,8 @@ namespace QuantLib {
     }
 
     NinePointLinearOp::NinePointLinearOp(const NinePointLinearOp& m)
-    : i00_(new Size[m.mesher_->layout()->size()]),
+    : d0_(m.d0_), d1_(m.d1_),
+      i00_(new Size[m.mesher_->layout()->size()]),
       i10_(new Size[m.mesher_->layout()->size()]),
       i20_(new Size[m.mesher_->layout()->size()]),
       i01_(new Size[m.mesher_->layout()->size()]),
@@ -132,7 +133,9 @@ namespace QuantLib {
         const {
 
         const boost::shared_ptr<FdmLinearOpLayout> index=mesher_->layout();
-        QL_REQUIRE(u.size() == index->size(),"inconsistent length of r "
+        const Size n = index->size();
+        QL_REQUIRE(!u.empty() && u.size() % n == 0,
+                   "inconsistent length of r "
                     << u.size() << " vs " << index->size());
 
         Array retVal(u.size());
@@ -144,16 +147,65 @@ namespace QuantLib {
         const Size *i10(i10_.get()),                   *i12(i12_.get());
         const Size *i20(i20_.get()), *i21(i21_.get()), *i22(i22_.get());
 
-        for (Size i=0; i < retVal.size(); ++i) {
-            retVal[i] =   a00[i]*u[i00[i]]
-                        + a01[i]*u[i01[i]]
-                        + a02[i]*u[i02[i]]
-                        + a10[i]*u[i10[i]]
-                        + a11[i]*u[i]
-                        + a12[i]*u[i12[i]]
-                        + a20[i]*u[i20[i]]
-                        + a21[i]*u[i21[i]]
-                        + a22[i]*u[i22[i]];
+        // the neighbours of an interior point are at fixed offsets;
+        // the gathered indices are only needed on the boundaries,
+        // where the grid is reflected.
+        const std::vector<Size>& dim = index->dim();
+        const std::vector<Size>& spacing = index->spacing();
+        const Size s0 = spacing[d0_], s1 = spacing[d1_];
+
+        // the grid is traversed in memory order by blocks over which
+        // the coordinate along the direction with the larger spacing
+        // is constant; within a block, the coordinate along the other
+        // direction only changes every sIn points.
+        const Size dIn  = (s0 < s1) ? d0_ : d1_;
+        const Size dOut = (s0 < s1) ? d1_ : d0_;
+        const Size sIn = spacing[dIn], nIn = dim[dIn];
+        const Size sOut = spacing[dOut], nOut = dim[dOut];
+        const Size blockSize = sIn*nIn, nBlocks = n/blockSize;
+
+        // u might contain several vectors stacked one after the other
+        const Size nRhs = u.size()/n;
+        #if defined(_OPENMP)
+        #pragma omp parallel for if (u.size() > 10000)
+        #endif
+        for (Integer b=0; b < Integer(nBlocks); ++b) {
+            const Size cOut = (b*blockSize/sOut)%nOut;
+            const bool interiorBlock = (cOut > 0 && cOut < nOut-1);
+
+            for (Size c=0; c < nIn; ++c) {
+                const bool interior = interiorBlock && c > 0 && c < nIn-1;
+                const Size first = b*blockSize + c*sIn;
+
+                for (Size i=first; i < first+sIn; ++i) {
+                    if (interior) {
+                        for (Size k=0, s=i; k < nRhs; ++k, s+=n) {
+                            retVal[s] =   a00[i]*u[s-s0-s1]
+                                        + a01[i]*u[s-s0]
+                                        + a02[i]*u[s-s0+s1]
+                                        + a10[i]*u[s-s1]
+                                        + a11[i]*u[s]
+                                        + a12[i]*u[s+s1]
+                                        + a20[i]*u[s+s0-s1]
+                                        + a21[i]*u[s+s0]
+                                        + a22[i]*u[s+s0+s1];
+                        }
+                    }
+                    else {
+                        for (Size k=0, s=0; k < nRhs; ++k, s+=n) {
+                            retVal[s+i] =   a00[i]*u[s+i00[i]]
+                                          + a01[i]*u[s+i01[i]]
+                                          + a02[i]*u[s+i02[i]]
+                                          + a10[i]*u[s+i10[i]]
+                                          + a11[i]*u[s+i]
+                                          + a12[i]*u[s+i12[i]]
+                                          + a20[i]*u[s+i20[i]]
+                                          + a21[i]*u[s+i21[i]]
+                                          + a22[i]*u[s+i22[i]];
+                        }
+                    }
+                }
+            }
         }
         return retVal;
     }
@@ -180,6 +232,29 @@ namespace QuantLib {
     }
 #endif
 
+    Disposable<CSRMatrix> NinePointLinearOp::toCSRMatrix() const {
+        const Size n = mesher_->layout()->size();
+
+        std::vector<Size> rows(9*n), columns(9*n);
+        std::vector<Real> values(9*n);
+        for (Size i=0; i < n; ++i) {
+            const Size k = 9*i;
+            std::fill(rows.begin()+k, rows.begin()+k+9, i);
+            columns[k  ] = i00_[i]; values[k  ] = a00_[i];
+            columns[k+1] = i01_[i]; values[k+1] = a01_[i];
+            columns[k+2] = i02_[i]; values[k+2] = a02_[i];
+            columns[k+3] = i10_[i]; values[k+3] = a10_[i];
+            columns[k+4] = i;       values[k+4] = a11_[i];
+            columns[k+5] = i12_[i]; values[k+5] = a12_[i];
+            columns[k+6] = i20_[i]; values[k+6] = a20_[i];
+            columns[k+7] = i21_[i]; values[k+7] = a21_[i];
+            columns[k+8] = i22_[i]; values[k+8] = a22_[i];
+        }
+
+        CSRMatrix retVal(n, n, rows, columns, values);
+        return retVal;
+    }
+
 
     Disposable<NinePointLinearOp>
         NinePointLinearOp::mult(const Array & u) const {
@@ -199,6 +274,28 @@ namespace QuantLib {
         return retVal;
     }
 
+    Disposable<NinePointLinearOp>
+        NinePointLinearOp::multR(const Array & u) const {
+
+        NinePointLinearOp retVal(d0_, d1_, mesher_);
+        const Size size = mesher_->layout()->size();
+        QL_REQUIRE(u.size() == size, "inconsistent size of u");
+
+        for (Size i=0; i < size; ++i) {
+            retVal.a11_[i]=a11_[i]*u[i];
+            retVal.a00_[i]=a00_[i]*u[i00_[i]];
+            retVal.a01_[i]=a01_[i]*u[i01_[i]];
+            retVal.a02_[i]=a02_[i]*u[i02_[i]];
+            retVal.a10_[i]=a10_[i]*u[i10_[i]];
+            retVal.a20_[i]=a20_[i]*u[i20_[i]];
+            retVal.a21_[i]=a21_[i]*u[i21_[i]];
+            retVal.a12_[i]=a12_[i]*u[i12_[i]];
+            retVal.a22_[i]=a22_[i]*u[i22_[i]];
+        }
+
+        return retVal;
+    }
+
     void NinePointLinearOp::swap(NinePointLinearOp& m) {
         std::swap(d0_, m.d0_);
         std::swap(d1_, m.d1_);
@@ -43,14 +43,18 @@ namespace QuantLib {
         NinePointLinearOp& operator=(const NinePointLinearOp& m);
         NinePointLinearOp& operator=(const Disposable<NinePointLinearOp>& m);
 
+        //! r can also hold several stacked vectors, see TripleBandLinearOp
         Disposable<Array> apply(const Array& r) const;
         Disposable<NinePointLinearOp> mult(const Array& u) const;
+        //! multiplication from the right, i.e., with the columns
+        Disposable<NinePointLinearOp> multR(const Array& u) const;
 
         void swap(NinePointLinearOp& m);
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<SparseMatrix> toMatrix() const;
 #endif
+        Disposable<CSRMatrix> toCSRMatrix() const;
 
       protected:
         NinePointLinearOp() {}
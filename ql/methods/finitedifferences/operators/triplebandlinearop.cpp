@@ -222,7 +222,9 @@ namespace QuantLib {
     Disposable<Array> TripleBandLinearOp::apply(const Array& r) const {
         const boost::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
 
-        QL_REQUIRE(r.size() == index->size(), "inconsistent length of r");
+        const Size n = index->size();
+        QL_REQUIRE(!r.empty() && r.size() % n == 0,
+                   "inconsistent length of r");
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
@@ -230,9 +232,17 @@ namespace QuantLib {
         const Size* i0ptr = i0_.get();
         const Size* i2ptr = i2_.get();
 
+        // r might contain several vectors stacked one after the other
+        const Size nRhs = r.size()/n;
         array_type retVal(r.size());
-        for (Size i=0; i < index->size(); ++i) {
-            retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
+        #if defined(_OPENMP)
+        #pragma omp parallel for if (r.size() > 10000)
+        #endif
+        for (Integer i=0; i < Integer(n); ++i) {
+            for (Size k=0, s=0; k < nRhs; ++k, s+=n) {
+                retVal[s+i] = r[s+i0ptr[i]]*lptr[i] + r[s+i]*dptr[i]
+                            + r[s+i2ptr[i]]*uptr[i];
+            }
         }
 
         return retVal;
@@ -254,11 +264,29 @@ namespace QuantLib {
     }
 #endif
 
+    Disposable<CSRMatrix> TripleBandLinearOp::toCSRMatrix() const {
+        const Size n = mesher_->layout()->size();
+
+        std::vector<Size> rows(3*n), columns(3*n);
+        std::vector<Real> values(3*n);
+        for (Size i=0; i < n; ++i) {
+            rows[3*i] = rows[3*i+1] = rows[3*i+2] = i;
+            columns[3*i] = i0_[i]; values[3*i] = lower_[i];
+            columns[3*i+1] = i;    values[3*i+1] = diag_[i];
+            columns[3*i+2] = i2_[i]; values[3*i+2] = upper_[i];
+        }
+
+        CSRMatrix retVal(n, n, rows, columns, values);
+        return retVal;
+    }
+
 
     Disposable<Array>
     TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b) const {
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
-        QL_REQUIRE(r.size() == layout->size(), "inconsistent size of rhs");
+        const Size n = layout->size();
+        QL_REQUIRE(!r.empty() && r.size() % n == 0,
+                   "inconsistent size of rhs");
 
 #ifdef QL_EXTRA_SAFETY_CHECKS
         for (FdmLinearOpIterator iter = layout->begin();
@@ -271,35 +299,66 @@ namespace QuantLib {
         }
 #endif
 
-        Array retVal(r.size()), tmp(r.size());
+        Array retVal(r.size()), tmp(n), bet(n);
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
 
-        // Thomson algorithm to solve a tridiagonal system.
-        // Example code taken from Tridiagonalopertor and
-        // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
-
-        for (Size j=1; j<=layout->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
+        // the lines along direction_ are contiguous in the reverse
+        // index and, since the band is cut at their ends, they are
+        // independent tridiagonal systems. Solving them one by one
+        // gives the same results as a sweep over the whole grid
+        // and allows to split them among threads.
+        // If r contains several vectors stacked one after the other,
+        // the elimination coefficients of each line are calculated
+        // once and used for all of them.
+        const Size lineLength = layout->dim()[direction_];
+        const Integer nLines = n/lineLength;
+        const Size nRhs = r.size()/n;
+        Size failures = 0;
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for reduction(+:failures) if (r.size() > 10000)
+        #endif
+        for (Integer l=0; l < nLines; ++l) {
+            const Size offset = l*lineLength, end = offset + lineLength;
+
+            // Thomson algorithm to solve a tridiagonal system.
+            // Example code taken from Tridiagonalopertor and
+            // changed to fit for the triple band operator.
+            Size rim1 = reverseIndex_[offset];
+            bet[offset] = 1.0/(a*dptr[rim1]+b);
+            if (bet[offset] == 0.0)
+                ++failures;
+
+            for (Size j=offset+1; j<end; j++){
+                const Size ri = reverseIndex_[j];
+                tmp[j] = a*uptr[rim1]*bet[j-1];
+
+                bet[j] = b+a*(dptr[ri]-tmp[j]*lptr[ri]);
+                if (bet[j] == 0.0)
+                    ++failures;
+                bet[j] = 1.0/bet[j];
+                rim1 = ri;
+            }
 
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
+            for (Size k=0, s=0; k < nRhs; ++k, s+=n) {
+                rim1 = reverseIndex_[offset];
+                retVal[s+rim1] = r[s+rim1]*bet[offset];
 
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+                for (Size j=offset+1; j<end; j++){
+                    const Size ri = reverseIndex_[j];
+                    retVal[s+ri] =
+                        (r[s+ri]-a*lptr[ri]*retVal[s+rim1])*bet[j];
+                    rim1 = ri;
+                }
+                for (Size j=end-1; j>offset; --j)
+                    retVal[s+reverseIndex_[j-1]] -=
+                        tmp[j]*retVal[s+reverseIndex_[j]];
+            }
         }
-        // cannot be j>=0 with Size j
-        for (Size j=layout->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
+        QL_ENSURE(failures == 0, "division by zero");
 
         return retVal;
     }
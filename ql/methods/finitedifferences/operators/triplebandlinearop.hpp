@@ -47,6 +47,10 @@ namespace QuantLib {
         TripleBandLinearOp& operator=(const TripleBandLinearOp& m);
         TripleBandLinearOp& operator=(const Disposable<TripleBandLinearOp>& m);
 
+        /*! r can also hold several vectors on the layout of the
+            mesher stacked one after the other, in which case the
+            operator is applied to (or solved for) each of them.
+        */
         Disposable<Array> apply(const Array& r) const;
         Disposable<Array> solve_splitting(const Array& r, Real a,
                                           Real b = 1.0) const;
@@ -64,6 +68,7 @@ namespace QuantLib {
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<SparseMatrix> toMatrix() const;
 #endif
+        Disposable<CSRMatrix> toCSRMatrix() const;
 
       protected:
         TripleBandLinearOp() {}
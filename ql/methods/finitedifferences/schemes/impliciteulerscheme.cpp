@@ -20,6 +20,8 @@
 */
 
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/gmres.hpp>
+#include <ql/math/matrixutilities/csrilupreconditioner.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 
 #include <boost/bind.hpp>
@@ -30,9 +32,15 @@ namespace QuantLib {
     ImplicitEulerScheme::ImplicitEulerScheme(
         const boost::shared_ptr<FdmLinearOpComposite>& map,
         const std::vector<boost::shared_ptr<FdmDirichletBoundary> >& bcSet,
-        Real relTol)
+        Real relTol,
+        SolverType solverType,
+        Size maxIterations,
+        Size restart)
     : dt_    (Null<Real>()),
       relTol_(relTol),
+      solverType_(solverType),
+      maxIterations_(maxIterations),
+      restart_(restart),
       map_   (map),
       bcSet_ (bcSet) {
     }
@@ -45,14 +53,55 @@ namespace QuantLib {
         QL_REQUIRE(t-dt_ > -1e-8, "a step towards negative time given");
         map_->setTime(std::max(0.0, t-dt_), t);
 
-        a = BiCGstab(
-                boost::function<Disposable<Array>(const Array&)>(
-                    boost::bind(&ImplicitEulerScheme::apply, this, _1)), 
-                10*a.size(), relTol_,
-                boost::function<Disposable<Array>(const Array&)>(
-                    boost::bind(&FdmLinearOpComposite::preconditioner, 
-                                map_, _1, -dt_))
-            ).solve(a).x;
+        switch (solverType_) {
+          case BiCGstabType:
+            {
+                const Size maxIterations = (maxIterations_ == Null<Size>())
+                                         ? 10*a.size() : maxIterations_;
+                const boost::function<Disposable<Array>(const Array&)>
+                    applyF(boost::bind(&ImplicitEulerScheme::apply,
+                                       this, _1));
+                const boost::function<Disposable<Array>(const Array&)>
+                    preconditioner(boost::bind(
+                                       &FdmLinearOpComposite::preconditioner,
+                                       map_, _1, -dt_));
+                a = BiCGstab(applyF, maxIterations, relTol_,
+                             preconditioner).solve(a).x;
+            }
+            break;
+          case GMRESType:
+            {
+                // 1 - dt*L is assembled once the operator time is set
+                const CSRMatrix l = map_->toCSRMatrix();
+                const Size n = l.rows();
+                QL_REQUIRE(n > 0 && a.size() % n == 0,
+                           "array size (" << a.size() << ") is not a "
+                           "multiple of the operator size (" << n << ")");
+                const CSRMatrix m = CSRMatrix(Array(n, 1.0)) + (-dt_)*l;
+                const CSRILUPreconditioner ilu(m);
+                const boost::function<Disposable<Array>(const Array&)>
+                    applyF(boost::bind(&CSRMatrix::apply, &m, _1));
+                const boost::function<Disposable<Array>(const Array&)>
+                    preconditioner(boost::bind(&CSRILUPreconditioner::apply,
+                                               &ilu, _1));
+                const Size maxIterations = (maxIterations_ == Null<Size>())
+                                         ? 10*n : maxIterations_;
+                const GMRES gmres(applyF, maxIterations, relTol_,
+                                  preconditioner);
+
+                // stacked grid vectors are solved one at a time
+                Array b(n);
+                for (Size offset=0; offset < a.size(); offset+=n) {
+                    std::copy(a.begin()+offset, a.begin()+offset+n,
+                              b.begin());
+                    const Array x = gmres.solveWithRestart(restart_, b, b).x;
+                    std::copy(x.begin(), x.end(), a.begin()+offset);
+                }
+            }
+            break;
+          default:
+            QL_FAIL("unknown solver type");
+        }
         
         for (Size i=0; i<bcSet_.size(); i++)
             bcSet_[i]->applyAfterApplying(a);
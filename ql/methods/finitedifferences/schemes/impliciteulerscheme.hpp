@@ -29,11 +29,28 @@
 #include <ql/methods/finitedifferences/operatortraits.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmdirichletboundary.hpp>
+#include <ql/utilities/null.hpp>
 
 namespace QuantLib {
 
+    //! implicit Euler scheme
+    /*! With BiCGstab, the linear system of each step is preconditioned
+        by the splitting of the operator.  With GMRES, the operator is
+        assembled as a CSR matrix whenever the step time is set and
+        the system is preconditioned by its ILU(0) factorization; in
+        this case, the operator must implement toCSRMatrix().  Arrays
+        holding several stacked grid vectors (as rolled back by
+        FdmMultiPayoffSolver) are solved one vector at a time against
+        the same factorization.
+
+        If not given, the maximum number of iterations of the linear
+        solver is ten times the size of the system; GMRES is restarted
+        after the given number of iterations.
+    */
     class ImplicitEulerScheme {
       public:
+        enum SolverType { BiCGstabType, GMRESType };
+
         // typedefs
         typedef OperatorTraits<FdmLinearOp> traits;
         typedef traits::operator_type operator_type;
@@ -46,7 +63,10 @@ namespace QuantLib {
             const boost::shared_ptr<FdmLinearOpComposite>& map,
             const std::vector<boost::shared_ptr<FdmDirichletBoundary> >& bc_set
                 = std::vector<boost::shared_ptr<FdmDirichletBoundary> >(),
-            Real relTol = 1e-8);
+            Real relTol = 1e-8,
+            SolverType solverType = BiCGstabType,
+            Size maxIterations = Null<Size>(),
+            Size restart = 50);
 
         void step(array_type& a, Time t);
         void setStep(Time dt);
@@ -56,6 +76,8 @@ namespace QuantLib {
           
         Time dt_;
         const Real relTol_;
+        const SolverType solverType_;
+        const Size maxIterations_, restart_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const std::vector<boost::shared_ptr<FdmDirichletBoundary> > bcSet_;
     };
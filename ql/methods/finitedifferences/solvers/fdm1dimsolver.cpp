@@ -26,13 +26,16 @@
 #include <ql/methods/finitedifferences/solvers/fdm1dimsolver.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmmultisnapshotcondition.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
     Fdm1DimSolver::Fdm1DimSolver(
                              const FdmSolverDesc& solverDesc,
                              const FdmSchemeDesc& schemeDesc,
-                             const boost::shared_ptr<FdmLinearOpComposite>& op)
+                             const boost::shared_ptr<FdmLinearOpComposite>& op,
+                             const std::vector<Time>& snapshotTimes)
     : solverDesc_(solverDesc),
       schemeDesc_(schemeDesc),
       op_(op),
@@ -43,6 +46,7 @@ namespace QuantLib {
                     : solverDesc.condition->stoppingTimes().front()))),
       conditions_(FdmStepConditionComposite::joinConditions(thetaCondition_,
                                                          solverDesc.condition)),
+      snapshotTimes_(snapshotTimes),
       x_            (solverDesc.mesher->layout()->size()),
       initialValues_(solverDesc.mesher->layout()->size()),
       resultValues_ (solverDesc.mesher->layout()->size()) {
@@ -58,6 +62,37 @@ namespace QuantLib {
                                                          solverDesc.maturity);
             x_[iter.index()] = mesher->location(iter, 0);
         }
+
+        if (!snapshotTimes_.empty()) {
+            std::sort(snapshotTimes_.begin(), snapshotTimes_.end());
+            snapshotTimes_.erase(std::unique(snapshotTimes_.begin(),
+                                             snapshotTimes_.end()),
+                                 snapshotTimes_.end());
+            QL_REQUIRE(snapshotTimes_.front() >= 0.0
+                       && snapshotTimes_.back() <= solverDesc.maturity,
+                       "snapshot times must lie between 0 and maturity");
+
+            const Time dt = 0.99*std::min(1.0/365.0, 0.5*solverDesc.maturity);
+            std::vector<Time> thetaTimes(snapshotTimes_.size());
+            for (Size i=0; i < snapshotTimes_.size(); ++i) {
+                const Time t = snapshotTimes_[i];
+                thetaTimes[i] = (t + dt <= solverDesc.maturity) ? t+dt : t-dt;
+            }
+            std::vector<Time> times(snapshotTimes_);
+            times.insert(times.end(), thetaTimes.begin(), thetaTimes.end());
+            snapshots_ = boost::shared_ptr<FdmMultiSnapshotCondition>(
+                                       new FdmMultiSnapshotCondition(times));
+
+            const std::vector<Time>& allTimes = snapshots_->times();
+            for (Size i=0; i < snapshotTimes_.size(); ++i) {
+                snapshotRows_.push_back(
+                    std::lower_bound(allTimes.begin(), allTimes.end(),
+                                     snapshotTimes_[i]) - allTimes.begin());
+                thetaRows_.push_back(
+                    std::lower_bound(allTimes.begin(), allTimes.end(),
+                                     thetaTimes[i]) - allTimes.begin());
+            }
+        }
     }
 
 
@@ -65,14 +100,30 @@ namespace QuantLib {
         Array rhs(initialValues_.size());
         std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
 
-        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
-            .rollback(rhs, solverDesc_.maturity, 0.0,
-                      solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        FdmBackwardSolver solver(op_, solverDesc_.bcSet,
+                                 conditions_, schemeDesc_);
+        if (snapshots_)
+            solver.rollback(rhs, solverDesc_.maturity, 0.0,
+                            solverDesc_.timeSteps, solverDesc_.dampingSteps,
+                            snapshots_);
+        else
+            solver.rollback(rhs, solverDesc_.maturity, 0.0,
+                            solverDesc_.timeSteps, solverDesc_.dampingSteps);
 
         std::copy(rhs.begin(), rhs.end(), resultValues_.begin());
         interpolation_ = boost::shared_ptr<CubicInterpolation>(new
             MonotonicCubicNaturalSpline(x_.begin(), x_.end(),
                                         resultValues_.begin()));
+
+        snapshotInterpolations_.clear();
+        if (snapshots_) {
+            const Matrix& values = snapshots_->values();
+            for (Size i=0; i < values.rows(); ++i)
+                snapshotInterpolations_.push_back(
+                    boost::shared_ptr<CubicInterpolation>(new
+                        MonotonicCubicNaturalSpline(x_.begin(), x_.end(),
+                                                    values.row_begin(i))));
+        }
     }
 
     Real Fdm1DimSolver::interpolateAt(Real x) const {
@@ -105,4 +156,72 @@ namespace QuantLib {
         calculate();
         return interpolation_->secondDerivative(x);
     }
+
+    const std::vector<Time>& Fdm1DimSolver::snapshotTimes() const {
+        return snapshotTimes_;
+    }
+
+    Disposable<Matrix> Fdm1DimSolver::valueSurface(
+                                          const std::vector<Real>& x) const {
+        QL_REQUIRE(snapshots_, "no snapshot times given");
+        calculate();
+
+        Matrix result(snapshotTimes_.size(), x.size());
+        for (Size i=0; i < snapshotTimes_.size(); ++i) {
+            const CubicInterpolation& f
+                = *snapshotInterpolations_[snapshotRows_[i]];
+            for (Size j=0; j < x.size(); ++j)
+                result[i][j] = f(x[j]);
+        }
+        return result;
+    }
+
+    Disposable<Matrix> Fdm1DimSolver::derivativeXSurface(
+                                          const std::vector<Real>& x) const {
+        QL_REQUIRE(snapshots_, "no snapshot times given");
+        calculate();
+
+        Matrix result(snapshotTimes_.size(), x.size());
+        for (Size i=0; i < snapshotTimes_.size(); ++i) {
+            const CubicInterpolation& f
+                = *snapshotInterpolations_[snapshotRows_[i]];
+            for (Size j=0; j < x.size(); ++j)
+                result[i][j] = f.derivative(x[j]);
+        }
+        return result;
+    }
+
+    Disposable<Matrix> Fdm1DimSolver::derivativeXXSurface(
+                                          const std::vector<Real>& x) const {
+        QL_REQUIRE(snapshots_, "no snapshot times given");
+        calculate();
+
+        Matrix result(snapshotTimes_.size(), x.size());
+        for (Size i=0; i < snapshotTimes_.size(); ++i) {
+            const CubicInterpolation& f
+                = *snapshotInterpolations_[snapshotRows_[i]];
+            for (Size j=0; j < x.size(); ++j)
+                result[i][j] = f.secondDerivative(x[j]);
+        }
+        return result;
+    }
+
+    Disposable<Matrix> Fdm1DimSolver::thetaSurface(
+                                          const std::vector<Real>& x) const {
+        QL_REQUIRE(snapshots_, "no snapshot times given");
+        calculate();
+
+        const std::vector<Time>& times = snapshots_->times();
+        Matrix result(snapshotTimes_.size(), x.size());
+        for (Size i=0; i < snapshotTimes_.size(); ++i) {
+            const CubicInterpolation& f
+                = *snapshotInterpolations_[snapshotRows_[i]];
+            const CubicInterpolation& g
+                = *snapshotInterpolations_[thetaRows_[i]];
+            const Time dt = times[thetaRows_[i]] - times[snapshotRows_[i]];
+            for (Size j=0; j < x.size(); ++j)
+                result[i][j] = (g(x[j]) - f(x[j]))/dt;
+        }
+        return result;
+    }
 }
@@ -34,12 +34,22 @@ namespace QuantLib {
 
     class CubicInterpolation;
     class FdmSnapshotCondition;
+    class FdmMultiSnapshotCondition;
 
     class Fdm1DimSolver : public LazyObject {
       public:
+        /*! if snapshot times are given, the solution is also
+            recorded at each of them, together with a second
+            snapshot shortly after (or before, close to maturity)
+            used to calculate theta. The surfaces of value and
+            derivatives over time and space are then available
+            from the same rollback.
+        */
         Fdm1DimSolver(const FdmSolverDesc& solverDesc,
                       const FdmSchemeDesc& schemeDesc,
-                      const boost::shared_ptr<FdmLinearOpComposite>& op);
+                      const boost::shared_ptr<FdmLinearOpComposite>& op,
+                      const std::vector<Time>& snapshotTimes
+                                                     = std::vector<Time>());
 
         Real interpolateAt(Real x) const;
         Real thetaAt(Real x) const;
@@ -47,6 +57,22 @@ namespace QuantLib {
         Real derivativeX(Real x) const;
         Real derivativeXX(Real x) const;
 
+        //! sorted snapshot times
+        const std::vector<Time>& snapshotTimes() const;
+
+        /*! \name Surfaces
+            rows correspond to the snapshot times and columns to the
+            given locations.
+        */
+        //@{
+        Disposable<Matrix> valueSurface(const std::vector<Real>& x) const;
+        Disposable<Matrix> derivativeXSurface(
+                                        const std::vector<Real>& x) const;
+        Disposable<Matrix> derivativeXXSurface(
+                                        const std::vector<Real>& x) const;
+        Disposable<Matrix> thetaSurface(const std::vector<Real>& x) const;
+        //@}
+
       protected:
         void performCalculations() const;
 
@@ -58,9 +84,17 @@ namespace QuantLib {
         const boost::shared_ptr<FdmSnapshotCondition> thetaCondition_;
         const boost::shared_ptr<FdmStepConditionComposite> conditions_;
 
+        std::vector<Time> snapshotTimes_;
+        // rows of the snapshots at the snapshot times and of the
+        // ones used for theta
+        std::vector<Size> snapshotRows_, thetaRows_;
+        boost::shared_ptr<FdmMultiSnapshotCondition> snapshots_;
+
         std::vector<Real> x_, initialValues_;
         mutable Array resultValues_;
         mutable boost::shared_ptr<CubicInterpolation> interpolation_;
+        mutable std::vector<boost::shared_ptr<CubicInterpolation> >
+                                                     snapshotInterpolations_;
     };
 }
 
@@ -29,6 +29,17 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // first of the n grid points centered around x
+        Size patchBegin(const std::vector<Real>& grid, Real x, Size n) {
+            const Size i = std::upper_bound(grid.begin(), grid.end(), x)
+                         - grid.begin();
+            return std::min(grid.size()-n, i - std::min(i, n/2));
+        }
+
+    }
+
     Fdm2DimSolver::Fdm2DimSolver(
                              const FdmSolverDesc& solverDesc,
                              const FdmSchemeDesc& schemeDesc,
@@ -45,7 +56,14 @@ namespace QuantLib {
                                                          solverDesc.condition)),
       initialValues_(solverDesc.mesher->layout()->size()),
       resultValues_ (solverDesc.mesher->layout()->dim()[1],
-                     solverDesc.mesher->layout()->dim()[0]) {
+                     solverDesc.mesher->layout()->dim()[0]),
+      xBegin_(0), yBegin_(0) {
+
+        QL_REQUIRE(solverDesc.interpolationPoints == 0
+                   || solverDesc.interpolationPoints >= 4,
+                   "number of interpolation points ("
+                   << solverDesc.interpolationPoints
+                   << ") must be zero or at least 4");
 
         const boost::shared_ptr<FdmMesher> mesher = solverDesc.mesher;
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
@@ -79,15 +97,49 @@ namespace QuantLib {
                       solverDesc_.timeSteps, solverDesc_.dampingSteps);
 
         std::copy(rhs.begin(), rhs.end(), resultValues_.begin());
-        interpolation_ = boost::shared_ptr<BicubicSpline> (
-            new BicubicSpline(x_.begin(), x_.end(),
-                              y_.begin(), y_.end(),
-                              resultValues_));
+        if (solverDesc_.interpolationPoints == 0) {
+            interpolation_ = boost::shared_ptr<BicubicSpline> (
+                new BicubicSpline(x_.begin(), x_.end(),
+                                  y_.begin(), y_.end(),
+                                  resultValues_));
+        }
+        else {
+            // built on demand around the evaluation point
+            interpolation_.reset();
+        }
     }
 
-    Real Fdm2DimSolver::interpolateAt(Real x, Real y) const {
+    const BicubicSpline& Fdm2DimSolver::interpolation(Real x, Real y) const {
         calculate();
-        return interpolation_->operator()(x, y);
+        if (solverDesc_.interpolationPoints == 0)
+            return *interpolation_;
+
+        const Size nx = std::min(solverDesc_.interpolationPoints, x_.size());
+        const Size ny = std::min(solverDesc_.interpolationPoints, y_.size());
+        const Size xBegin = patchBegin(x_, x, nx);
+        const Size yBegin = patchBegin(y_, y, ny);
+
+        if (!interpolation_ || xBegin != xBegin_ || yBegin != yBegin_) {
+            xBegin_ = xBegin;
+            yBegin_ = yBegin;
+            xPatch_.assign(x_.begin()+xBegin, x_.begin()+xBegin+nx);
+            yPatch_.assign(y_.begin()+yBegin, y_.begin()+yBegin+ny);
+            patchValues_ = Matrix(ny, nx);
+            for (Size j=0; j < ny; ++j)
+                std::copy(resultValues_.row_begin(yBegin+j)+xBegin,
+                          resultValues_.row_begin(yBegin+j)+xBegin+nx,
+                          patchValues_.row_begin(j));
+
+            interpolation_ = boost::shared_ptr<BicubicSpline> (
+                new BicubicSpline(xPatch_.begin(), xPatch_.end(),
+                                  yPatch_.begin(), yPatch_.end(),
+                                  patchValues_));
+        }
+        return *interpolation_;
+    }
+
+    Real Fdm2DimSolver::interpolateAt(Real x, Real y) const {
+        return interpolation(x, y)(x, y);
     }
 
     Real Fdm2DimSolver::thetaAt(Real x, Real y) const {
@@ -95,40 +147,56 @@ namespace QuantLib {
                    "stopping time at zero-> can't calculate theta");
 
         calculate();
-        Matrix thetaValues(resultValues_.rows(), resultValues_.columns());
-
         const Array& rhs = thetaCondition_->getValues();
-        std::copy(rhs.begin(), rhs.end(), thetaValues.begin());
 
-        return (BicubicSpline(x_.begin(), x_.end(), y_.begin(), y_.end(),
-                              thetaValues)(x, y) - interpolateAt(x, y))
+        Real thetaValue;
+        if (solverDesc_.interpolationPoints == 0) {
+            Matrix thetaValues(resultValues_.rows(), resultValues_.columns());
+            std::copy(rhs.begin(), rhs.end(), thetaValues.begin());
+
+            thetaValue = BicubicSpline(x_.begin(), x_.end(),
+                                       y_.begin(), y_.end(),
+                                       thetaValues)(x, y);
+        }
+        else {
+            // same patch as the one used for the value
+            interpolation(x, y);
+
+            Matrix thetaValues(yPatch_.size(), xPatch_.size());
+            for (Size j=0; j < yPatch_.size(); ++j)
+                std::copy(rhs.begin()+(yBegin_+j)*x_.size()+xBegin_,
+                          rhs.begin()+(yBegin_+j)*x_.size()+xBegin_
+                                                        +xPatch_.size(),
+                          thetaValues.row_begin(j));
+
+            thetaValue = BicubicSpline(xPatch_.begin(), xPatch_.end(),
+                                       yPatch_.begin(), yPatch_.end(),
+                                       thetaValues)(x, y);
+        }
+
+        return (thetaValue - interpolateAt(x, y))
               / thetaCondition_->getTime();
     }
 
 
     Real Fdm2DimSolver::derivativeX(Real x, Real y) const {
-        calculate();
-        return interpolation_->derivativeX(x, y);
+        return interpolation(x, y).derivativeX(x, y);
     }
 
     Real Fdm2DimSolver::derivativeY(Real x, Real y) const {
-        calculate();
-        return interpolation_->derivativeY(x, y);
+        return interpolation(x, y).derivativeY(x, y);
     }
 
     Real Fdm2DimSolver::derivativeXX(Real x, Real y) const {
-        calculate();
-        return interpolation_->secondDerivativeX(x, y);
+        return interpolation(x, y).secondDerivativeX(x, y);
     }
 
     Real Fdm2DimSolver::derivativeYY(Real x, Real y) const {
-        calculate();
-        return interpolation_->secondDerivativeY(x, y);
+        return interpolation(x, y).secondDerivativeY(x, y);
     }
 
     Real Fdm2DimSolver::derivativeXY(Real x, Real y) const {
-        calculate();
-        return interpolation_->derivativeXY(x, y);
+        return interpolation(x, y).derivativeXY(x, y);
     }
 
 }
@@ -61,9 +61,15 @@ namespace QuantLib {
         const boost::shared_ptr<FdmSnapshotCondition> thetaCondition_;
         const boost::shared_ptr<FdmStepConditionComposite> conditions_;
 
+        const BicubicSpline& interpolation(Real x, Real y) const;
+
         std::vector<Real> x_, y_, initialValues_;
         mutable Matrix resultValues_;
         mutable boost::shared_ptr<BicubicSpline> interpolation_;
+        // grid patch interpolated when solverDesc_.interpolationPoints > 0
+        mutable Size xBegin_, yBegin_;
+        mutable std::vector<Real> xPatch_, yPatch_;
+        mutable Matrix patchValues_;
     };
 }
 
@@ -30,6 +30,17 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // first of the n grid points centered around x
+        Size patchBegin(const std::vector<Real>& grid, Real x, Size n) {
+            const Size i = std::upper_bound(grid.begin(), grid.end(), x)
+                         - grid.begin();
+            return std::min(grid.size()-n, i - std::min(i, n/2));
+        }
+
+    }
+
     Fdm3DimSolver::Fdm3DimSolver(
                         const FdmSolverDesc& solverDesc,
                         const FdmSchemeDesc& schemeDesc,
@@ -48,7 +59,13 @@ namespace QuantLib {
       resultValues_ (solverDesc.mesher->layout()->dim()[2],
                      Matrix(solverDesc.mesher->layout()->dim()[1],
                             solverDesc.mesher->layout()->dim()[0])),
-      interpolation_(solverDesc.mesher->layout()->dim()[2]) {
+      xBegin_(0), yBegin_(0), zBegin_(0) {
+
+        QL_REQUIRE(solverDesc.interpolationPoints == 0
+                   || solverDesc.interpolationPoints >= 4,
+                   "number of interpolation points ("
+                   << solverDesc.interpolationPoints
+                   << ") must be zero or at least 4");
 
         const boost::shared_ptr<FdmMesher> mesher = solverDesc.mesher;
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
@@ -89,45 +106,107 @@ namespace QuantLib {
             std::copy(rhs.begin()+i    *y_.size()*x_.size(),
                       rhs.begin()+(i+1)*y_.size()*x_.size(),
                       resultValues_[i].begin());
+        }
 
-            interpolation_[i] = boost::shared_ptr<BicubicSpline> (
-                new BicubicSpline(x_.begin(), x_.end(),
-                                  y_.begin(), y_.end(),
-                                  resultValues_[i]));
+        if (solverDesc_.interpolationPoints == 0) {
+            interpolation_.resize(z_.size());
+            for (Size i=0; i < z_.size(); ++i) {
+                interpolation_[i] = boost::shared_ptr<BicubicSpline> (
+                    new BicubicSpline(x_.begin(), x_.end(),
+                                      y_.begin(), y_.end(),
+                                      resultValues_[i]));
+            }
+        }
+        else {
+            // built on demand around the evaluation point
+            interpolation_.clear();
         }
     }
 
-    Real Fdm3DimSolver::interpolateAt(Real x, Real y, Rate z) const {
+    void Fdm3DimSolver::updateInterpolation(Real x, Real y, Rate z) const {
         calculate();
+        if (solverDesc_.interpolationPoints == 0)
+            return;
+
+        const Size nx = std::min(solverDesc_.interpolationPoints, x_.size());
+        const Size ny = std::min(solverDesc_.interpolationPoints, y_.size());
+        const Size nz = std::min(solverDesc_.interpolationPoints, z_.size());
+        const Size xBegin = patchBegin(x_, x, nx);
+        const Size yBegin = patchBegin(y_, y, ny);
+        const Size zBegin = patchBegin(z_, z, nz);
+
+        if (   interpolation_.empty() || xBegin != xBegin_
+            || yBegin != yBegin_ || zBegin != zBegin_) {
+            xBegin_ = xBegin;
+            yBegin_ = yBegin;
+            zBegin_ = zBegin;
+            xPatch_.assign(x_.begin()+xBegin, x_.begin()+xBegin+nx);
+            yPatch_.assign(y_.begin()+yBegin, y_.begin()+yBegin+ny);
+            zPatch_.assign(z_.begin()+zBegin, z_.begin()+zBegin+nz);
+
+            patchValues_.assign(nz, Matrix(ny, nx));
+            interpolation_.resize(nz);
+            for (Size k=0; k < nz; ++k) {
+                const Matrix& values = resultValues_[zBegin+k];
+                for (Size j=0; j < ny; ++j)
+                    std::copy(values.row_begin(yBegin+j)+xBegin,
+                              values.row_begin(yBegin+j)+xBegin+nx,
+                              patchValues_[k].row_begin(j));
+
+                interpolation_[k] = boost::shared_ptr<BicubicSpline> (
+                    new BicubicSpline(xPatch_.begin(), xPatch_.end(),
+                                      yPatch_.begin(), yPatch_.end(),
+                                      patchValues_[k]));
+            }
+        }
+    }
 
-        Array zArray(z_.size());
-        for (Size i=0; i < z_.size(); ++i) {
+    Real Fdm3DimSolver::interpolateAt(Real x, Real y, Rate z) const {
+        updateInterpolation(x, y, z);
+
+        const std::vector<Real>& zGrid =
+            (solverDesc_.interpolationPoints == 0) ? z_ : zPatch_;
+
+        Array zArray(zGrid.size());
+        for (Size i=0; i < zGrid.size(); ++i) {
             zArray[i] = interpolation_[i]->operator()(x, y);
         }
-        return MonotonicCubicNaturalSpline(z_.begin(), z_.end(),
+        return MonotonicCubicNaturalSpline(zGrid.begin(), zGrid.end(),
                                            zArray.begin())(z);
     }
 
     Real Fdm3DimSolver::thetaAt(Real x, Real y, Rate z) const {
         QL_REQUIRE(conditions_->stoppingTimes().front() > 0.0,
                    "stopping time at zero-> can't calculate theta");
-        calculate();
+        updateInterpolation(x, y, z);
+
+        // the theta values are interpolated on the same patch as
+        // the results, or on the whole grid
+        const bool local = (solverDesc_.interpolationPoints != 0);
+        const std::vector<Real>& xGrid = local ? xPatch_ : x_;
+        const std::vector<Real>& yGrid = local ? yPatch_ : y_;
+        const std::vector<Real>& zGrid = local ? zPatch_ : z_;
+        const Size xBegin = local ? xBegin_ : 0;
+        const Size yBegin = local ? yBegin_ : 0;
+        const Size zBegin = local ? zBegin_ : 0;
 
         const Array& rhs = thetaCondition_->getValues();
-        std::vector<Matrix> thetaValues(z_.size(), Matrix(y_.size(),x_.size()));
-        for (Size i=0; i < z_.size(); ++i) {
-            std::copy(rhs.begin()+i    *y_.size()*x_.size(),
-                      rhs.begin()+(i+1)*y_.size()*x_.size(),
-                      thetaValues[i].begin());
-        }
-
-        Array zArray(z_.size());
-        for (Size i=0; i < z_.size(); ++i) {
-            zArray[i] = BicubicSpline(x_.begin(),x_.end(),
-                                      y_.begin(),y_.end(), thetaValues[i])(x,y);
+        Matrix thetaValues(yGrid.size(), xGrid.size());
+        Array zArray(zGrid.size());
+        for (Size k=0; k < zGrid.size(); ++k) {
+            for (Size j=0; j < yGrid.size(); ++j) {
+                const Size offset = ((zBegin+k)*y_.size() + yBegin+j)
+                                    *x_.size() + xBegin;
+                std::copy(rhs.begin()+offset,
+                          rhs.begin()+offset+xGrid.size(),
+                          thetaValues.row_begin(j));
+            }
+            zArray[k] = BicubicSpline(xGrid.begin(), xGrid.end(),
+                                      yGrid.begin(), yGrid.end(),
+                                      thetaValues)(x, y);
         }
 
-        return (MonotonicCubicNaturalSpline(z_.begin(), z_.end(),
+        return (MonotonicCubicNaturalSpline(zGrid.begin(), zGrid.end(),
                                             zArray.begin())(z)
                 - interpolateAt(x, y, z)) / thetaCondition_->getTime();
     }
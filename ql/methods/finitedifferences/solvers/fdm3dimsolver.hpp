@@ -46,6 +46,8 @@ namespace QuantLib {
         Real thetaAt(Real x, Real y, Rate z) const;
 
       private:
+        void updateInterpolation(Real x, Real y, Rate z) const;
+
         const FdmSolverDesc solverDesc_;
         const FdmSchemeDesc schemeDesc_;
         const boost::shared_ptr<FdmLinearOpComposite> op_;
@@ -56,6 +58,10 @@ namespace QuantLib {
         std::vector<Real> x_, y_, z_, initialValues_;
         mutable std::vector<Matrix> resultValues_;
         mutable std::vector<boost::shared_ptr<BicubicSpline> > interpolation_;
+        // grid patch interpolated when solverDesc_.interpolationPoints > 0
+        mutable Size xBegin_, yBegin_, zBegin_;
+        mutable std::vector<Real> xPatch_, yPatch_, zPatch_;
+        mutable std::vector<Matrix> patchValues_;
     };
 }
 
@@ -31,11 +31,117 @@
 #include <ql/methods/finitedifferences/schemes/expliciteulerscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/modifiedcraigsneydscheme.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmmultisnapshotcondition.hpp>
 
 namespace QuantLib {
-    
-    FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu)
-    : type(aType), theta(aTheta), mu(aMu) { }
+
+    namespace {
+
+        typedef FdmBackwardSolver::array_type array_type;
+
+        template <class Evolver>
+        void adaptiveRollback(Evolver& evolver, array_type& a,
+                              Time from, Time to, Size steps,
+                              const FdmStepConditionComposite& condition,
+                              Real tolerance, Size order) {
+            QL_REQUIRE(from >= to,
+                       "trying to roll back from " << from << " to " << to);
+            QL_REQUIRE(tolerance > 0.0,
+                       "positive tolerance required: " << tolerance);
+
+            // the solution must hit every stopping time, as in
+            // FiniteDifferenceModel
+            const std::vector<Time>& stoppingTimes = condition.stoppingTimes();
+            if (!stoppingTimes.empty() && stoppingTimes.back() == from)
+                condition.applyTo(a, from);
+
+            std::vector<Time> targets;
+            for (Integer j=stoppingTimes.size()-1; j >= 0; --j) {
+                if (to < stoppingTimes[j] && stoppingTimes[j] < from
+                    && (targets.empty() || stoppingTimes[j] < targets.back()))
+                    targets.push_back(stoppingTimes[j]);
+            }
+            targets.push_back(to);
+
+            const Time minStep = (from-to)/(100.0*steps);
+            const Real exponent = 1.0/(order+1.0);
+            Time dt = (from-to)/steps, t = from;
+
+            for (Size k=0; k < targets.size(); ++k) {
+                const Time target = targets[k];
+                while (t - target > std::sqrt(QL_EPSILON)*(from-to)) {
+                    Time h = std::min(dt, t - target);
+                    // avoid leaving a tiny step before the target
+                    if (t - h - target < 0.1*h)
+                        h = t - target;
+                    const Time next = (h == t - target) ? target : t - h;
+
+                    array_type full(a);
+                    evolver.setStep(h);
+                    evolver.step(full, t);
+                    condition.applyTo(full, next);
+
+                    array_type half(a);
+                    evolver.setStep(0.5*h);
+                    evolver.step(half, t);
+                    condition.applyTo(half, t - 0.5*h);
+                    evolver.step(half, t - 0.5*h);
+                    condition.applyTo(half, next);
+
+                    // mixed absolute/relative error: small values
+                    // aren't swamped by the large ones elsewhere
+                    // on the grid
+                    Real error = 0.0;
+                    for (Size i=0; i < a.size(); ++i)
+                        error = std::max(error, std::fabs(half[i]-full[i])
+                                                / (1.0 + std::fabs(half[i])));
+
+                    const Real factor = (error > 0.0)
+                        ? 0.9*std::pow(tolerance/error, exponent)
+                        : 5.0;
+                    if (error <= tolerance || h <= minStep) {
+                        a.swap(half);
+                        t = next;
+                        dt = std::max(h*std::min(factor, 5.0), minStep);
+                    } else {
+                        dt = std::max(h*std::max(factor, 0.2), minStep);
+                    }
+                }
+                t = target;
+            }
+        }
+
+        template <class Evolver>
+        void rollbackImpl(Evolver& evolver, array_type& a,
+                          Time from, Time to, Size steps,
+                          const FdmStepConditionComposite& condition,
+                          Real tolerance, Size order) {
+            if (tolerance == Null<Real>()) {
+                FiniteDifferenceModel<Evolver>
+                             model(evolver, condition.stoppingTimes());
+                model.rollback(a, from, to, steps, condition);
+            } else {
+                adaptiveRollback(evolver, a, from, to, steps,
+                                 condition, tolerance, order);
+            }
+        }
+
+    }
+
+    FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu,
+                                 Real aTolerance,
+                                 ImplicitEulerScheme::SolverType aSolverType)
+    : type(aType), theta(aTheta), mu(aMu), tolerance(aTolerance),
+      solverType(aSolverType) { }
+
+    FdmSchemeDesc FdmSchemeDesc::withTolerance(Real aTolerance) const {
+        return FdmSchemeDesc(type, theta, mu, aTolerance, solverType);
+    }
+
+    FdmSchemeDesc FdmSchemeDesc::withSolver(
+                      ImplicitEulerScheme::SolverType aSolverType) const {
+        return FdmSchemeDesc(type, theta, mu, tolerance, aSolverType);
+    }
 
     FdmSchemeDesc FdmSchemeDesc::Douglas() { 
         return FdmSchemeDesc(FdmSchemeDesc::DouglasType, 0.5, 0.0);
@@ -88,42 +194,52 @@ namespace QuantLib {
 
         const Time deltaT = from - to;
         const Size allSteps = steps + dampingSteps;
-        const Time dampingTo = from - (deltaT*dampingSteps)/allSteps;
+        const Real tol = schemeDesc_.tolerance;
+        // in adaptive mode, the damping interval is as long as
+        // dampingSteps initial steps (but not longer than the whole
+        // interval) and is rolled back adaptively, so that the
+        // payoff kink isn't smoothed by one long step
+        const Time dampingTo = (tol == Null<Real>())
+            ? from - (deltaT*dampingSteps)/allSteps
+            : std::max(to, from - (deltaT*dampingSteps)/steps);
                     
         if (   dampingSteps 
             && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
-            ImplicitEulerScheme implicitEvolver(map_, bcSet_);    
-            FiniteDifferenceModel<ImplicitEulerScheme> 
-                    dampingModel(implicitEvolver, condition_->stoppingTimes());
-            dampingModel.rollback(rhs, from, dampingTo, 
-                                  dampingSteps, *condition_);
+            ImplicitEulerScheme implicitEvolver(
+                                 map_, bcSet_, 1e-8, schemeDesc_.solverType);
+            rollbackImpl(implicitEvolver, rhs, from, dampingTo,
+                         dampingSteps, *condition_, tol, 1);
         }
         
+        // order of accuracy in time, used to adapt the step size
+        const Size order =
+            (schemeDesc_.type == FdmSchemeDesc::ImplicitEulerType
+             || schemeDesc_.type == FdmSchemeDesc::ExplicitEulerType
+             || (schemeDesc_.type == FdmSchemeDesc::DouglasType
+                 && schemeDesc_.theta != 0.5)) ? 1 : 2;
+
         switch (schemeDesc_.type) {
           case FdmSchemeDesc::HundsdorferType:
             {
                 HundsdorferScheme hsEvolver(schemeDesc_.theta, schemeDesc_.mu, 
                                             map_, bcSet_);
-                FiniteDifferenceModel<HundsdorferScheme> 
-                               hsModel(hsEvolver, condition_->stoppingTimes());
-                hsModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                rollbackImpl(hsEvolver, rhs, dampingTo, to, steps,
+                             *condition_, tol, order);
             }
             break;
           case FdmSchemeDesc::DouglasType:
             {
                 DouglasScheme dsEvolver(schemeDesc_.theta, map_, bcSet_);
-                FiniteDifferenceModel<DouglasScheme> 
-                               dsModel(dsEvolver, condition_->stoppingTimes());
-                dsModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                rollbackImpl(dsEvolver, rhs, dampingTo, to, steps,
+                             *condition_, tol, order);
             }
             break;
           case FdmSchemeDesc::CraigSneydType:
             {
                 CraigSneydScheme csEvolver(schemeDesc_.theta, schemeDesc_.mu, 
                                            map_, bcSet_);
-                FiniteDifferenceModel<CraigSneydScheme> 
-                               csModel(csEvolver, condition_->stoppingTimes());
-                csModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                rollbackImpl(csEvolver, rhs, dampingTo, to, steps,
+                             *condition_, tol, order);
             }
             break;
           case FdmSchemeDesc::ModifiedCraigSneydType:
@@ -131,29 +247,58 @@ namespace QuantLib {
                 ModifiedCraigSneydScheme csEvolver(schemeDesc_.theta, 
                                                    schemeDesc_.mu,
                                                    map_, bcSet_);
-                FiniteDifferenceModel<ModifiedCraigSneydScheme> 
-                              mcsModel(csEvolver, condition_->stoppingTimes());
-                mcsModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                rollbackImpl(csEvolver, rhs, dampingTo, to, steps,
+                             *condition_, tol, order);
             }
             break;
           case FdmSchemeDesc::ImplicitEulerType:
             {
-                ImplicitEulerScheme implicitEvolver(map_, bcSet_);
-                FiniteDifferenceModel<ImplicitEulerScheme> 
-                   implicitModel(implicitEvolver, condition_->stoppingTimes());
-                implicitModel.rollback(rhs, from, to, allSteps, *condition_);
+                ImplicitEulerScheme implicitEvolver(
+                                 map_, bcSet_, 1e-8, schemeDesc_.solverType);
+                rollbackImpl(implicitEvolver, rhs, from, to, allSteps,
+                             *condition_, tol, order);
             }
             break;
           case FdmSchemeDesc::ExplicitEulerType:
             {
                 ExplicitEulerScheme explicitEvolver(map_, bcSet_);
-                FiniteDifferenceModel<ExplicitEulerScheme> 
-                   explicitModel(explicitEvolver, condition_->stoppingTimes());
-                explicitModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                rollbackImpl(explicitEvolver, rhs, dampingTo, to, steps,
+                             *condition_, tol, order);
             }
             break;
           default:
             QL_FAIL("Unknown scheme type");
         }
     }
+
+    void FdmBackwardSolver::rollback(
+                FdmBackwardSolver::array_type& rhs,
+                Time from, Time to,
+                Size steps, Size dampingSteps,
+                const boost::shared_ptr<FdmMultiSnapshotCondition>& snapshots) {
+        QL_REQUIRE(snapshots, "null snapshot condition");
+        const std::vector<Time>& times = snapshots->times();
+        QL_REQUIRE(times.front() >= to && times.back() <= from,
+                   "snapshot times [" << times.front() << ", "
+                   << times.back() << "] outside of the rollback interval ["
+                   << to << ", " << from << "]");
+
+        std::list<std::vector<Time> > stoppingTimes;
+        stoppingTimes.push_back(condition_->stoppingTimes());
+        stoppingTimes.push_back(times);
+
+        FdmStepConditionComposite::Conditions conditions;
+        conditions.push_back(condition_);
+        conditions.push_back(snapshots);
+
+        snapshots->reset();
+        FdmBackwardSolver(map_, bcSet_,
+                          boost::shared_ptr<FdmStepConditionComposite>(
+                              new FdmStepConditionComposite(stoppingTimes,
+                                                            conditions)),
+                          schemeDesc_)
+            .rollback(rhs, from, to, steps, dampingSteps);
+
+        QL_ENSURE(snapshots->allRecorded(), "snapshots not recorded");
+    }
 }
@@ -25,22 +25,48 @@
 #ifndef quantlib_fdm_backward_solver_hpp
 #define quantlib_fdm_backward_solver_hpp
 
+#include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmdirichletboundary.hpp>
+#include <ql/utilities/null.hpp>
 
 namespace QuantLib {
 
     class FdmLinearOpComposite;
     class FdmStepConditionComposite;
+    class FdmMultiSnapshotCondition;
 
     struct FdmSchemeDesc {
         enum FdmSchemeType { HundsdorferType, DouglasType, 
                              CraigSneydType, ModifiedCraigSneydType, 
                              ImplicitEulerType, ExplicitEulerType };
 
-        FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu);
+        /*! if a tolerance is given, the solver chooses the time
+            steps adaptively so that the local error, estimated by
+            step doubling, stays below it at each grid point.  The
+            error is divided by 1 plus the absolute value of the
+            solution at the point, i.e., it's an absolute error
+            for small values and a relative one for large values.
+            Damping steps are then chosen adaptively as well, over
+            an interval as long as the given number of initial steps.
+
+            The solver type selects the linear solver used in
+            implicit-Euler steps, including damping steps.
+        */
+        FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu,
+                      Real tolerance = Null<Real>(),
+                      ImplicitEulerScheme::SolverType solverType
+                                              = ImplicitEulerScheme::BiCGstabType);
+
+        //! returns the same scheme with adaptive time stepping
+        FdmSchemeDesc withTolerance(Real tolerance) const;
+        //! returns the same scheme with the given implicit solver
+        FdmSchemeDesc withSolver(
+                          ImplicitEulerScheme::SolverType solverType) const;
 
         const FdmSchemeType type;
         const Real theta, mu;
+        const Real tolerance;
+        const ImplicitEulerScheme::SolverType solverType;
 
         // some default scheme descriptions
         static FdmSchemeDesc Douglas();
@@ -62,10 +88,27 @@ namespace QuantLib {
           const boost::shared_ptr<FdmStepConditionComposite> condition,
           const FdmSchemeDesc& schemeDesc);
 
+        /*! In adaptive mode, steps gives the initial step size; the
+            step size is not allowed to fall below one hundredth of
+            it. The damping interval is then as long as dampingSteps
+            initial steps, capped at the whole interval, and is
+            rolled back adaptively as well.
+        */
         void rollback(array_type& a, 
                       Time from, Time to,
                       Size steps, Size dampingSteps);
 
+        /*! as above; in addition, the solution is recorded at the
+            snapshot times, which are added to the stopping times.
+            The snapshots are taken after the step conditions have
+            been applied; all snapshot times must lie in [to, from].
+        */
+        void rollback(array_type& a,
+                      Time from, Time to,
+                      Size steps, Size dampingSteps,
+                      const boost::shared_ptr<FdmMultiSnapshotCondition>&
+                                                                 snapshots);
+
       protected:
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const FdmBoundaryConditionSet bcSet_;
@@ -23,6 +23,7 @@
 #include <ql/methods/finitedifferences/solvers/fdm1dimsolver.hpp>
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmblackscholessolver.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -32,13 +33,15 @@ namespace QuantLib {
         const FdmSolverDesc& solverDesc,
         const FdmSchemeDesc& schemeDesc,
         bool localVol,
-        Real illegalLocalVolOverwrite)
+        Real illegalLocalVolOverwrite,
+        const std::vector<Time>& snapshotTimes)
     : process_(process),
       strike_(strike),
       solverDesc_(solverDesc),
       schemeDesc_(schemeDesc),
       localVol_(localVol),
-      illegalLocalVolOverwrite_(illegalLocalVolOverwrite) {
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
+      snapshotTimes_(snapshotTimes) {
 
         registerWith(process_);
     }
@@ -49,7 +52,7 @@ namespace QuantLib {
                 localVol_, illegalLocalVolOverwrite_));
 
         solver_ = boost::shared_ptr<Fdm1DimSolver>(
-            new Fdm1DimSolver(solverDesc_, schemeDesc_, op));
+            new Fdm1DimSolver(solverDesc_, schemeDesc_, op, snapshotTimes_));
     }
 
     Real FdmBlackScholesSolver::valueAt(Real s) const {
@@ -71,4 +74,56 @@ namespace QuantLib {
     Real FdmBlackScholesSolver::thetaAt(Real s) const {
         return solver_->thetaAt(std::log(s));
     }
+
+    const std::vector<Time>& FdmBlackScholesSolver::snapshotTimes() const {
+        calculate();
+        return solver_->snapshotTimes();
+    }
+
+    Disposable<Matrix> FdmBlackScholesSolver::valueSurface(
+                                          const std::vector<Real>& s) const {
+        calculate();
+        std::vector<Real> x(s.size());
+        std::transform(s.begin(), s.end(), x.begin(),
+                       static_cast<Real(*)(Real)>(std::log));
+        return solver_->valueSurface(x);
+    }
+
+    Disposable<Matrix> FdmBlackScholesSolver::deltaSurface(
+                                          const std::vector<Real>& s) const {
+        calculate();
+        std::vector<Real> x(s.size());
+        std::transform(s.begin(), s.end(), x.begin(),
+                       static_cast<Real(*)(Real)>(std::log));
+
+        Matrix result = solver_->derivativeXSurface(x);
+        for (Size i=0; i < result.rows(); ++i)
+            for (Size j=0; j < s.size(); ++j)
+                result[i][j] /= s[j];
+        return result;
+    }
+
+    Disposable<Matrix> FdmBlackScholesSolver::gammaSurface(
+                                          const std::vector<Real>& s) const {
+        calculate();
+        std::vector<Real> x(s.size());
+        std::transform(s.begin(), s.end(), x.begin(),
+                       static_cast<Real(*)(Real)>(std::log));
+
+        const Matrix dx = solver_->derivativeXSurface(x);
+        Matrix result = solver_->derivativeXXSurface(x);
+        for (Size i=0; i < result.rows(); ++i)
+            for (Size j=0; j < s.size(); ++j)
+                result[i][j] = (result[i][j] - dx[i][j])/(s[j]*s[j]);
+        return result;
+    }
+
+    Disposable<Matrix> FdmBlackScholesSolver::thetaSurface(
+                                          const std::vector<Real>& s) const {
+        calculate();
+        std::vector<Real> x(s.size());
+        std::transform(s.begin(), s.end(), x.begin(),
+                       static_cast<Real(*)(Real)>(std::log));
+        return solver_->thetaSurface(x);
+    }
 }
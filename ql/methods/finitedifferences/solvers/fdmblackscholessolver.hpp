@@ -26,6 +26,7 @@
 #define quantlib_fdm_black_scholes_solver_hpp
 
 #include <ql/handle.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
@@ -38,19 +39,36 @@ namespace QuantLib {
 
     class FdmBlackScholesSolver : public LazyObject {
       public:
+        /*! if snapshot times are given, value and greeks over time
+            and underlying are available from a single rollback;
+            see Fdm1DimSolver.
+        */
         FdmBlackScholesSolver(
             const Handle<GeneralizedBlackScholesProcess>& process,
             Real strike,
             const FdmSolverDesc& solverDesc,
             const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas(),
             bool localVol = false,
-            Real illegalLocalVolOverwrite = -Null<Real>());
+            Real illegalLocalVolOverwrite = -Null<Real>(),
+            const std::vector<Time>& snapshotTimes = std::vector<Time>());
 
         Real valueAt(Real s) const;
         Real deltaAt(Real s) const;
         Real gammaAt(Real s) const;
         Real thetaAt(Real s) const;
 
+        /*! \name Greek surfaces
+            rows correspond to the sorted snapshot times and columns
+            to the given underlying values.
+        */
+        //@{
+        const std::vector<Time>& snapshotTimes() const;
+        Disposable<Matrix> valueSurface(const std::vector<Real>& s) const;
+        Disposable<Matrix> deltaSurface(const std::vector<Real>& s) const;
+        Disposable<Matrix> gammaSurface(const std::vector<Real>& s) const;
+        Disposable<Matrix> thetaSurface(const std::vector<Real>& s) const;
+        //@}
+
       protected:
         void performCalculations() const;
 
@@ -61,6 +79,7 @@ namespace QuantLib {
         const FdmSchemeDesc schemeDesc_;
         const bool localVol_;
         const Real illegalLocalVolOverwrite_;
+        const std::vector<Time> snapshotTimes_;
 
         mutable boost::shared_ptr<Fdm1DimSolver> solver_;
     };
@@ -0,0 +1,201 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmforwardsolver.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        /* the backward schemes evolve from the final to the initial
+           time; for an operator evolving forward in time, solver time
+           t corresponds to maturity-t. */
+        class FdmTimeReversedOp : public FdmLinearOpComposite {
+          public:
+            FdmTimeReversedOp(
+                     const boost::shared_ptr<FdmLinearOpComposite>& op,
+                     Time maturity)
+            : op_(op), maturity_(maturity) {}
+
+            Size size() const { return op_->size(); }
+            void setTime(Time t1, Time t2) {
+                op_->setTime(std::max(0.0, maturity_ - t2), maturity_ - t1);
+            }
+
+            Disposable<Array> apply(const Array& r) const {
+                return op_->apply(r);
+            }
+            Disposable<Array> apply_mixed(const Array& r) const {
+                return op_->apply_mixed(r);
+            }
+            Disposable<Array> apply_direction(Size direction,
+                                              const Array& r) const {
+                return op_->apply_direction(direction, r);
+            }
+            Disposable<Array> solve_splitting(Size direction,
+                                              const Array& r, Real s) const {
+                return op_->solve_splitting(direction, r, s);
+            }
+            Disposable<Array> preconditioner(const Array& r, Real s) const {
+                return op_->preconditioner(r, s);
+            }
+            Disposable<CSRMatrix> toCSRMatrix() const {
+                return op_->toCSRMatrix();
+            }
+
+          private:
+            const boost::shared_ptr<FdmLinearOpComposite> op_;
+            const Time maturity_;
+        };
+
+        // hat function centered on x with the given left and right
+        // widths; null widths are found at the grid boundaries.
+        Real hat(Real x, Real center, Real hm, Real hp) {
+            if (x <= center)
+                return (hm == Null<Real>())
+                    ? ((x == center) ? 1.0 : 0.0)
+                    : std::max(0.0, 1.0 - (center - x)/hm);
+            else
+                return (hp == Null<Real>())
+                    ? 0.0 : std::max(0.0, 1.0 - (x - center)/hp);
+        }
+
+    }
+
+    FdmForwardSolver::FdmForwardSolver(
+            const boost::shared_ptr<FdmMesher>& mesher,
+            const boost::shared_ptr<FdmLinearOpComposite>& fwdOp,
+            const std::vector<Real>& initialLocation,
+            const std::vector<Time>& maturities,
+            Size timeSteps, Size dampingSteps,
+            const FdmSchemeDesc& schemeDesc,
+            Size direction)
+    : mesher_(mesher), op_(fwdOp), maturities_(maturities),
+      timeSteps_(timeSteps), dampingSteps_(dampingSteps),
+      schemeDesc_(schemeDesc), direction_(direction) {
+
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        const Size nDim = layout->dim().size();
+
+        QL_REQUIRE(initialLocation.size() == nDim,
+                   "one initial location per direction required");
+        QL_REQUIRE(direction_ < nDim, "direction too large");
+        QL_REQUIRE(!maturities_.empty(), "no maturity given");
+        QL_REQUIRE(maturities_.front() > 0.0, "positive maturities required");
+        for (Size i=1; i < maturities_.size(); ++i)
+            QL_REQUIRE(maturities_[i] > maturities_[i-1],
+                       "maturities must be sorted and unique");
+
+        // the integral of a function on the grid is approximated
+        // by the trapezoidal rule in each direction; the weights
+        // are also used for the initial Dirac delta, so that the
+        // integral of the initial density is exactly one.
+        initialDensity_ = Array(layout->size());
+        weights_ = Array(layout->size());
+        x_ = mesher_->locations(direction_);
+
+        Real total = 0.0;
+        const FdmLinearOpIterator endIter = layout->end();
+        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+             ++iter) {
+            Real w = 1.0, p = 1.0;
+            for (Size d=0; d < nDim; ++d) {
+                const Real hm = mesher_->dminus(iter, d);
+                const Real hp = mesher_->dplus(iter, d);
+                w *= 0.5*(  ((hm == Null<Real>()) ? 0.0 : hm)
+                          + ((hp == Null<Real>()) ? 0.0 : hp));
+                p *= hat(initialLocation[d],
+                         mesher_->location(iter, d), hm, hp);
+            }
+            weights_[iter.index()] = w;
+            initialDensity_[iter.index()] = p/w;
+            total += p;
+        }
+        QL_REQUIRE(std::fabs(total - 1.0) < 1e-8,
+                   "initial location outside of the grid");
+    }
+
+    void FdmForwardSolver::performCalculations() const {
+        const Time maturity = maturities_.back();
+
+        // snapshots at the intermediate maturities
+        std::vector<boost::shared_ptr<FdmSnapshotCondition> > snapshots;
+        FdmStepConditionComposite::Conditions conditions;
+        std::list<std::vector<Time> > stoppingTimes(1);
+        for (Size i=0; i+1 < maturities_.size(); ++i) {
+            const Time t = maturity - maturities_[i];
+            snapshots.push_back(boost::shared_ptr<FdmSnapshotCondition>(
+                                              new FdmSnapshotCondition(t)));
+            conditions.push_back(snapshots.back());
+            stoppingTimes.front().push_back(t);
+        }
+        const boost::shared_ptr<FdmStepConditionComposite> condition(
+                   new FdmStepConditionComposite(stoppingTimes, conditions));
+
+        const boost::shared_ptr<FdmLinearOpComposite> reversedOp(
+                                   new FdmTimeReversedOp(op_, maturity));
+
+        // the boundaries are taken care of by the operator
+        Array rhs(initialDensity_);
+        FdmBackwardSolver(reversedOp, FdmBoundaryConditionSet(),
+                          condition, schemeDesc_)
+            .rollback(rhs, maturity, 0.0, timeSteps_, dampingSteps_);
+
+        densities_.resize(maturities_.size());
+        for (Size i=0; i < snapshots.size(); ++i) {
+            densities_[i] = snapshots[i]->getValues();
+            QL_ENSURE(densities_[i].size() == rhs.size(),
+                      "no density calculated for maturity "
+                      << maturities_[i]);
+        }
+        densities_.back() = rhs;
+    }
+
+    const Array& FdmForwardSolver::density(Size i) const {
+        QL_REQUIRE(i < maturities_.size(),
+                   "maturity index (" << i << ") out of range; only "
+                   << maturities_.size() << " maturities available");
+        calculate();
+        return densities_[i];
+    }
+
+    Disposable<Matrix> FdmForwardSolver::prices(
+                                    Option::Type type,
+                                    const std::vector<Real>& strikes) const {
+        calculate();
+
+        const Real phi = (type == Option::Call) ? 1.0 : -1.0;
+        const Array s = Exp(x_);
+
+        Matrix retVal(maturities_.size(), strikes.size(), 0.0);
+        for (Size i=0; i < maturities_.size(); ++i) {
+            const Array weighted = weights_*densities_[i];
+            for (Size j=0; j < strikes.size(); ++j) {
+                Real npv = 0.0;
+                for (Size k=0; k < s.size(); ++k)
+                    npv += weighted[k]*std::max(phi*(s[k] - strikes[j]), 0.0);
+                retVal[i][j] = npv;
+            }
+        }
+        return retVal;
+    }
+}
@@ -0,0 +1,93 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmforwardsolver.hpp
+    \brief forward (Fokker-Planck) solver for European option prices
+*/
+
+#ifndef quantlib_fdm_forward_solver_hpp
+#define quantlib_fdm_forward_solver_hpp
+
+#include <ql/option.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+
+namespace QuantLib {
+
+    class FdmMesher;
+
+    //! forward (Fokker-Planck) solver for European option prices
+    /*! The Arrow-Debreu density of the state variables is started
+        as a Dirac delta at the initial location and evolved forward
+        in time by a Fokker-Planck operator such as
+        FdmBlackScholesFwdOp or FdmHestonFwdOp. A single run gives
+        the density at every requested maturity and, therefore, the
+        prices of European options for all strikes and maturities;
+        a backward solver would need a run per option.
+
+        The evolution reuses the backward schemes by reversing the
+        time of the operator. The Dirac delta is spread on the
+        neighbouring grid points so that its integral and its mean
+        are exact; damping steps are recommended to smooth it.
+
+        \test the prices are checked against the analytic ones for
+              the Black-Scholes and the Heston model.
+    */
+    class FdmForwardSolver : public LazyObject {
+      public:
+        /*! \param initialLocation initial value of the state
+                   variables, one for each direction of the mesher
+            \param direction direction of the logarithm of the
+                   underlying; the density is integrated over the
+                   others when calculating option prices
+        */
+        FdmForwardSolver(
+            const boost::shared_ptr<FdmMesher>& mesher,
+            const boost::shared_ptr<FdmLinearOpComposite>& fwdOp,
+            const std::vector<Real>& initialLocation,
+            const std::vector<Time>& maturities,
+            Size timeSteps, Size dampingSteps = 0,
+            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas(),
+            Size direction = 0);
+
+        const std::vector<Time>& maturities() const { return maturities_; }
+
+        //! Arrow-Debreu density at the i-th maturity
+        const Array& density(Size i) const;
+
+        //! prices of European options; rows correspond to maturities
+        Disposable<Matrix> prices(Option::Type type,
+                                  const std::vector<Real>& strikes) const;
+
+      protected:
+        void performCalculations() const;
+
+      private:
+        const boost::shared_ptr<FdmMesher> mesher_;
+        const boost::shared_ptr<FdmLinearOpComposite> op_;
+        const std::vector<Time> maturities_;
+        const Size timeSteps_, dampingSteps_;
+        const FdmSchemeDesc schemeDesc_;
+        const Size direction_;
+
+        Array initialDensity_, weights_, x_;
+        mutable std::vector<Array> densities_;
+    };
+}
+
+#endif
@@ -0,0 +1,182 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmmultipayoffsolver.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        // applies the step conditions of each payoff to its own block
+        class FdmStackedStepCondition : public StepCondition<Array> {
+          public:
+            FdmStackedStepCondition(
+                const std::vector<boost::shared_ptr<
+                                   FdmStepConditionComposite> >& conditions,
+                Size blockSize)
+            : conditions_(conditions), blockSize_(blockSize) {}
+
+            void applyTo(Array& a, Time t) const {
+                Array block(blockSize_);
+                for (Size i=0; i < conditions_.size(); ++i) {
+                    if (conditions_[i]) {
+                        Array::iterator begin = a.begin() + i*blockSize_;
+                        std::copy(begin, begin+blockSize_, block.begin());
+                        conditions_[i]->applyTo(block, t);
+                        std::copy(block.begin(), block.end(), begin);
+                    }
+                }
+            }
+
+          private:
+            const std::vector<boost::shared_ptr<FdmStepConditionComposite> >
+                                                                  conditions_;
+            const Size blockSize_;
+        };
+
+    }
+
+    FdmMultiPayoffSolver::FdmMultiPayoffSolver(
+        const boost::shared_ptr<FdmMesher>& mesher,
+        const FdmBoundaryConditionSet& bcSet,
+        const std::vector<boost::shared_ptr<FdmInnerValueCalculator> >&
+                                                                 calculators,
+        const std::vector<boost::shared_ptr<FdmStepConditionComposite> >&
+                                                                 conditions,
+        Time maturity, Size timeSteps, Size dampingSteps,
+        const FdmSchemeDesc& schemeDesc,
+        const boost::shared_ptr<FdmLinearOpComposite>& op)
+    : mesher_(mesher), bcSet_(bcSet), calculators_(calculators),
+      maturity_(maturity), timeSteps_(timeSteps),
+      dampingSteps_(dampingSteps), schemeDesc_(schemeDesc), op_(op) {
+
+        QL_REQUIRE(!calculators_.empty(), "no payoff given");
+        QL_REQUIRE(conditions.size() == calculators_.size(),
+                   "wrong number of step conditions ("
+                   << conditions.size() << ") for "
+                   << calculators_.size() << " payoffs");
+
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        const Size n = layout->size();
+
+        std::list<std::vector<Time> > stoppingTimes;
+        for (Size i=0; i < conditions.size(); ++i) {
+            if (conditions[i])
+                stoppingTimes.push_back(conditions[i]->stoppingTimes());
+        }
+        FdmStepConditionComposite::Conditions stackedCondition(1,
+            boost::shared_ptr<StepCondition<Array> >(
+                new FdmStackedStepCondition(conditions, n)));
+        conditions_ = boost::shared_ptr<FdmStepConditionComposite>(
+            new FdmStepConditionComposite(stoppingTimes, stackedCondition));
+
+        initialValues_ = Array(calculators_.size()*n);
+        const FdmLinearOpIterator endIter = layout->end();
+        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+             ++iter) {
+            for (Size i=0; i < calculators_.size(); ++i) {
+                initialValues_[i*n + iter.index()]
+                    = calculators_[i]->avgInnerValue(iter, maturity_);
+            }
+
+            if (layout->dim().size() <= 2) {
+                if (layout->dim().size() == 1 || !iter.coordinates()[1])
+                    x_.push_back(mesher_->location(iter, 0));
+                if (layout->dim().size() == 2 && !iter.coordinates()[0])
+                    y_.push_back(mesher_->location(iter, 1));
+            }
+        }
+    }
+
+    void FdmMultiPayoffSolver::performCalculations() const {
+        Array rhs(initialValues_);
+
+        FdmBackwardSolver(op_, bcSet_, conditions_, schemeDesc_)
+            .rollback(rhs, maturity_, 0.0, timeSteps_, dampingSteps_);
+
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        const Size n = layout->size();
+
+        resultValues_.resize(calculators_.size());
+        for (Size i=0; i < calculators_.size(); ++i) {
+            resultValues_[i] = Array(rhs.begin() + i*n,
+                                     rhs.begin() + (i+1)*n);
+        }
+
+        interpolations1D_.clear();
+        interpolations2D_.clear();
+        resultMatrices_.clear();
+        if (layout->dim().size() == 1) {
+            for (Size i=0; i < calculators_.size(); ++i) {
+                interpolations1D_.push_back(
+                    boost::shared_ptr<CubicInterpolation>(
+                        new MonotonicCubicNaturalSpline(
+                                x_.begin(), x_.end(),
+                                resultValues_[i].begin())));
+            }
+        }
+        else if (layout->dim().size() == 2) {
+            // the splines keep a reference to the matrices, which
+            // must not be moved after the splines are built
+            resultMatrices_.resize(calculators_.size(),
+                                   Matrix(y_.size(), x_.size()));
+            for (Size i=0; i < calculators_.size(); ++i) {
+                std::copy(resultValues_[i].begin(), resultValues_[i].end(),
+                          resultMatrices_[i].begin());
+                interpolations2D_.push_back(
+                    boost::shared_ptr<BicubicSpline>(
+                        new BicubicSpline(x_.begin(), x_.end(),
+                                          y_.begin(), y_.end(),
+                                          resultMatrices_[i])));
+            }
+        }
+    }
+
+    const Array& FdmMultiPayoffSolver::values(Size i) const {
+        QL_REQUIRE(i < calculators_.size(),
+                   "payoff index (" << i << ") out of range; only "
+                   << calculators_.size() << " payoffs available");
+        calculate();
+        return resultValues_[i];
+    }
+
+    Real FdmMultiPayoffSolver::interpolateAt(Size i, Real x) const {
+        QL_REQUIRE(i < calculators_.size(),
+                   "payoff index (" << i << ") out of range; only "
+                   << calculators_.size() << " payoffs available");
+        QL_REQUIRE(mesher_->layout()->dim().size() == 1,
+                   "one-dimensional mesher required");
+        calculate();
+        return interpolations1D_[i]->operator()(x);
+    }
+
+    Real FdmMultiPayoffSolver::interpolateAt(Size i, Real x, Real y) const {
+        QL_REQUIRE(i < calculators_.size(),
+                   "payoff index (" << i << ") out of range; only "
+                   << calculators_.size() << " payoffs available");
+        QL_REQUIRE(mesher_->layout()->dim().size() == 2,
+                   "two-dimensional mesher required");
+        calculate();
+        return interpolations2D_[i]->operator()(x, y);
+    }
+}
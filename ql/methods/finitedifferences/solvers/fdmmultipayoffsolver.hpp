@@ -0,0 +1,108 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmmultipayoffsolver.hpp
+    \brief rollback of several payoffs on a common grid
+*/
+
+#ifndef quantlib_fdm_multi_payoff_solver_hpp
+#define quantlib_fdm_multi_payoff_solver_hpp
+
+#include <ql/math/matrix.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+
+namespace QuantLib {
+
+    class BicubicSpline;
+    class CubicInterpolation;
+
+    //! rollback of several payoffs on a common grid
+    /*! The payoffs share the mesher, the boundary conditions and
+        the operator and are rolled back together as a single array
+        holding one block per payoff. Therefore, the operator is
+        updated once per time step for the whole batch and the
+        tridiagonal systems of the splitting schemes are factorized
+        once for all payoffs. Step conditions, e.g., early exercise,
+        are applied to each payoff separately; the time grid
+        contains the stopping times of all of them. The iterative
+        solvers of the implicit Euler scheme, also used for damping
+        steps, work on the batch as a whole; their results can thus
+        differ from separate rollbacks within the solver tolerance.
+
+        \warning the operator must act separately on each block of
+                 a stacked array. This is the case for the operators
+                 built on TripleBandLinearOp and NinePointLinearOp,
+                 e.g., FdmBlackScholesOp and FdmHestonOp.
+
+        \test the results are checked against separate rollbacks
+              for the Black-Scholes and the Heston operator.
+    */
+    class FdmMultiPayoffSolver : public LazyObject {
+      public:
+        /*! null step conditions are allowed and correspond to
+            European payoffs.
+        */
+        FdmMultiPayoffSolver(
+            const boost::shared_ptr<FdmMesher>& mesher,
+            const FdmBoundaryConditionSet& bcSet,
+            const std::vector<boost::shared_ptr<FdmInnerValueCalculator> >&
+                                                                 calculators,
+            const std::vector<boost::shared_ptr<FdmStepConditionComposite> >&
+                                                                 conditions,
+            Time maturity, Size timeSteps, Size dampingSteps,
+            const FdmSchemeDesc& schemeDesc,
+            const boost::shared_ptr<FdmLinearOpComposite>& op);
+
+        Size size() const { return calculators_.size(); }
+
+        //! values of the i-th payoff on the layout of the mesher
+        const Array& values(Size i) const;
+
+        //! interpolated value of the i-th payoff on a 1-dim mesher
+        Real interpolateAt(Size i, Real x) const;
+        //! interpolated value of the i-th payoff on a 2-dim mesher
+        Real interpolateAt(Size i, Real x, Real y) const;
+
+      protected:
+        void performCalculations() const;
+
+      private:
+        const boost::shared_ptr<FdmMesher> mesher_;
+        const FdmBoundaryConditionSet bcSet_;
+        const std::vector<boost::shared_ptr<FdmInnerValueCalculator> >
+                                                                 calculators_;
+        const Time maturity_;
+        const Size timeSteps_, dampingSteps_;
+        const FdmSchemeDesc schemeDesc_;
+        const boost::shared_ptr<FdmLinearOpComposite> op_;
+
+        boost::shared_ptr<FdmStepConditionComposite> conditions_;
+        std::vector<Real> x_, y_;
+        Array initialValues_;
+
+        mutable std::vector<Array> resultValues_;
+        mutable std::vector<Matrix> resultMatrices_;
+        mutable std::vector<boost::shared_ptr<CubicInterpolation> >
+                                                           interpolations1D_;
+        mutable std::vector<boost::shared_ptr<BicubicSpline> >
+                                                           interpolations2D_;
+    };
+}
+
+#endif
@@ -40,6 +40,16 @@ namespace QuantLib {
         const Time maturity;
         const Size timeSteps;
         const Size dampingSteps;
+        /*! number of grid points per direction around the evaluation
+            point on which Fdm2DimSolver and Fdm3DimSolver build their
+            splines; zero, the value taken when it is omitted from the
+            initializer list, uses the whole grid.  Otherwise it must
+            be at least 4, so that the splines and the greeks derived
+            from them are still cubic.  Interpolating on such a patch
+            is faster, but the results might differ slightly from
+            those on the whole grid.
+        */
+        const Size interpolationPoints;
     };
 }
 
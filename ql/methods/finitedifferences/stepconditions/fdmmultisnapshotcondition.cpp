@@ -0,0 +1,65 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/stepconditions/fdmmultisnapshotcondition.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    FdmMultiSnapshotCondition::FdmMultiSnapshotCondition(
+                                              const std::vector<Time>& times)
+    : times_(times) {
+        std::sort(times_.begin(), times_.end());
+        times_.erase(std::unique(times_.begin(), times_.end()),
+                     times_.end());
+        QL_REQUIRE(!times_.empty(), "no snapshot time given");
+        QL_REQUIRE(times_.front() >= 0.0,
+                   "negative snapshot time given: " << times_.front());
+        recorded_.resize(times_.size(), false);
+    }
+
+    void FdmMultiSnapshotCondition::applyTo(Array& a, Time t) const {
+        const std::vector<Time>::const_iterator iter =
+            std::lower_bound(times_.begin(), times_.end(), t);
+        if (iter == times_.end() || *iter != t)
+            return;
+
+        if (values_.rows() != times_.size() || values_.columns() != a.size())
+            values_ = Matrix(times_.size(), a.size());
+
+        const Size i = iter - times_.begin();
+        std::copy(a.begin(), a.end(), values_.row_begin(i));
+        recorded_[i] = true;
+    }
+
+    void FdmMultiSnapshotCondition::reset() {
+        std::fill(recorded_.begin(), recorded_.end(), false);
+    }
+
+    bool FdmMultiSnapshotCondition::recorded(Size i) const {
+        QL_REQUIRE(i < times_.size(),
+                   "snapshot index (" << i << ") out of range; only "
+                   << times_.size() << " snapshots available");
+        return recorded_[i];
+    }
+
+    bool FdmMultiSnapshotCondition::allRecorded() const {
+        return std::find(recorded_.begin(), recorded_.end(), false)
+            == recorded_.end();
+    }
+
+}
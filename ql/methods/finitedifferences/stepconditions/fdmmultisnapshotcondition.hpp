@@ -0,0 +1,62 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmmultisnapshotcondition.hpp
+    \brief step condition recording the solution at several times
+*/
+
+#ifndef quantlib_fdm_multi_snapshot_condition_hpp
+#define quantlib_fdm_multi_snapshot_condition_hpp
+
+#include <ql/math/matrix.hpp>
+#include <ql/methods/finitedifferences/stepcondition.hpp>
+
+namespace QuantLib {
+
+    //! step condition recording the solution at several times
+    /*! The values are stored in a single matrix whose rows
+        correspond to the sorted snapshot times and whose columns
+        correspond to the grid points. The matrix is reused by
+        later rollbacks on a grid of the same size.
+
+        The solution is only recorded at times matching exactly a
+        snapshot time; FdmBackwardSolver::rollback adds the times
+        to the stopping times of the rollback.
+    */
+    class FdmMultiSnapshotCondition : public StepCondition<Array> {
+      public:
+        explicit FdmMultiSnapshotCondition(const std::vector<Time>& times);
+
+        void applyTo(Array& a, Time t) const;
+
+        const std::vector<Time>& times() const { return times_; }
+        //! recorded values; rows correspond to the snapshot times
+        const Matrix& values() const { return values_; }
+
+        //! marks all the snapshots as not recorded
+        void reset();
+        bool recorded(Size i) const;
+        bool allRecorded() const;
+
+      private:
+        std::vector<Time> times_;
+        mutable Matrix values_;
+        mutable std::vector<bool> recorded_;
+    };
+}
+
+#endif
@@ -20,6 +20,7 @@
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmsimplestoragecondition.hpp>
+#include <ql/utilities/parallelerrors.hpp>
 
 namespace QuantLib {
 
@@ -64,32 +65,50 @@ namespace QuantLib {
                                           y_.begin(), y_.end(), m);
 
             const boost::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
-            const FdmLinearOpIterator endIter = layout->end();
 
-            for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
-                 ++iter) {
-
-                const std::vector<Size>& coor = iter.coordinates();
-                const Real x = x_[coor[0]];
-                const Real y = y_[coor[1]];
-
-                const Real price = calculator_->innerValue(iter, t);
-                Real currentValue = a[iter.index()];
-
-                // sell
-                if (coor[1] > 0) {
-                    const Real sellPrice = interpl(x, y-changeRate_);
-                    currentValue
-                        = std::max(currentValue, sellPrice + price*changeRate_);
+            // the nodes are independent from each other, therefore the
+            // lines of constant storage level can be handled by
+            // different threads.
+            const Integer nLines = Integer(y_.size());
+            ParallelErrors errors;
+
+            #if defined(_OPENMP)
+            #pragma omp parallel for if (a.size() > 10000)
+            #endif
+            for (Integer l=0; l < nLines; ++l) {
+                try {
+                    const Size end = (l+1)*x_.size();
+                    for (FdmLinearOpIterator iter
+                             = layout->iter_at(l*x_.size());
+                         iter.index() < end; ++iter) {
+
+                        const std::vector<Size>& coor = iter.coordinates();
+                        const Real x = x_[coor[0]];
+                        const Real y = y_[coor[1]];
+
+                        const Real price = calculator_->innerValue(iter, t);
+                        Real currentValue = a[iter.index()];
+
+                        // sell
+                        if (coor[1] > 0) {
+                            const Real sellPrice = interpl(x, y-changeRate_);
+                            currentValue = std::max(currentValue,
+                                                sellPrice + price*changeRate_);
+                        }
+                        // buy
+                        if (coor[1] < y_.size()-1) {
+                            const Real buyPrice = interpl(x, y+changeRate_);
+                            currentValue = std::max(currentValue,
+                                                buyPrice - price*changeRate_);
+                        }
+                        retVal[iter.index()] = currentValue;
+                    }
+                } catch (...) {
+                    errors.record(l);
                 }
-                // buy
-                if (coor[1] < y_.size()-1) {
-                    const Real buyPrice = interpl(x, y+changeRate_);
-                    currentValue
-                        = std::max(currentValue, buyPrice - price*changeRate_);
-                }
-                retVal[iter.index()] = currentValue;
             }
+            errors.rethrow();
+
             a = retVal;
         }
     }
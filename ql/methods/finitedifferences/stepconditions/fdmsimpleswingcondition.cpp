@@ -19,6 +19,7 @@
 
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmsimpleswingcondition.hpp>
+#include <ql/utilities/parallelerrors.hpp>
 
 namespace QuantLib {
 
@@ -43,27 +44,49 @@ namespace QuantLib {
             const Size d = std::distance(iter, exerciseTimes_.end());
 
             const boost::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
-            const FdmLinearOpIterator endIter = layout->end();
-            
-            for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
-                 ++iter) {
-                
-                const std::vector<Size>& coor = iter.coordinates();
-                
-                const Size exerciseValue = coor[swingDirection_];
-                
-                if (exerciseValue > 0) {
-                    const Real cashflow = calculator_->innerValue(iter, t);
-                    const Real currentValue = a[iter.index()];
-                    const Real valueMinusOneExRight 
-                         = a[layout->neighbourhood(iter, swingDirection_, -1)];
-                    
-                    if (   currentValue < cashflow + valueMinusOneExRight
-                        || exerciseValue >= d ) {
-                        retVal[iter.index()] = cashflow + valueMinusOneExRight;
+
+            // the nodes only read from a, therefore the lines along
+            // the first direction can be handled by different threads.
+            const Size lineLength = layout->dim()[0];
+            const Integer nLines = Integer(layout->size()/lineLength);
+            ParallelErrors errors;
+
+            #if defined(_OPENMP)
+            #pragma omp parallel for if (a.size() > 10000)
+            #endif
+            for (Integer l=0; l < nLines; ++l) {
+                try {
+                    const Size end = (l+1)*lineLength;
+                    for (FdmLinearOpIterator iter
+                             = layout->iter_at(l*lineLength);
+                         iter.index() < end; ++iter) {
+
+                        const std::vector<Size>& coor = iter.coordinates();
+
+                        const Size exerciseValue = coor[swingDirection_];
+
+                        if (exerciseValue > 0) {
+                            const Real cashflow
+                                = calculator_->innerValue(iter, t);
+                            const Real currentValue = a[iter.index()];
+                            const Real valueMinusOneExRight = a[
+                                layout->neighbourhood(iter, swingDirection_,
+                                                      -1)];
+
+                            if (   currentValue
+                                       < cashflow + valueMinusOneExRight
+                                || exerciseValue >= d ) {
+                                retVal[iter.index()]
+                                    = cashflow + valueMinusOneExRight;
+                            }
+                        }
                     }
+                } catch (...) {
+                    errors.record(l);
                 }
             }
+            errors.rethrow();
+
             a = retVal;
         }
     }
@@ -66,9 +66,6 @@ namespace QuantLib {
         \ingroup findiff
     */
 
-    // NOTE: There is room for performance improvement especially in
-    // the array manipulation
-
     template <class Operator>
     class TRBDF2  {
       public:
@@ -109,11 +106,10 @@ namespace QuantLib {
     template <class Operator>
     inline void TRBDF2<Operator>::step(array_type& a, Time t) {
         Size i;
-        Array aInit(a.size());
-        for (i=0; i<a.size();i++) {
-            aInit[i] = a[i];
-        }
-        aInit_ = aInit;
+        // aInit_ is kept between steps to avoid reallocating it
+        if (aInit_.size() != a.size())
+            aInit_ = array_type(a.size());
+        std::copy(a.begin(), a.end(), aInit_.begin());
         for (i=0; i<bcs_.size(); i++)
             bcs_[i]->setTime(t);
         //trapezoidal explicit part
@@ -123,7 +119,7 @@ namespace QuantLib {
         }
         for (i=0; i<bcs_.size(); i++)
             bcs_[i]->applyBeforeApplying(explicitTrapezoidalPart_);
-        a = explicitTrapezoidalPart_.applyTo(a);
+        explicitTrapezoidalPart_.applyTo(a, a);
         for (i=0; i<bcs_.size(); i++)
             bcs_[i]->applyAfterApplying(a);
 
@@ -134,7 +130,7 @@ namespace QuantLib {
         }
         for (i=0; i<bcs_.size(); i++)
             bcs_[i]->applyBeforeSolving(implicitPart_,a);
-        a = implicitPart_.solveFor(a);
+        implicitPart_.solveFor(a, a);
         for (i=0; i<bcs_.size(); i++)
             bcs_[i]->applyAfterSolving(a);
 
@@ -146,22 +142,22 @@ namespace QuantLib {
         for (i=0; i<bcs_.size(); i++) {
             bcs_[i]->applyBeforeApplying(explicitBDF2PartFull_);
         }
-        array_type b0 = explicitBDF2PartFull_.applyTo(aInit_);
+        explicitBDF2PartFull_.applyTo(aInit_, aInit_);
         for (i=0; i<bcs_.size(); i++)
-            bcs_[i]->applyAfterApplying(b0);
+            bcs_[i]->applyAfterApplying(aInit_);
 
         for (i=0; i<bcs_.size(); i++) {
             bcs_[i]->applyBeforeApplying(explicitBDF2PartMid_);
         }
-        array_type b1 = explicitBDF2PartMid_.applyTo(a);
+        explicitBDF2PartMid_.applyTo(a, a);
         for (i=0; i<bcs_.size(); i++)
-            bcs_[i]->applyAfterApplying(b1);
-        a = b0+b1;
+            bcs_[i]->applyAfterApplying(a);
+        a += aInit_;
 
         // reuse implicit part - works only for alpha=2-sqrt(2)
         for (i=0; i<bcs_.size(); i++)
             bcs_[i]->applyBeforeSolving(implicitPart_,a);
-        a = implicitPart_.solveFor(a);
+        implicitPart_.solveFor(a, a);
         for (i=0; i<bcs_.size(); i++)
             bcs_[i]->applyAfterSolving(a);
 
@@ -60,25 +60,35 @@ namespace QuantLib {
     }
 
     Disposable<Array> TridiagonalOperator::applyTo(const Array& v) const {
+        Array result(v.size());
+        applyTo(v, result);
+        return result;
+    }
+
+    void TridiagonalOperator::applyTo(const Array& v,
+                                      Array& result) const {
         QL_REQUIRE(n_!=0,
                    "uninitialized TridiagonalOperator");
         QL_REQUIRE(v.size()==n_,
                    "vector of the wrong size " << v.size() <<
                    " instead of " << n_);
-        Array result(n_);
-        std::transform(diagonal_.begin(), diagonal_.end(),
-                       v.begin(),
-                       result.begin(),
-                       std::multiplies<Real>());
-
-        // matricial product
-        result[0] += upperDiagonal_[0]*v[1];
-        for (Size j=1; j<=n_-2; j++)
-            result[j] += lowerDiagonal_[j-1]*v[j-1]+
-                upperDiagonal_[j]*v[j+1];
-        result[n_-1] += lowerDiagonal_[n_-2]*v[n_-2];
+        QL_REQUIRE(result.size()==n_,
+                   "result vector of size " << result.size() <<
+                   " instead of " << n_);
 
-        return result;
+        // matricial product; the previous element of v is saved
+        // before being overwritten, so that v and result can be
+        // the same array
+        Real previous = v[0];
+        result[0] = diagonal_[0]*v[0] + upperDiagonal_[0]*v[1];
+        for (Size j=1; j<=n_-2; j++) {
+            const Real current = v[j];
+            result[j] = diagonal_[j]*current
+                + (lowerDiagonal_[j-1]*previous + upperDiagonal_[j]*v[j+1]);
+            previous = current;
+        }
+        result[n_-1] = diagonal_[n_-1]*v[n_-1]
+            + lowerDiagonal_[n_-2]*previous;
     }
 
     Disposable<Array> TridiagonalOperator::solveFor(const Array& rhs) const  {
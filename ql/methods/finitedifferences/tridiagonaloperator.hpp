@@ -74,6 +74,12 @@ namespace QuantLib {
         //@{
         //! apply operator to a given array
         Disposable<Array> applyTo(const Array& v) const;
+        /*! apply operator to a given array without result Array
+            allocation. The v and result parameters can be the same
+            Array, in which case v will be changed
+        */
+        void applyTo(const Array& v,
+                     Array& result) const;
         //! solve linear system for a given right-hand side
         Disposable<Array> solveFor(const Array& rhs) const;
         /*! solve linear system for a given right-hand side
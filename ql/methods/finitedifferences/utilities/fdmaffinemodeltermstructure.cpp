@@ -45,6 +45,8 @@ namespace QuantLib {
 
     void FdmAffineModelTermStructure::setVariable(const Array& r) {
         r_ = r;
+        // the state change doesn't go through update()
+        clearDiscountCache();
         notifyObservers();
     }
 
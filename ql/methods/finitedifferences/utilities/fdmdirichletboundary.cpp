@@ -31,7 +31,8 @@ namespace QuantLib {
                             Real valueOnBoundary, Size direction,
                             FdmDirichletBoundary::Side side)
     : side_(side),
-      valueOnBoundary_(valueOnBoundary) {
+      valueOnBoundary_(valueOnBoundary),
+      layoutSize_(mesher->layout()->size()) {
                                 
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
                                 
@@ -64,9 +65,12 @@ namespace QuantLib {
     }
 
     void FdmDirichletBoundary::applyAfterApplying(Array& rhs) const {
-        for (std::vector<Size>::const_iterator iter = indicies_.begin();
-             iter != indicies_.end(); ++iter) {
-            rhs[*iter] = valueOnBoundary_;
+        // rhs might contain several vectors stacked one after the other
+        for (Size s=0; s < rhs.size(); s+=layoutSize_) {
+            for (std::vector<Size>::const_iterator iter = indicies_.begin();
+                 iter != indicies_.end(); ++iter) {
+                rhs[s + *iter] = valueOnBoundary_;
+            }
         }
     }
     
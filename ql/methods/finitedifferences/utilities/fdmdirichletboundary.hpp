@@ -58,6 +58,7 @@ namespace QuantLib {
         const Real valueOnBoundary_;
 
         Real xExtreme_;
+        Size layoutSize_;
         std::vector<Size> indicies_;
     };
     
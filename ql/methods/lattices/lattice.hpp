@@ -28,6 +28,7 @@
 #include <ql/numericalmethod.hpp>
 #include <ql/discretizedasset.hpp>
 #include <ql/patterns/curiouslyrecurring.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -51,6 +52,11 @@ namespace QuantLib {
                         Array& newValues) const;
         \endcode
 
+        Several assets living on the same lattice can be rolled back
+        together; in this case, the branching probabilities,
+        descendants and discount factors are evaluated once per node
+        and shared among the assets.
+
         \ingroup lattices
     */
     template <class Impl>
@@ -74,11 +80,33 @@ namespace QuantLib {
         Real presentValue(DiscretizedAsset&) const;
         //@}
 
+        //! \name Multi-asset interface
+        //@{
+        /*! Roll back a set of assets, all at the same time, until the
+            given time, performing any needed adjustment.
+        */
+        void rollback(
+                const std::vector<boost::shared_ptr<DiscretizedAsset> >&,
+                Time to) const;
+        /*! Roll back a set of assets, all at the same time, until the
+            given time, but do not perform the final adjustment.
+        */
+        void partialRollback(
+                const std::vector<boost::shared_ptr<DiscretizedAsset> >&,
+                Time to) const;
+        //@}
+
         const Array& statePrices(Size i) const;
 
         void stepback(Size i,
                       const Array& values,
                       Array& newValues) const;
+        /*! steps back one array of values per asset; the number of
+            assets is given by the size of the passed vectors.
+        */
+        void stepback(Size i,
+                      const std::vector<Array>& values,
+                      std::vector<Array>& newValues) const;
 
       protected:
         void computeStatePrices(Size until) const;
@@ -152,17 +180,80 @@ namespace QuantLib {
         Integer iFrom = Integer(t_.index(from));
         Integer iTo = Integer(t_.index(to));
 
+        // the previous values are recycled as storage for the next
+        // step, so that no allocation is needed once the lattice
+        // stops growing
+        Array newValues;
         for (Integer i=iFrom-1; i>=iTo; --i) {
-            Array newValues(this->impl().size(i));
+            if (newValues.size() != this->impl().size(i))
+                newValues = Array(this->impl().size(i));
             this->impl().stepback(i, asset.values(), newValues);
             asset.time() = t_[i];
-            asset.values() = newValues;
+            asset.values().swap(newValues);
             // skip the very last adjustment
             if (i != iTo)
                 asset.adjustValues();
         }
     }
 
+    template <class Impl>
+    void TreeLattice<Impl>::rollback(
+             const std::vector<boost::shared_ptr<DiscretizedAsset> >& assets,
+             Time to) const {
+        partialRollback(assets,to);
+        for (Size k=0; k<assets.size(); ++k)
+            assets[k]->adjustValues();
+    }
+
+    template <class Impl>
+    void TreeLattice<Impl>::partialRollback(
+             const std::vector<boost::shared_ptr<DiscretizedAsset> >& assets,
+             Time to) const {
+
+        if (assets.empty())
+            return;
+
+        Time from = assets.front()->time();
+        for (Size k=1; k<assets.size(); ++k)
+            QL_REQUIRE(close(assets[k]->time(),from),
+                       "assets must be at the same time (asset " << k
+                       << " is at t = " << assets[k]->time()
+                       << ", asset 0 at t = " << from << ")");
+
+        if (close(from,to))
+            return;
+
+        QL_REQUIRE(from > to,
+                   "cannot roll the assets back to" << to
+                   << " (they are already at t = " << from << ")");
+
+        Integer iFrom = Integer(t_.index(from));
+        Integer iTo = Integer(t_.index(to));
+
+        Size nAssets = assets.size();
+        std::vector<Array> values(nAssets), newValues(nAssets);
+        for (Integer i=iFrom-1; i>=iTo; --i) {
+            Size size = this->impl().size(i);
+            for (Size k=0; k<nAssets; ++k) {
+                values[k].swap(assets[k]->values());
+                if (newValues[k].size() != size)
+                    newValues[k] = Array(size);
+            }
+            stepback(i, values, newValues);
+            for (Size k=0; k<nAssets; ++k) {
+                assets[k]->time() = t_[i];
+                assets[k]->values().swap(newValues[k]);
+                // recycle the previous values as storage for the next step
+                newValues[k].swap(values[k]);
+            }
+            // skip the very last adjustment
+            if (i != iTo) {
+                for (Size k=0; k<nAssets; ++k)
+                    assets[k]->adjustValues();
+            }
+        }
+    }
+
     template <class Impl>
     void TreeLattice<Impl>::stepback(Size i, const Array& values,
                                      Array& newValues) const {
@@ -177,6 +268,32 @@ namespace QuantLib {
         }
     }
 
+    template <class Impl>
+    void TreeLattice<Impl>::stepback(Size i,
+                                     const std::vector<Array>& values,
+                                     std::vector<Array>& newValues) const {
+        QL_REQUIRE(values.size() == newValues.size(),
+                   "mismatch between number of values (" << values.size()
+                   << ") and of new values (" << newValues.size() << ")");
+        Size nAssets = values.size();
+        std::vector<Size> descendants(n_);
+        std::vector<Real> probabilities(n_);
+        for (Size j=0; j<this->impl().size(i); j++) {
+            for (Size l=0; l<n_; l++) {
+                descendants[l] = this->impl().descendant(i,j,l);
+                probabilities[l] = this->impl().probability(i,j,l);
+            }
+            DiscountFactor discount = this->impl().discount(i,j);
+            for (Size k=0; k<nAssets; ++k) {
+                const Array& v = values[k];
+                Real value = 0.0;
+                for (Size l=0; l<n_; l++)
+                    value += probabilities[l] * v[descendants[l]];
+                newValues[k][j] = value * discount;
+            }
+        }
+    }
+
 }
 
 
@@ -76,6 +76,9 @@ namespace QuantLib {
         void setPricingEngine(const boost::shared_ptr<PricingEngine>& engine) {
             engine_ = engine;
         }
+        const boost::shared_ptr<PricingEngine>& pricingEngine() const {
+            return engine_;
+        }
 
       protected:
         Real marketValue_;
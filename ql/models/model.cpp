@@ -19,6 +19,9 @@
 
 #include <ql/models/model.hpp>
 #include <ql/math/optimization/problem.hpp>
+#include <ql/pricingengine.hpp>
+#include <ql/utilities/parallelerrors.hpp>
+#include <set>
 
 namespace QuantLib {
 
@@ -37,18 +40,20 @@ namespace QuantLib {
                   CalibratedModel* model,
                   const std::vector<boost::shared_ptr<CalibrationHelper> >&
                                                                   instruments,
-                  const std::vector<Real>& weights)
+                  const std::vector<Real>& weights,
+                  bool parallel = false)
         : model_(model, no_deletion), instruments_(instruments),
-          weights_(weights) {}
+          weights_(weights), parallel_(parallel) {}
 
         virtual ~CalibrationFunction() {}
 
         virtual Real value(const Array& params) const {
             model_->setParams(params);
 
+            std::vector<Real> errors = calibrationErrors();
             Real value = 0.0;
             for (Size i=0; i<instruments_.size(); i++) {
-                Real diff = instruments_[i]->calibrationError();
+                Real diff = errors[i];
                 value += diff*diff*weights_[i];
             }
 
@@ -58,10 +63,10 @@ namespace QuantLib {
         virtual Disposable<Array> values(const Array& params) const {
             model_->setParams(params);
 
+            std::vector<Real> errors = calibrationErrors();
             Array values(instruments_.size());
             for (Size i=0; i<instruments_.size(); i++) {
-                values[i] = instruments_[i]->calibrationError()
-                           *std::sqrt(weights_[i]);
+                values[i] = errors[i]*std::sqrt(weights_[i]);
             }
 
             return values;
@@ -69,9 +74,34 @@ namespace QuantLib {
 
         virtual Real finiteDifferenceEpsilon() const { return 1e-6; }
       private:
+        std::vector<Real> calibrationErrors() const {
+            std::vector<Real> errors(instruments_.size());
+            if (!parallel_) {
+                for (Size i=0; i<instruments_.size(); i++)
+                    errors[i] = instruments_[i]->calibrationError();
+                return errors;
+            }
+
+            Integer n = Integer(instruments_.size());
+            ParallelErrors failures;
+            #if defined(_OPENMP)
+            #pragma omp parallel for schedule(dynamic)
+            #endif
+            for (Integer i=0; i<n; i++) {
+                try {
+                    errors[i] = instruments_[i]->calibrationError();
+                } catch (...) {
+                    failures.record(i);
+                }
+            }
+            failures.rethrow("helper");
+            return errors;
+        }
+
         boost::shared_ptr<CalibratedModel> model_;
         const std::vector<boost::shared_ptr<CalibrationHelper> >& instruments_;
         std::vector<Real> weights_;
+        bool parallel_;
     };
 
     void CalibratedModel::calibrate(
@@ -79,12 +109,25 @@ namespace QuantLib {
         OptimizationMethod& method,
         const EndCriteria& endCriteria,
         const Constraint& additionalConstraint,
-        const std::vector<Real>& weights) {
+        const std::vector<Real>& weights,
+        bool parallelEvaluation) {
 
         QL_REQUIRE(weights.empty() ||
                    weights.size() == instruments.size(),
                    "mismatch between number of instruments and weights");
 
+        if (parallelEvaluation) {
+            std::set<PricingEngine*> engines;
+            for (Size i=0; i<instruments.size(); i++) {
+                PricingEngine* engine = instruments[i]->pricingEngine().get();
+                QL_REQUIRE(engine, "no pricing engine set for helper " << i);
+                QL_REQUIRE(engines.insert(engine).second,
+                           "helper " << i << " shares its pricing engine "
+                           "with another helper; parallel evaluation "
+                           "requires separate engines");
+            }
+        }
+
         Constraint c;
         if (additionalConstraint.empty())
             c = *constraint_;
@@ -93,7 +136,7 @@ namespace QuantLib {
         std::vector<Real> w = weights.empty() ?
                               std::vector<Real>(instruments.size(), 1.0):
                               weights;
-        CalibrationFunction f(this, instruments, w);
+        CalibrationFunction f(this, instruments, w, parallelEvaluation);
 
         Problem prob(f, c, params());
         shortRateEndCriteria_ = method.minimize(prob, endCriteria);
@@ -88,13 +88,26 @@ namespace QuantLib {
         //! Calibrate to a set of market instruments (caps/swaptions)
         /*! An additional constraint can be passed which must be
             satisfied in addition to the constraints of the model.
+
+            If parallelEvaluation is true and the library was
+            compiled with OpenMP support (see the --enable-openmp
+            configure switch) the helpers are priced concurrently at
+            each evaluation of the cost function.  The errors are
+            summed in a fixed order, so that the results don't depend
+            on thread scheduling.
+
+            \warning In parallel mode, each helper must have its own
+                     pricing engine instance, and any market data
+                     shared by the helpers (e.g., bootstrapped curves)
+                     should be already calculated.
         */
         void calibrate(
                    const std::vector<boost::shared_ptr<CalibrationHelper> >&,
                    OptimizationMethod& method,
                    const EndCriteria& endCriteria,
                    const Constraint& constraint = Constraint(),
-                   const std::vector<Real>& weights = std::vector<Real>());
+                   const std::vector<Real>& weights = std::vector<Real>(),
+                   bool parallelEvaluation = false);
 
         Real value(const Array& params,
                    const std::vector<boost::shared_ptr<CalibrationHelper> >&);
@@ -37,13 +37,45 @@ namespace QuantLib {
         registerWith(termStructure);
     }
 
+    namespace {
+
+        // beyond this, the cache is emptied before adding a new grid
+        const Size maxCachedTrees = 50;
+
+    }
+
     boost::shared_ptr<Lattice> HullWhite::tree(const TimeGrid& grid) const {
 
+        // the cache is only accessed inside critical sections, since
+        // engines might request trees concurrently during a parallel
+        // calibration; the trees are built outside of them.
+        std::vector<Time> times(grid.begin(), grid.end());
+        CachedTree entry;
+        #if defined(_OPENMP)
+        #pragma omp critical(hullwhite_tree_cache)
+        #endif
+        {
+            std::map<std::vector<Time>, CachedTree>::const_iterator cached =
+                treeCache_.find(times);
+            if (cached != treeCache_.end())
+                entry = cached->second;
+        }
+
+        if (entry.fitted && entry.a == a() && entry.sigma == sigma())
+            return entry.fitted;
+
         TermStructureFittingParameter phi(termStructure());
         boost::shared_ptr<ShortRateDynamics> numericDynamics(
                                              new Dynamics(phi, a(), sigma()));
-        boost::shared_ptr<TrinomialTree> trinomial(
+        // the branching only depends on a and sigma, not on the
+        // term structure; it is rebuilt only when they change
+        if (!entry.trinomial || entry.a != a() || entry.sigma != sigma()) {
+            entry.trinomial = boost::shared_ptr<TrinomialTree>(
                          new TrinomialTree(numericDynamics->process(), grid));
+            entry.a = a();
+            entry.sigma = sigma();
+        }
+        boost::shared_ptr<TrinomialTree> trinomial = entry.trinomial;
         boost::shared_ptr<ShortRateTree> numericTree(
                          new ShortRateTree(trinomial, numericDynamics, grid));
 
@@ -66,6 +98,20 @@ namespace QuantLib {
             value = std::log(value/discountBond)/dt;
             impl->set(grid[i], value);
         }
+        // the cached tree is shared by the engines using this grid;
+        // the state prices are completed now, so that they won't be
+        // extended lazily (and concurrently) while pricing
+        numericTree->statePrices(grid.size()-1);
+        entry.fitted = numericTree;
+        #if defined(_OPENMP)
+        #pragma omp critical(hullwhite_tree_cache)
+        #endif
+        {
+            if (treeCache_.size() >= maxCachedTrees
+                && treeCache_.find(times) == treeCache_.end())
+                treeCache_.clear();
+            treeCache_[times] = entry;
+        }
         return numericTree;
     }
 
@@ -81,6 +127,11 @@ namespace QuantLib {
 
     void HullWhite::generateArguments() {
         phi_ = FittingParameter(termStructure(), a(), sigma());
+        // cached trees must be refitted; the branching is kept and
+        // checked against the parameters when the tree is requested
+        std::map<std::vector<Time>, CachedTree>::iterator i;
+        for (i = treeCache_.begin(); i != treeCache_.end(); ++i)
+            i->second.fitted.reset();
     }
 
     Real HullWhite::discountBondOption(Option::Type type, Real strike,
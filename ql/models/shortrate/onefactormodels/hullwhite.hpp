@@ -27,6 +27,7 @@
 #define quantlib_hull_white_hpp
 
 #include <ql/models/shortrate/onefactormodels/vasicek.hpp>
+#include <map>
 
 namespace QuantLib {
 
@@ -40,6 +41,14 @@ namespace QuantLib {
 
         \test calibration results are tested against cached values
 
+        Trees returned by the tree() method are cached by time grid.
+        As long as the model parameters and the term structure don't
+        change, the same fitted tree is returned; when only the term
+        structure changes, the trinomial branching is reused and only
+        the fitting parameter is recalculated.  The state prices of
+        the returned trees are fully calculated, so that they can be
+        used by several engines at the same time.
+
         \bug When the term structure is relinked, the r0 parameter of
              the underlying Vasicek model is not updated.
 
@@ -82,6 +91,13 @@ namespace QuantLib {
         class FittingParameter;
 
         Parameter phi_;
+
+        struct CachedTree {
+            Real a, sigma;
+            boost::shared_ptr<TrinomialTree> trinomial;
+            boost::shared_ptr<ShortRateTree> fitted;
+        };
+        mutable std::map<std::vector<Time>, CachedTree> treeCache_;
     };
 
     //! Short-rate dynamics in the Hull-White model
@@ -43,7 +43,7 @@ namespace QuantLib {
         friend class Observer;
       public:
         // constructors, assignment, destructor
-        Observable() {}
+        Observable() : synchronized_(false) {}
         Observable(const Observable&);
         Observable& operator=(const Observable&);
         virtual ~Observable() {}
@@ -51,11 +51,35 @@ namespace QuantLib {
             or when the programmer desires to notify any changes.
         */
         void notifyObservers();
+      protected:
+        /*! if synchronized is true and the library is compiled with
+            OpenMP support, observers can register and unregister
+            from several threads at once.
+        */
+        explicit Observable(bool synchronized)
+        : synchronized_(synchronized) {}
       private:
         typedef std::set<Observer*>::iterator iterator;
         std::pair<iterator, bool> registerObserver(Observer*);
         Size unregisterObserver(Observer*);
         std::set<Observer*> observers_;
+        bool synchronized_;
+    };
+
+    //! %Observable shared by the whole library
+    /*! Used for global data such as the evaluation date and the
+        index fixings, which objects in independent market graphs
+        (e.g., the ones repriced by scenarioNPVs()) can register with
+        from different threads.  If the library is compiled with
+        OpenMP support, registration is serialized; notification is
+        not, so that the global data must not be changed while other
+        threads are using them.
+
+        \ingroup patterns
+    */
+    class GlobalObservable : public Observable {
+      public:
+        GlobalObservable() : Observable(true) {}
     };
 
     //! Object that gets notified when a given observable changes
@@ -85,7 +109,8 @@ namespace QuantLib {
 
     // inline definitions
 
-    inline Observable::Observable(const Observable&) {
+    inline Observable::Observable(const Observable& o)
+    : synchronized_(o.synchronized_) {
         // the observer set is not copied; no observer asked to
         // register with this object
     }
@@ -108,10 +133,26 @@ namespace QuantLib {
 
     inline std::pair<std::set<Observer*>::iterator, bool>
     Observable::registerObserver(Observer* o) {
+        #if defined(_OPENMP)
+        if (synchronized_) {
+            std::pair<iterator, bool> result;
+            #pragma omp critical(ql_observable_registration)
+            result = observers_.insert(o);
+            return result;
+        }
+        #endif
         return observers_.insert(o);
     }
 
     inline Size Observable::unregisterObserver(Observer* o) {
+        #if defined(_OPENMP)
+        if (synchronized_) {
+            Size result;
+            #pragma omp critical(ql_observable_registration)
+            result = observers_.erase(o);
+            return result;
+        }
+        #endif
         return observers_.erase(o);
     }
 
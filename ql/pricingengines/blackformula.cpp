@@ -25,6 +25,7 @@
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/math/solvers1d/newtonsafe.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
+#include <ql/utilities/parallelerrors.hpp>
 
 namespace {
     void checkParameters(QuantLib::Real strike,
@@ -265,6 +266,264 @@ namespace QuantLib {
             forward, blackPrice, discount, displacement, guess, accuracy, maxIterations);
     }
 
+    namespace {
+
+        Size batchSize(const std::vector<Real>& strikes,
+                       const std::vector<Real>& forwards,
+                       const std::vector<Real>& values,
+                       const std::vector<Real>& discounts) {
+            const Size n = strikes.size();
+            QL_REQUIRE(forwards.size() == n || forwards.size() == 1,
+                       "wrong number of forwards (" << forwards.size()
+                       << ") for " << n << " strikes");
+            QL_REQUIRE(values.size() == n || values.size() == 1,
+                       "wrong number of values (" << values.size()
+                       << ") for " << n << " strikes");
+            QL_REQUIRE(discounts.size() == n || discounts.size() <= 1,
+                       "wrong number of discounts (" << discounts.size()
+                       << ") for " << n << " strikes");
+            return n;
+        }
+
+        inline Real element(const std::vector<Real>& v, Size i,
+                            Real defaultValue = 1.0) {
+            return v.empty() ? defaultValue : v[v.size() == 1 ? 0 : i];
+        }
+
+        // normalised out-of-the-money Black call, x = log(F/K) <= 0
+        inline Real normalisedBlack(Real x, Real s,
+                                    const CumulativeNormalDistribution& N) {
+            if (s == 0.0)
+                return 0.0;
+            const Real d1 = x/s + 0.5*s, d2 = d1 - s;
+            return std::max(Real(0.0), std::exp(0.5*x)*N(d1)
+                                       - std::exp(-0.5*x)*N(d2));
+        }
+
+        inline Real normalisedVega(Real x, Real s) {
+            if (s == 0.0)
+                return 0.0;
+            return M_1_SQRTPI*M_SQRT1_2*std::exp(-0.5*(x*x/(s*s)+0.25*s*s));
+        }
+
+        /* solves normalisedBlack(x, s) = beta for s, x <= 0 and
+           0 < beta < exp(x/2) */
+        Real normalisedImpliedStdDev(Real x, Real beta,
+                                     Real accuracy, Natural maxIterations,
+                                     const CumulativeNormalDistribution& N,
+                                     const InverseCumulativeNormal& invN) {
+            const Real bMax = std::exp(0.5*x);
+
+            // initial guess (P. Jaeckel, "By Implication", 2006)
+            const Real sc = std::sqrt(2.0*std::fabs(x));
+            const Real bc = normalisedBlack(x, sc, N);
+            const bool lower = (beta < bc);
+
+            Real s;
+            if (lower)
+                s = std::sqrt(2.0*x*x/(std::fabs(x)-4.0*std::log(beta/bc)));
+            else
+                s = std::min(Real(-2.0*invN((bMax-beta)/(bMax-bc)
+                                   * N(-std::sqrt(0.5*std::fabs(x))))),
+                             Real(100.0));
+
+            // Householder iterations on log(b) below the inflection
+            // point and on b above it, safeguarded by bisection
+            Real lo = 0.0, hi = QL_MAX_REAL;
+            for (Natural i=0; i < maxIterations; ++i) {
+                const Real b = normalisedBlack(x, s, N);
+                const Real vega = normalisedVega(x, s);
+                if (b == beta)
+                    return s;
+                if (b > beta)
+                    hi = s;
+                else
+                    lo = s;
+
+                Real step;
+                const Real h2 = x*x/(s*s*s) - 0.25*s;
+                const Real h3 = h2*h2 - 3.0*x*x/(s*s*s*s) - 0.25;
+                if (lower && b > 0.0) {
+                    const Real r = vega/b;
+                    const Real nu = -std::log(b/beta)/r;
+                    const Real g2 = h2 - r;
+                    const Real g3 = h3 - 3.0*h2*r + 2.0*r*r;
+                    const Real den = 1.0 + nu*(g2 + g3*nu/6.0);
+                    step = (den > 0.0) ? nu*(1.0 + 0.5*g2*nu)/den : nu;
+                } else if (vega > 0.0) {
+                    const Real nu = (beta - b)/vega;
+                    const Real den = 1.0 + nu*(h2 + h3*nu/6.0);
+                    step = (den > 0.0) ? nu*(1.0 + 0.5*h2*nu)/den : nu;
+                } else {
+                    step = QL_MAX_REAL;
+                }
+
+                if (std::fabs(step) < accuracy)
+                    return s + step;
+
+                Real sNew = s + step;
+                if (!(sNew > lo && sNew < hi))
+                    sNew = (hi < QL_MAX_REAL) ? 0.5*(lo+hi) : 2.0*s;
+
+                const bool converged = std::fabs(sNew - s) < accuracy;
+                s = sNew;
+                if (converged)
+                    return s;
+            }
+            QL_FAIL("maximum number of iterations (" << maxIterations
+                    << ") exceeded, last stdDev " << s);
+        }
+
+    }
+
+    std::vector<Real> blackFormula(Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& stdDevs,
+                                   const std::vector<Real>& discounts,
+                                   Real displacement) {
+        const Size n = batchSize(strikes, forwards, stdDevs, discounts);
+        for (Size i=0; i < n; ++i) {
+            checkParameters(strikes[i], element(forwards, i), displacement);
+            QL_REQUIRE(element(stdDevs, i) >= 0.0,
+                       "stdDev (" << element(stdDevs, i)
+                       << ") must be non-negative");
+            QL_REQUIRE(element(discounts, i) > 0.0,
+                       "discount (" << element(discounts, i)
+                       << ") must be positive");
+        }
+
+        std::vector<Real> result(n);
+        const CumulativeNormalDistribution phi;
+        #if defined(_OPENMP)
+        #pragma omp parallel for if (n > 10000)
+        #endif
+        for (Integer i=0; i < Integer(n); ++i) {
+            const Real forward = element(forwards, i) + displacement;
+            const Real strike = strikes[i] + displacement;
+            const Real stdDev = element(stdDevs, i);
+            const Real discount = element(discounts, i);
+
+            if (stdDev == 0.0 || strike == 0.0) {
+                result[i] = std::max((forward-strike)*optionType, Real(0.0))
+                          * discount;
+            } else {
+                const Real d1 = std::log(forward/strike)/stdDev + 0.5*stdDev;
+                const Real d2 = d1 - stdDev;
+                result[i] = std::max(Real(0.0), discount * optionType *
+                    (forward*phi(optionType*d1) - strike*phi(optionType*d2)));
+            }
+        }
+        return result;
+    }
+
+    std::vector<Real> blackFormulaStdDevDerivative(
+                                        const std::vector<Real>& strikes,
+                                        const std::vector<Real>& forwards,
+                                        const std::vector<Real>& stdDevs,
+                                        const std::vector<Real>& discounts,
+                                        Real displacement) {
+        const Size n = batchSize(strikes, forwards, stdDevs, discounts);
+        for (Size i=0; i < n; ++i) {
+            checkParameters(strikes[i], element(forwards, i), displacement);
+            QL_REQUIRE(element(stdDevs, i) >= 0.0,
+                       "stdDev (" << element(stdDevs, i)
+                       << ") must be non-negative");
+            QL_REQUIRE(element(discounts, i) > 0.0,
+                       "discount (" << element(discounts, i)
+                       << ") must be positive");
+        }
+
+        std::vector<Real> result(n);
+        const CumulativeNormalDistribution phi;
+        #if defined(_OPENMP)
+        #pragma omp parallel for if (n > 10000)
+        #endif
+        for (Integer i=0; i < Integer(n); ++i) {
+            const Real forward = element(forwards, i) + displacement;
+            const Real strike = strikes[i] + displacement;
+            const Real stdDev = element(stdDevs, i);
+            const Real discount = element(discounts, i);
+
+            if (stdDev == 0.0) {
+                result[i] = (forward > strike) ? discount*forward : 0.0;
+            } else {
+                const Real d1 = std::log(forward/strike)/stdDev + 0.5*stdDev;
+                result[i] = discount*forward*phi.derivative(d1);
+            }
+        }
+        return result;
+    }
+
+    std::vector<Real> blackFormulaImpliedStdDev(
+                                        Option::Type optionType,
+                                        const std::vector<Real>& strikes,
+                                        const std::vector<Real>& forwards,
+                                        const std::vector<Real>& blackPrices,
+                                        const std::vector<Real>& discounts,
+                                        Real displacement,
+                                        Real accuracy,
+                                        Natural maxIterations) {
+        const Size n = batchSize(strikes, forwards, blackPrices, discounts);
+
+        // out-of-the-money normalised prices and log-moneyness
+        std::vector<Real> x(n), beta(n);
+        for (Size i=0; i < n; ++i) {
+            const Real strike = strikes[i];
+            const Real forward = element(forwards, i);
+            const Real blackPrice = element(blackPrices, i);
+            const Real discount = element(discounts, i);
+
+            checkParameters(strike, forward, displacement);
+            QL_REQUIRE(discount>0.0,
+                       "discount (" << discount << ") must be positive");
+            QL_REQUIRE(blackPrice>=0.0,
+                       "option price (" << blackPrice
+                       << ") must be non-negative");
+            const Real otherOptionPrice =
+                blackPrice - optionType*(forward-strike)*discount;
+            QL_REQUIRE(otherOptionPrice>=0.0,
+                       "negative " << Option::Type(-1*optionType) <<
+                       " price (" << otherOptionPrice <<
+                       ") implied by put-call parity. No solution exists for "
+                       << optionType << " strike " << strike <<
+                       ", forward " << forward <<
+                       ", price " << blackPrice <<
+                       ", deflator " << discount);
+
+            const Real F = forward + displacement, K = strike + displacement;
+            QL_REQUIRE(K > 0.0, "positive displaced strike required");
+            const Real otmPrice = (optionType*(forward-strike) > 0.0)
+                                  ? otherOptionPrice : blackPrice;
+            x[i] = -std::fabs(std::log(F/K));
+            beta[i] = otmPrice/(discount*std::sqrt(F*K));
+            QL_REQUIRE(beta[i] < std::exp(0.5*x[i]),
+                       "option price (" << blackPrice << ") above the "
+                       "upper bound for " << optionType << " strike "
+                       << strike << ", forward " << forward);
+        }
+
+        std::vector<Real> result(n);
+        const CumulativeNormalDistribution N;
+        const InverseCumulativeNormal invN;
+        ParallelErrors errors;
+        #if defined(_OPENMP)
+        #pragma omp parallel for if (n > 1000)
+        #endif
+        for (Integer i=0; i < Integer(n); ++i) {
+            try {
+                result[i] = (beta[i] > 0.0)
+                    ? normalisedImpliedStdDev(x[i], beta[i], accuracy,
+                                              maxIterations, N, invN)
+                    : 0.0;
+            } catch (...) {
+                errors.record(i);
+            }
+        }
+        errors.rethrow("implied volatility for option");
+        return result;
+    }
+
     Real blackFormulaCashItmProbability(Option::Type optionType,
                                         Real strike,
                                         Real forward,
@@ -31,6 +31,7 @@
 
 #include <ql/option.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -112,6 +113,60 @@ namespace QuantLib {
                         Natural maxIterations = 100);
 
 
+    /*! Black 1976 formula for a batch of options of the same type.
+
+        The forwards, standard deviations and discounts can be given
+        either for each strike or as a single value used for all of
+        them; an empty vector of discounts means no discounting.
+
+        \warning instead of volatility it uses standard deviation,
+                 i.e. volatility*sqrt(timeToMaturity)
+    */
+    std::vector<Real> blackFormula(
+                    Option::Type optionType,
+                    const std::vector<Real>& strikes,
+                    const std::vector<Real>& forwards,
+                    const std::vector<Real>& stdDevs,
+                    const std::vector<Real>& discounts = std::vector<Real>(),
+                    Real displacement = 0.0);
+
+    /*! Black 1976 formula for standard deviation derivative for a
+        batch of options; the arguments follow the batched
+        blackFormula above.
+    */
+    std::vector<Real> blackFormulaStdDevDerivative(
+                    const std::vector<Real>& strikes,
+                    const std::vector<Real>& forwards,
+                    const std::vector<Real>& stdDevs,
+                    const std::vector<Real>& discounts = std::vector<Real>(),
+                    Real displacement = 0.0);
+
+    /*! Black 1976 implied standard deviations for a batch of options
+        of the same type; the arguments follow the batched
+        blackFormula above.
+
+        Each price is mapped onto the normalised out-of-the-money
+        Black function. The initial guess is the rational/asymptotic
+        approximation of P. Jaeckel, "By Implication" (2006), which is
+        refined by third-order Householder iterations (safeguarded by
+        bisection) so that two or three iterations usually reach
+        machine precision. No solver object is created per option.
+
+        As in the scalar version, an exception is thrown if any of
+        the options doesn't converge within the given number of
+        iterations; its message reports the index of the first one.
+    */
+    std::vector<Real> blackFormulaImpliedStdDev(
+                    Option::Type optionType,
+                    const std::vector<Real>& strikes,
+                    const std::vector<Real>& forwards,
+                    const std::vector<Real>& blackPrices,
+                    const std::vector<Real>& discounts = std::vector<Real>(),
+                    Real displacement = 0.0,
+                    Real accuracy = 1.0e-12,
+                    Natural maxIterations = 32);
+
+
     /*! Black 1976 probability of being in the money (in the bond martingale
         measure), i.e. N(d2).
         It is a risk-neutral probability, not the real world one.
@@ -0,0 +1,201 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file richardsonextrapolationengine.hpp
+    \brief Richardson extrapolation of the results of grid-based engines
+*/
+
+#ifndef quantlib_richardson_extrapolation_engine_hpp
+#define quantlib_richardson_extrapolation_engine_hpp
+
+#include <ql/instruments/oneassetoption.hpp>
+#include <ql/utilities/null.hpp>
+#include <ql/utilities/parallelerrors.hpp>
+#include <cmath>
+#include <set>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Richardson extrapolation of the results of grid-based engines
+    /*! The instrument is priced with each of the passed engines, and
+        value, delta, gamma and theta are extrapolated to zero grid
+        spacing.  The engines must be ordered from the coarsest to the
+        finest; the grids of each engine, both in time and in space,
+        must be finer than those of the previous one by the given
+        refinement ratio, e.g., a finite-difference engine with
+        (tGrid, xGrid) followed by one with (2*tGrid, 2*xGrid).
+
+        With \f$ n \f$ engines, the Romberg tableau removes the error
+        terms of order \f$ p, p+q, \dots, p+(n-2)q \f$, where
+        \f$ p \f$ is the given order of convergence of the engines
+        and \f$ q \f$ the order step between the terms of their error
+        expansion.  Unless given, the step is 2 for second-order
+        engines, whose error expansion (as for Crank-Nicolson-like
+        schemes on smooth payoffs) contains even powers only, and 1
+        otherwise.  The last correction applied to the value is
+        returned as the error estimate.  Greeks are only extrapolated
+        if all the engines calculate them.
+
+        If parallelEvaluation is true and the library was compiled
+        with OpenMP support, the engines are run concurrently, the
+        finest one first.
+
+        \warning In parallel mode, the engines must be distinct
+                 instances (this is checked), and any market data
+                 shared by them (e.g., bootstrapped curves) should be
+                 already calculated.
+
+        \ingroup vanillaengines
+
+        \test the extrapolated value is checked against the analytic
+              Black-Scholes value for a European option and for a
+              barrier option, whose finite-difference prices
+              converge with first order.
+    */
+    template <class ArgumentsType,
+              class ResultsType = OneAssetOption::results>
+    class RichardsonExtrapolationEngine
+        : public GenericEngine<ArgumentsType, ResultsType> {
+      public:
+        RichardsonExtrapolationEngine(
+              const std::vector<boost::shared_ptr<PricingEngine> >& engines,
+              Real refinementRatio = 2.0,
+              Real order = 2.0,
+              bool parallelEvaluation = false,
+              Real orderStep = Null<Real>());
+        void calculate() const;
+      private:
+        Real extrapolate(const std::vector<Real>& values,
+                         Real& errorEstimate) const;
+
+        const std::vector<boost::shared_ptr<PricingEngine> > engines_;
+        const Real refinementRatio_, order_;
+        const bool parallelEvaluation_;
+        const Real orderStep_;
+    };
+
+
+    // template definitions
+
+    template <class A, class R>
+    RichardsonExtrapolationEngine<A, R>::RichardsonExtrapolationEngine(
+              const std::vector<boost::shared_ptr<PricingEngine> >& engines,
+              Real refinementRatio, Real order, bool parallelEvaluation,
+              Real orderStep)
+    : engines_(engines), refinementRatio_(refinementRatio), order_(order),
+      parallelEvaluation_(parallelEvaluation),
+      orderStep_(orderStep != Null<Real>() ? orderStep :
+                 (order == 2.0 ? 2.0 : 1.0)) {
+        QL_REQUIRE(engines_.size() > 1, "at least two engines required");
+        QL_REQUIRE(refinementRatio_ > 1.0,
+                   "refinement ratio (" << refinementRatio_
+                   << ") must be greater than one");
+        QL_REQUIRE(order_ > 0.0,
+                   "order (" << order_ << ") must be positive");
+        QL_REQUIRE(orderStep_ > 0.0,
+                   "order step (" << orderStep_ << ") must be positive");
+        for (Size i=0; i < engines_.size(); ++i) {
+            QL_REQUIRE(engines_[i], "null engine at position " << i);
+            this->registerWith(engines_[i]);
+        }
+    }
+
+    template <class A, class R>
+    void RichardsonExtrapolationEngine<A, R>::calculate() const {
+        const Integer n = Integer(engines_.size());
+
+        if (parallelEvaluation_) {
+            std::set<PricingEngine*> engines;
+            for (Integer i=0; i < n; ++i)
+                QL_REQUIRE(engines.insert(engines_[i].get()).second,
+                           "engine " << i << " is passed more than once; "
+                           "parallel evaluation requires separate engines");
+        }
+
+        std::vector<const R*> results(n);
+        ParallelErrors errors;
+
+        // the finest engines are the slowest and are started first
+        #if defined(_OPENMP)
+        #pragma omp parallel for schedule(dynamic) if (parallelEvaluation_)
+        #endif
+        for (Integer j=0; j < n; ++j) {
+            const Integer i = n-1-j;
+            try {
+                engines_[i]->reset();
+                A* arguments = dynamic_cast<A*>(engines_[i]->getArguments());
+                QL_REQUIRE(arguments, "wrong argument type");
+                *arguments = this->arguments_;
+                engines_[i]->calculate();
+                results[i] = dynamic_cast<const R*>(engines_[i]->getResults());
+                QL_REQUIRE(results[i], "wrong result type");
+            } catch (...) {
+                errors.record(i);
+            }
+        }
+        errors.rethrow("engine");
+
+        std::vector<Real> value(n), delta(n), gamma(n), theta(n);
+        bool hasDelta = true, hasGamma = true, hasTheta = true;
+        for (Integer i=0; i < n; ++i) {
+            value[i] = results[i]->value;
+            delta[i] = results[i]->delta;
+            gamma[i] = results[i]->gamma;
+            theta[i] = results[i]->theta;
+            QL_REQUIRE(value[i] != Null<Real>(),
+                       "engine " << i << " did not calculate the value");
+            hasDelta = hasDelta && delta[i] != Null<Real>();
+            hasGamma = hasGamma && gamma[i] != Null<Real>();
+            hasTheta = hasTheta && theta[i] != Null<Real>();
+        }
+
+        Real errorEstimate;
+        if (hasDelta)
+            this->results_.delta = extrapolate(delta, errorEstimate);
+        if (hasGamma)
+            this->results_.gamma = extrapolate(gamma, errorEstimate);
+        if (hasTheta)
+            this->results_.theta = extrapolate(theta, errorEstimate);
+        this->results_.value = extrapolate(value, errorEstimate);
+        this->results_.errorEstimate = errorEstimate;
+    }
+
+    template <class A, class R>
+    Real RichardsonExtrapolationEngine<A, R>::extrapolate(
+                                          const std::vector<Real>& values,
+                                          Real& errorEstimate) const {
+        // the Romberg tableau is built in place, one column at a time
+        std::vector<Real> t(values);
+        errorEstimate = 0.0;
+        for (Size k=1; k < t.size(); ++k) {
+            const Real f = std::pow(refinementRatio_,
+                                    order_ + (k-1)*orderStep_) - 1.0;
+            for (Size i=t.size()-1; i >= k; --i) {
+                const Real correction = (t[i] - t[i-1])/f;
+                t[i] += correction;
+                if (i == t.size()-1)
+                    errorEstimate = std::fabs(correction);
+            }
+        }
+        return t.back();
+    }
+
+}
+
+
+#endif
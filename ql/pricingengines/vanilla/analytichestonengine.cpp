@@ -72,6 +72,16 @@ namespace QuantLib {
 
         Real operator()(Real phi)      const;
 
+        /* strike-independent part of the integrand. For phi != 0 the
+           integrand is exp(a + i*phi*(dd-sx)).imag()/phi, for phi == 0
+           it is a.real() + dd - sx, where a is the returned value.
+           Since the branch counter is updated, calls must follow the
+           order of the integration nodes.
+        */
+        std::complex<Real> exponent(Real phi) const;
+
+        Real dd() const { return dd_; }
+
     private:
         const Size j_;
         //     const VanillaOption::arguments& arg_;
@@ -169,6 +179,17 @@ namespace QuantLib {
 
 
     Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
+    {
+        const std::complex<Real> a = exponent(phi);
+        if (cpxLog_ == Gatheral && phi == 0.0)
+            return dd_-sx_ + a.real();
+        else
+            return std::exp(a + std::complex<Real>(0.0, phi*(dd_-sx_))
+                            ).imag()/phi;
+    }
+
+    std::complex<Real>
+    AnalyticHestonEngine::Fj_Helper::exponent(Real phi) const
     {
         const Real rpsig(rsigma_*phi);
 
@@ -178,7 +199,7 @@ namespace QuantLib {
                       *std::complex<Real>(-phi, (j_== 1)? 1 : -1));
         const std::complex<Real> ex = std::exp(-d*term_);
         const std::complex<Real> addOnTerm
-            = engine_ > 0 ? engine_->addOnTerm(phi, term_, j_) : 0.0;
+            = engine_ != 0 ? engine_->addOnTerm(phi, term_, j_) : 0.0;
 
         if (cpxLog_ == Gatheral) {
             if (phi != 0.0) {
@@ -187,12 +208,9 @@ namespace QuantLib {
                     const std::complex<Real> g
                                             = std::log((1.0 - p*ex)/(1.0 - p));
 
-                    return
-                        std::exp(v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
-                                 + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
+                    return v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
+                         + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
+                         + addOnTerm;
                 }
                 else {
                     const std::complex<Real> td = phi/(2.0*t1)
@@ -200,12 +218,9 @@ namespace QuantLib {
                     const std::complex<Real> p = td*sigma2_/(t1+d);
                     const std::complex<Real> g = p*(1.0-ex);
 
-                    return
-                        std::exp(v0_*td*(1.0-ex)/(1.0-p*ex)
-                                 + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
+                    return v0_*td*(1.0-ex)/(1.0-p*ex)
+                         + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
+                         + addOnTerm;
                 }
             }
             else {
@@ -213,18 +228,17 @@ namespace QuantLib {
                 if (j_ == 1) {
                     const Real kmr = rsigma_-kappa_;
                     if (std::fabs(kmr) > 1e-7) {
-                        return dd_-sx_
-                            + (std::exp(kmr*term_)*kappa_*theta_
+                        return (std::exp(kmr*term_)*kappa_*theta_
                                -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
                             - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
                     }
                     else
                         // \kappa = \rho * \sigma
-                        return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
-                                       + 0.5*v0_*term_;
+                        return 0.25*kappa_*theta_*term_*term_
+                            + 0.5*v0_*term_;
                 }
                 else {
-                    return dd_-sx_
+                    return
                         - (std::exp(-kappa_*term_)*kappa_*theta_
                            +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
                         - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
@@ -274,11 +288,9 @@ namespace QuantLib {
             g_km1_ = g.imag();
             g += std::complex<Real>(0, 2*b_*M_PI);
 
-            return std::exp(v0_*(t1+d)*(ex-1.0)/(sigma2_*(ex-p))
-                            + (kappa_*theta_)/sigma2_*((t1+d)*term_-2.0*g)
-                            + std::complex<Real>(0,phi*(dd_-sx_))
-                            + addOnTerm
-                            ).imag()/phi;
+            return v0_*(t1+d)*(ex-1.0)/(sigma2_*(ex-p))
+                + (kappa_*theta_)/sigma2_*((t1+d)*term_-2.0*g)
+                + addOnTerm;
         }
         else {
             QL_FAIL("unknown complex logarithm formula");
@@ -419,6 +431,97 @@ namespace QuantLib {
     }
 
 
+    std::vector<Real> AnalyticHestonEngine::calculate(
+                const Date& maturity,
+                const std::vector<boost::shared_ptr<PlainVanillaPayoff> >&
+                                                             payoffs) const {
+        QL_REQUIRE(!integration_->isAdaptiveIntegration(),
+                   "multi-strike pricing requires a non-adaptive "
+                   "integration algorithm");
+
+        const boost::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(maturity);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(maturity);
+        const Real ratio = riskFreeDiscount/dividendDiscount;
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Time term = process->time(maturity);
+        const Real kappa = model_->kappa(), theta = model_->theta();
+        const Real sigma = model_->sigma(), v0 = model_->v0();
+        const Real rho = model_->rho();
+
+        const Real c_inf = std::min(10.0, std::max(0.0001,
+                std::sqrt(1.0-square<Real>()(rho))/sigma))
+                *(v0 + kappa*theta*term);
+
+        std::vector<Real> phi, w;
+        integration_->nodesAndWeights(c_inf, phi, w);
+        const Size n = phi.size();
+
+        // strike-independent part, evaluated once per node. The
+        // exponentials are stored as separate real and imaginary
+        // parts so that the loop over strikes is plain real arithmetic.
+        const Fj_Helper f1(kappa, theta, sigma, v0, spotPrice, rho,
+                           this, cpxLog_, term, spotPrice, ratio, 1);
+        const Fj_Helper f2(kappa, theta, sigma, v0, spotPrice, rho,
+                           this, cpxLog_, term, spotPrice, ratio, 2);
+        std::vector<Real> re1(n), im1(n), re2(n), im2(n);
+        Real limit1 = 0.0, limit2 = 0.0, weightAtZero = 0.0;
+        for (Size k=0; k<n; ++k) {
+            const std::complex<Real> a1 = f1.exponent(phi[k]);
+            const std::complex<Real> a2 = f2.exponent(phi[k]);
+            if (phi[k] == 0.0) {
+                // the integrand is affine in the strike term here
+                re1[k] = im1[k] = re2[k] = im2[k] = 0.0;
+                limit1 += w[k]*a1.real();
+                limit2 += w[k]*a2.real();
+                weightAtZero += w[k];
+            } else {
+                const std::complex<Real> e1 = std::exp(a1)*(w[k]/phi[k]);
+                const std::complex<Real> e2 = std::exp(a2)*(w[k]/phi[k]);
+                re1[k] = e1.real(); im1[k] = e1.imag();
+                re2[k] = e2.real(); im2[k] = e2.imag();
+            }
+        }
+
+        evaluations_ = 2*n;
+        const Real dd = f1.dd();
+        std::vector<Real> values(payoffs.size());
+        for (Size i=0; i<payoffs.size(); ++i) {
+            const Real strikePrice = payoffs[i]->strike();
+            const Real z = dd - std::log(strikePrice);
+
+            Real p1 = limit1 + weightAtZero*z, p2 = limit2 + weightAtZero*z;
+            for (Size k=0; k<n; ++k) {
+                const Real c = std::cos(phi[k]*z), s = std::sin(phi[k]*z);
+                p1 += re1[k]*s + im1[k]*c;
+                p2 += re2[k]*s + im2[k]*c;
+            }
+            p1 /= M_PI;
+            p2 /= M_PI;
+
+            switch (payoffs[i]->optionType()) {
+              case Option::Call:
+                values[i] = spotPrice*dividendDiscount*(p1+0.5)
+                    - strikePrice*riskFreeDiscount*(p2+0.5);
+                break;
+              case Option::Put:
+                values[i] = spotPrice*dividendDiscount*(p1-0.5)
+                    - strikePrice*riskFreeDiscount*(p2-0.5);
+                break;
+              default:
+                QL_FAIL("unknown option type");
+            }
+        }
+        return values;
+    }
+
+
     AnalyticHestonEngine::Integration::Integration(
             Algorithm intAlgo,
             const boost::shared_ptr<Integrator>& integrator)
@@ -518,6 +621,39 @@ namespace QuantLib {
             || intAlgo_ == Trapezoid;
     }
 
+    void AnalyticHestonEngine::Integration::nodesAndWeights(
+                                           Real c_inf,
+                                           std::vector<Real>& nodes,
+                                           std::vector<Real>& weights) const {
+        QL_REQUIRE(gaussianQuadrature_,
+                   "nodes and weights are only available "
+                   "for non-adaptive integration algorithms");
+        const Array& x = gaussianQuadrature_->x();
+        const Array& w = gaussianQuadrature_->weights();
+        nodes.clear();
+        weights.clear();
+        // same order as GaussianQuadrature::operator()
+        for (Integer i = Integer(x.size())-1; i >= 0; --i) {
+            switch(intAlgo_) {
+              case GaussLaguerre:
+                nodes.push_back(x[i]);
+                weights.push_back(w[i]);
+                break;
+              case GaussLegendre:
+              case GaussChebyshev:
+              case GaussChebyshev2nd:
+                // same change of variable as in calculate()
+                if ((x[i]+1.0)*c_inf > QL_EPSILON) {
+                    nodes.push_back(-std::log(0.5*x[i]+0.5)/c_inf);
+                    weights.push_back(w[i]/((x[i]+1.0)*c_inf));
+                }
+                break;
+              default:
+                QL_FAIL("unknwon integration algorithm");
+            }
+        }
+    }
+
     Real AnalyticHestonEngine::Integration::calculate(
                                Real c_inf,
                                const boost::function1<Real, Real>& f) const {
@@ -30,6 +30,7 @@
 #include <ql/pricingengines/genericmodelengine.hpp>
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/instruments/vanillaoption.hpp>
+#include <ql/instruments/payoffs.hpp>
 
 #include <boost/function.hpp>
 #include <complex>
@@ -105,6 +106,18 @@ namespace QuantLib {
         void calculate() const;
         Size numberOfEvaluations() const;
 
+        //! prices several European options with a common maturity
+        /*! The characteristic function doesn't depend on the strike;
+            it is evaluated once per integration node and reused for
+            all payoffs, whose prices only require a few real
+            multiply-adds per node.  A non-adaptive integration
+            algorithm is required.
+        */
+        std::vector<Real> calculate(
+                const Date& maturity,
+                const std::vector<boost::shared_ptr<PlainVanillaPayoff> >&
+                                                            payoffs) const;
+
         static void doCalculation(Real riskFreeDiscount,
                                              Real dividendDiscount,
                                              Real spotPrice,
@@ -163,6 +176,14 @@ namespace QuantLib {
         Real calculate(Real c_inf,
                        const boost::function1<Real, Real>& f) const;
 
+        /*! Nodes and weights of non-adaptive algorithms such that
+            calculate(c_inf, f) equals the sum of weights[i]*f(nodes[i])
+            (nodes are returned in the order used by calculate.)
+        */
+        void nodesAndWeights(Real c_inf,
+                             std::vector<Real>& nodes,
+                             std::vector<Real>& weights) const;
+
         Size numberOfEvaluations() const;
         bool isAdaptiveIntegration() const;
 
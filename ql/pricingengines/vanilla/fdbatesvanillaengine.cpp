@@ -33,19 +33,20 @@ namespace QuantLib {
             const boost::shared_ptr<BatesModel>& model,
             Size tGrid, Size xGrid, 
             Size vGrid, Size dampingSteps,
-            const FdmSchemeDesc& schemeDesc)
+            const FdmSchemeDesc& schemeDesc, Size interpolationPoints)
     : GenericModelEngine<BatesModel,
                          DividendVanillaOption::arguments,
                          DividendVanillaOption::results>(model),
        tGrid_(tGrid), xGrid_(xGrid),
        vGrid_(vGrid), dampingSteps_(dampingSteps),
-       schemeDesc_(schemeDesc) {
+       schemeDesc_(schemeDesc), interpolationPoints_(interpolationPoints) {
     }
 
     void FdBatesVanillaEngine::calculate() const {
         FdHestonVanillaEngine helperEngine(model_.currentLink(),
                                            tGrid_, xGrid_, vGrid_,
-                                           dampingSteps_, schemeDesc_);
+                                           dampingSteps_, schemeDesc_,
+                                           interpolationPoints_);
 
         *dynamic_cast<DividendVanillaOption::arguments*>(
                                helperEngine.getArguments()) = arguments_;
@@ -41,11 +41,13 @@ namespace QuantLib {
                                     DividendVanillaOption::arguments,
                                     DividendVanillaOption::results> {
       public:
+        //! interpolationPoints as in FdmSolverDesc
         FdBatesVanillaEngine(
             const boost::shared_ptr<BatesModel>& model,
             Size tGrid = 100, Size xGrid = 100, 
             Size vGrid = 50, Size dampingSteps = 0,
-            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Hundsdorfer());
+            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Hundsdorfer(),
+            Size interpolationPoints = 0);
 
         
         void calculate() const;
@@ -53,6 +55,7 @@ namespace QuantLib {
       private:
         const Size tGrid_, xGrid_, vGrid_, dampingSteps_;
         const FdmSchemeDesc schemeDesc_;
+        const Size interpolationPoints_;
     };
 }
 
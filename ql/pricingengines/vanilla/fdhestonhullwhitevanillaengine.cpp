@@ -40,7 +40,8 @@ namespace QuantLib {
             Size vGrid, Size rGrid,
             Size dampingSteps,
             bool controlVariate,
-            const FdmSchemeDesc& schemeDesc)
+            const FdmSchemeDesc& schemeDesc,
+            Size interpolationPoints)
     : GenericModelEngine<HestonModel,
                          DividendVanillaOption::arguments,
                          DividendVanillaOption::results>(hestonModel),
@@ -50,7 +51,8 @@ namespace QuantLib {
       vGrid_(vGrid), rGrid_(rGrid),
       dampingSteps_(dampingSteps),
       schemeDesc_(schemeDesc),
-      controlVariate_(controlVariate) {
+      controlVariate_(controlVariate),
+      interpolationPoints_(interpolationPoints) {
     }
 
     void FdHestonHullWhiteVanillaEngine::calculate() const {
@@ -159,7 +161,8 @@ namespace QuantLib {
         // 6. Solver
         const FdmSolverDesc solverDesc = { mesher, boundaries, conditions,
                                            calculator, maturity,
-                                           tGrid_, dampingSteps_ };
+                                           tGrid_, dampingSteps_,
+                                           interpolationPoints_ };
 
         const boost::shared_ptr<FdmHestonHullWhiteSolver> solver(
             new FdmHestonHullWhiteSolver(Handle<HestonProcess>(hestonProcess),
@@ -47,6 +47,7 @@ namespace QuantLib {
                                     DividendVanillaOption::results> {
       public:
         // Constructor
+        //! interpolationPoints as in FdmSolverDesc
         FdHestonHullWhiteVanillaEngine(
             const boost::shared_ptr<HestonModel>& model,
             const boost::shared_ptr<HullWhiteProcess>& hwProcess,
@@ -55,7 +56,8 @@ namespace QuantLib {
             Size vGrid = 40, Size rGrid = 20,
             Size dampingSteps = 0,
             bool controlVariate = true,
-            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Hundsdorfer());
+            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Hundsdorfer(),
+            Size interpolationPoints = 0);
 
         void calculate() const;
 
@@ -70,6 +72,7 @@ namespace QuantLib {
         const Size dampingSteps_;
         const FdmSchemeDesc schemeDesc_;
         const bool controlVariate_;
+        const Size interpolationPoints_;
         
         std::vector<Real> strikes_;
         mutable std::vector<std::pair<DividendVanillaOption::arguments,
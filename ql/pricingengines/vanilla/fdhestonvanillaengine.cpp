@@ -36,13 +36,13 @@ namespace QuantLib {
     FdHestonVanillaEngine::FdHestonVanillaEngine(
             const boost::shared_ptr<HestonModel>& model,
             Size tGrid, Size xGrid, Size vGrid, Size dampingSteps,
-            const FdmSchemeDesc& schemeDesc)
+            const FdmSchemeDesc& schemeDesc, Size interpolationPoints)
     : GenericModelEngine<HestonModel,
                         DividendVanillaOption::arguments,
                         DividendVanillaOption::results>(model),
       tGrid_(tGrid), xGrid_(xGrid), 
       vGrid_(vGrid), dampingSteps_(dampingSteps),
-      schemeDesc_(schemeDesc) {
+      schemeDesc_(schemeDesc), interpolationPoints_(interpolationPoints) {
     }
 
 
@@ -116,7 +116,8 @@ namespace QuantLib {
         // 6. Solver
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions,
                                      calculator, maturity,
-                                     tGrid_, dampingSteps_ };
+                                     tGrid_, dampingSteps_,
+                                     interpolationPoints_ };
 
        return solverDesc;
     }
@@ -48,11 +48,13 @@ namespace QuantLib {
                                     DividendVanillaOption::results> {
       public:
         // Constructor
+        //! interpolationPoints as in FdmSolverDesc
         FdHestonVanillaEngine(
             const boost::shared_ptr<HestonModel>& model,
             Size tGrid = 100, Size xGrid = 100, 
             Size vGrid = 50, Size dampingSteps = 0,
-            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Hundsdorfer());
+            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Hundsdorfer(),
+            Size interpolationPoints = 0);
 
         void calculate() const;
         
@@ -66,6 +68,7 @@ namespace QuantLib {
       private:
         const Size tGrid_, xGrid_, vGrid_, dampingSteps_;
         const FdmSchemeDesc schemeDesc_;
+        const Size interpolationPoints_;
         
         std::vector<Real> strikes_;
         mutable std::vector<std::pair<DividendVanillaOption::arguments,
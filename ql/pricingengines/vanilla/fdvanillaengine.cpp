@@ -24,6 +24,7 @@
 #include <ql/instruments/payoffs.hpp>
 #include <ql/grid.hpp>
 #include <ql/methods/finitedifferences/operatorfactory.hpp>
+#include <ql/methods/finitedifferences/pdebsm.hpp>
 #include <ql/instruments/oneassetoption.hpp>
 
 namespace QuantLib {
@@ -91,11 +92,48 @@ namespace QuantLib {
     }
 
     void FDVanillaEngine::initializeOperator() const {
-        finiteDifferenceOperator_ =
-            OperatorFactory::getOperator(process_,
-                                         intrinsicValues_.grid(),
-                                         getResidualTime(),
-                                         timeDependent_);
+        const Array& grid = intrinsicValues_.grid();
+        const Time residualTime = getResidualTime();
+
+        if (timeDependent_) {
+            finiteDifferenceOperator_ =
+                OperatorFactory::getOperator(process_, grid,
+                                             residualTime, true);
+            return;
+        }
+
+        // the time-independent operator is determined by the grid and
+        // by the process coefficients at the underlying value (see
+        // BSMOperator); if they didn't change since the last call, the
+        // operator is reused, otherwise it is rebuilt in place.
+        const PdeConstantCoeff<PdeBSM> coefficients(
+            process_, residualTime, process_->stateVariable()->value());
+        const Real diffusion = coefficients.diffusion(residualTime, 0.0);
+        const Real drift = coefficients.drift(residualTime, 0.0);
+        const Real discount = coefficients.discount(residualTime, 0.0);
+
+        if (finiteDifferenceOperator_.size() == grid.size()
+            && !finiteDifferenceOperator_.isTimeDependent()) {
+            if (operatorGrid_ == grid
+                && operatorDiffusion_ == diffusion
+                && operatorDrift_ == drift
+                && operatorDiscount_ == discount)
+                return;
+
+            coefficients.generateOperator(residualTime,
+                                          PdeBSM::grid_type(grid),
+                                          finiteDifferenceOperator_);
+            std::copy(grid.begin(), grid.end(), operatorGrid_.begin());
+        } else {
+            finiteDifferenceOperator_ = TridiagonalOperator(grid.size());
+            coefficients.generateOperator(residualTime,
+                                          PdeBSM::grid_type(grid),
+                                          finiteDifferenceOperator_);
+            operatorGrid_ = grid;
+        }
+        operatorDiffusion_ = diffusion;
+        operatorDrift_ = drift;
+        operatorDiscount_ = discount;
     }
 
     void FDVanillaEngine::initializeBoundaryConditions() const {
@@ -82,6 +82,9 @@ namespace QuantLib {
       private:
         // temporaries
         mutable Real gridLogSpacing_;
+        // grid and coefficients of the cached operator
+        mutable Array operatorGrid_;
+        mutable Real operatorDiffusion_, operatorDrift_, operatorDiscount_;
         Size safeGridPoints(Size gridPoints,
                             Time residualTime) const;
         static const Real safetyZoneFactor_;
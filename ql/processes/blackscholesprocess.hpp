@@ -53,6 +53,19 @@ namespace QuantLib {
             const Handle<BlackVolTermStructure>& blackVolTS,
             const boost::shared_ptr<discretization>& d =
                   boost::shared_ptr<discretization>(new EulerDiscretization));
+        /*! The given local volatility is used in place of the one
+            which would be derived from the Black volatility, e.g., an
+            InterpolatedLocalVolSurface wrapping an expensive
+            LocalVolSurface.
+        */
+        GeneralizedBlackScholesProcess(
+            const Handle<Quote>& x0,
+            const Handle<YieldTermStructure>& dividendTS,
+            const Handle<YieldTermStructure>& riskFreeTS,
+            const Handle<BlackVolTermStructure>& blackVolTS,
+            const Handle<LocalVolTermStructure>& localVolTS,
+            const boost::shared_ptr<discretization>& d =
+                  boost::shared_ptr<discretization>(new EulerDiscretization));
         //! \name StochasticProcess1D interface
         //@{
         Real x0() const;
@@ -86,6 +99,7 @@ namespace QuantLib {
         Handle<YieldTermStructure> riskFreeRate_, dividendYield_;
         Handle<BlackVolTermStructure> blackVolatility_;
         mutable RelinkableHandle<LocalVolTermStructure> localVolatility_;
+        Handle<LocalVolTermStructure> externalLocalVolTS_;
         mutable bool updated_;
     };
 
@@ -0,0 +1,241 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file interpolatedlocalvolsurface.hpp
+    \brief Local volatility surface interpolated on a precomputed grid
+*/
+
+#ifndef quantlib_interpolated_local_vol_surface_hpp
+#define quantlib_interpolated_local_vol_surface_hpp
+
+#include <ql/termstructures/volatility/equityfx/localvoltermstructure.hpp>
+#include <ql/math/interpolations/bilinearinterpolation.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/utilities/null.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Local volatility surface interpolated on a precomputed grid
+    /*! The local volatility of the underlying term structure is
+        evaluated once on a grid of times and log-underlying levels;
+        afterwards, localVol() only performs an interpolation on the
+        stored values. This is intended to wrap expensive surfaces
+        such as LocalVolSurface, whose Dupire formula would otherwise
+        be evaluated at every step of every path or grid point.
+
+        The grid is recalculated lazily whenever the underlying term
+        structure notifies a change. Outside the grid the local
+        volatility is extrapolated flat in both directions. As in
+        FdmBlackScholesOp, a non-negative illegalLocalVolOverwrite
+        replaces grid values for which the local volatility cannot
+        be calculated.
+
+        \test the interpolated surface is checked against the
+              original one in the finite-difference local
+              volatility test.
+    */
+    template <class Interpolator2D = Bilinear>
+    class InterpolatedLocalVolSurface : public LocalVolTermStructure {
+      public:
+        InterpolatedLocalVolSurface(
+                    const Handle<LocalVolTermStructure>& localVol,
+                    const std::vector<Time>& times,
+                    const std::vector<Real>& underlyingLevels,
+                    Real illegalLocalVolOverwrite = -Null<Real>(),
+                    const Interpolator2D& interpolator = Interpolator2D());
+        /*! the grid is uniform in time between 0 and maxTime and
+            uniform in log-underlying between minLevel and maxLevel.
+        */
+        InterpolatedLocalVolSurface(
+                    const Handle<LocalVolTermStructure>& localVol,
+                    Time maxTime, Size timeSteps,
+                    Real minLevel, Real maxLevel, Size levelSteps,
+                    Real illegalLocalVolOverwrite = -Null<Real>(),
+                    const Interpolator2D& interpolator = Interpolator2D());
+        //! \name TermStructure interface
+        //@{
+        const Date& referenceDate() const {
+            return localVol_->referenceDate();
+        }
+        Calendar calendar() const { return localVol_->calendar(); }
+        DayCounter dayCounter() const { return localVol_->dayCounter(); }
+        Date maxDate() const { return localVol_->maxDate(); }
+        //@}
+        //! \name VolatilityTermStructure interface
+        //@{
+        Real minStrike() const { return localVol_->minStrike(); }
+        Real maxStrike() const { return localVol_->maxStrike(); }
+        //@}
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
+        //! \name Inspectors
+        //@{
+        const std::vector<Time>& times() const { return times_; }
+        const std::vector<Real>& logUnderlyingLevels() const {
+            return logLevels_;
+        }
+        //! local volatilities; rows correspond to times
+        const Matrix& localVolatilities() const;
+        //@}
+      protected:
+        Volatility localVolImpl(Time t, Real underlyingLevel) const;
+      private:
+        void initialize();
+        void calculate() const;
+
+        Handle<LocalVolTermStructure> localVol_;
+        std::vector<Time> times_;
+        std::vector<Real> logLevels_;
+        const Real illegalLocalVolOverwrite_;
+        Interpolator2D interpolator_;
+        mutable Matrix localVols_;
+        mutable Interpolation2D interpolation_;
+        mutable bool calculated_;
+    };
+
+
+    // template definitions
+
+    template <class I2D>
+    InterpolatedLocalVolSurface<I2D>::InterpolatedLocalVolSurface(
+                               const Handle<LocalVolTermStructure>& localVol,
+                               const std::vector<Time>& times,
+                               const std::vector<Real>& underlyingLevels,
+                               Real illegalLocalVolOverwrite,
+                               const I2D& interpolator)
+    : LocalVolTermStructure(localVol->businessDayConvention(),
+                            localVol->dayCounter()),
+      localVol_(localVol), times_(times),
+      logLevels_(underlyingLevels.size()),
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
+      interpolator_(interpolator), calculated_(false) {
+        for (Size i=0; i < underlyingLevels.size(); ++i) {
+            QL_REQUIRE(underlyingLevels[i] > 0.0,
+                       "non-positive underlying level given: "
+                       << underlyingLevels[i]);
+            logLevels_[i] = std::log(underlyingLevels[i]);
+        }
+        initialize();
+    }
+
+    template <class I2D>
+    InterpolatedLocalVolSurface<I2D>::InterpolatedLocalVolSurface(
+                               const Handle<LocalVolTermStructure>& localVol,
+                               Time maxTime, Size timeSteps,
+                               Real minLevel, Real maxLevel, Size levelSteps,
+                               Real illegalLocalVolOverwrite,
+                               const I2D& interpolator)
+    : LocalVolTermStructure(localVol->businessDayConvention(),
+                            localVol->dayCounter()),
+      localVol_(localVol), times_(timeSteps+1), logLevels_(levelSteps+1),
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
+      interpolator_(interpolator), calculated_(false) {
+        QL_REQUIRE(maxTime > 0.0, "positive maximum time required");
+        QL_REQUIRE(timeSteps > 0 && levelSteps > 0,
+                   "at least one time and one level step required");
+        QL_REQUIRE(minLevel > 0.0 && maxLevel > minLevel,
+                   "invalid underlying range [" << minLevel << ", "
+                   << maxLevel << "]");
+
+        const Real xMin = std::log(minLevel), xMax = std::log(maxLevel);
+        for (Size i=0; i <= timeSteps; ++i)
+            times_[i] = maxTime*i/timeSteps;
+        for (Size i=0; i <= levelSteps; ++i)
+            logLevels_[i] = xMin + (xMax-xMin)*i/levelSteps;
+
+        initialize();
+    }
+
+    template <class I2D>
+    void InterpolatedLocalVolSurface<I2D>::initialize() {
+        QL_REQUIRE(times_.size() > 1, "at least two times required");
+        QL_REQUIRE(logLevels_.size() > 1,
+                   "at least two underlying levels required");
+        QL_REQUIRE(times_.front() >= 0.0, "negative time given");
+        for (Size i=1; i < times_.size(); ++i)
+            QL_REQUIRE(times_[i] > times_[i-1],
+                       "times must be sorted and unique");
+        for (Size i=1; i < logLevels_.size(); ++i)
+            QL_REQUIRE(logLevels_[i] > logLevels_[i-1],
+                       "underlying levels must be sorted and unique");
+
+        localVols_ = Matrix(times_.size(), logLevels_.size());
+        registerWith(localVol_);
+    }
+
+    template <class I2D>
+    void InterpolatedLocalVolSurface<I2D>::update() {
+        calculated_ = false;
+        LocalVolTermStructure::update();
+    }
+
+    template <class I2D>
+    const Matrix&
+    InterpolatedLocalVolSurface<I2D>::localVolatilities() const {
+        calculate();
+        return localVols_;
+    }
+
+    template <class I2D>
+    void InterpolatedLocalVolSurface<I2D>::calculate() const {
+        if (calculated_)
+            return;
+
+        for (Size i=0; i < times_.size(); ++i) {
+            for (Size j=0; j < logLevels_.size(); ++j) {
+                const Real level = std::exp(logLevels_[j]);
+                if (illegalLocalVolOverwrite_ < 0.0) {
+                    localVols_[i][j] =
+                        localVol_->localVol(times_[i], level, true);
+                }
+                else {
+                    try {
+                        localVols_[i][j] =
+                            localVol_->localVol(times_[i], level, true);
+                    } catch (Error&) {
+                        localVols_[i][j] = illegalLocalVolOverwrite_;
+                    }
+                }
+            }
+        }
+
+        interpolation_ = interpolator_.interpolate(
+                                   logLevels_.begin(), logLevels_.end(),
+                                   times_.begin(), times_.end(), localVols_);
+        calculated_ = true;
+    }
+
+    template <class I2D>
+    Volatility InterpolatedLocalVolSurface<I2D>::localVolImpl(
+                                      Time t, Real underlyingLevel) const {
+        calculate();
+
+        const Real x = (underlyingLevel > 0.0)
+            ? std::min(std::max(std::log(underlyingLevel), logLevels_.front()),
+                       logLevels_.back())
+            : logLevels_.front();
+        t = std::min(std::max(t, times_.front()), times_.back());
+
+        return interpolation_(x, t);
+    }
+
+}
+
+#endif
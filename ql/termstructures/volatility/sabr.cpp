@@ -66,6 +66,146 @@ namespace QuantLib {
         return (alpha/D)*multiplier*d;
     }
 
+    std::vector<Real> unsafeSabrVolatilities(const std::vector<Rate>& strikes,
+                                             Rate forward,
+                                             Time expiryTime,
+                                             Real alpha,
+                                             Real beta,
+                                             Real nu,
+                                             Real rho) {
+        // strike-independent terms, arranged so that the results
+        // coincide with those of unsafeSabrVolatility
+        const Real oneMinusBeta = 1.0-beta;
+        const Real nuOverAlpha = nu/alpha;
+        const Real oneMinusRho = 1.0-rho;
+        const Real dA = oneMinusBeta*oneMinusBeta*alpha*alpha;
+        const Real dSqrtA = 0.25*rho*beta*nu*alpha;
+        const Real dConst = (2.0-3.0*rho*rho)*(nu*nu/24.0);
+        const Real seriesCoeff = 3.0*rho*rho-2.0;
+        static const Real m = 10;
+
+        std::vector<Real> result(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i) {
+            const Rate strike = strikes[i];
+            const Real A = std::pow(forward*strike, oneMinusBeta);
+            const Real sqrtA= std::sqrt(A);
+            Real logM;
+            if (!close(forward, strike))
+                logM = std::log(forward/strike);
+            else {
+                const Real epsilon = (forward-strike)/strike;
+                logM = epsilon - .5 * epsilon * epsilon ;
+            }
+            const Real z = nuOverAlpha*sqrtA*logM;
+            const Real C = oneMinusBeta*oneMinusBeta*logM*logM;
+            const Real D = sqrtA*(1.0+C/24.0+C*C/1920.0);
+            const Real d = 1.0 + expiryTime *
+                (dA/(24.0*A) + dSqrtA/sqrtA + dConst);
+
+            Real multiplier;
+            if (std::fabs(z*z)>QL_EPSILON * m) {
+                const Real B = 1.0-2.0*rho*z+z*z;
+                const Real xx = std::log((std::sqrt(B)+z-rho)/oneMinusRho);
+                multiplier = z/xx;
+            } else {
+                multiplier = 1.0 - 0.5*rho*z - seriesCoeff*z*z/12.0;
+            }
+            result[i] = (alpha/D)*multiplier*d;
+        }
+        return result;
+    }
+
+    Disposable<Matrix> unsafeSabrVolatilityJacobian(
+                                   const std::vector<Rate>& strikes,
+                                   Rate forward,
+                                   Time expiryTime,
+                                   Real alpha,
+                                   Real beta,
+                                   Real nu,
+                                   Real rho,
+                                   std::vector<Real>* volatilities) {
+        const Real oneMinusBeta = 1.0-beta;
+        const Real nuOverAlpha = nu/alpha;
+        const Real oneMinusRho = 1.0-rho;
+        const Real logF = std::log(forward);
+        static const Real m = 10;
+
+        Matrix jacobian(strikes.size(), 4);
+        if (volatilities != 0)
+            volatilities->resize(strikes.size());
+
+        for (Size i=0; i<strikes.size(); ++i) {
+            const Rate strike = strikes[i];
+            const Real logFK = logF + std::log(strike);
+            const Real A = std::pow(forward*strike, oneMinusBeta);
+            const Real sqrtA = std::sqrt(A);
+            const Real dSqrtA_dBeta = -0.5*sqrtA*logFK;
+            Real logM;
+            if (!close(forward, strike))
+                logM = std::log(forward/strike);
+            else {
+                const Real epsilon = (forward-strike)/strike;
+                logM = epsilon - .5 * epsilon * epsilon ;
+            }
+
+            // denominator D = sqrtA*E
+            const Real C = oneMinusBeta*oneMinusBeta*logM*logM;
+            const Real dC_dBeta = -2.0*oneMinusBeta*logM*logM;
+            const Real E = 1.0+C/24.0+C*C/1920.0;
+            const Real D = sqrtA*E;
+            const Real dD_dBeta = dSqrtA_dBeta*E
+                + sqrtA*dC_dBeta*(1.0/24.0+C/960.0);
+
+            // z and the multiplier z/x(z)
+            const Real z = nuOverAlpha*sqrtA*logM;
+            const Real dz_dAlpha = -z/alpha;
+            const Real dz_dBeta = nuOverAlpha*dSqrtA_dBeta*logM;
+            const Real dz_dNu = sqrtA*logM/alpha;
+            Real multiplier, dMult_dz, dMult_dRho;
+            if (std::fabs(z*z)>QL_EPSILON * m) {
+                const Real sqrtB = std::sqrt(1.0-2.0*rho*z+z*z);
+                const Real xx = std::log((sqrtB+z-rho)/oneMinusRho);
+                const Real dxx_dRho =
+                    1.0/oneMinusRho - (z/sqrtB+1.0)/(sqrtB+z-rho);
+                multiplier = z/xx;
+                dMult_dz = (xx - z/sqrtB)/(xx*xx);
+                dMult_dRho = -z/(xx*xx)*dxx_dRho;
+            } else {
+                multiplier = 1.0 - 0.5*rho*z - (3.0*rho*rho-2.0)*z*z/12.0;
+                dMult_dz = -0.5*rho - (3.0*rho*rho-2.0)*z/6.0;
+                dMult_dRho = -0.5*z - 0.5*rho*z*z;
+            }
+
+            // time correction d = 1 + t*(T1+T2+T3)
+            const Real T1 = oneMinusBeta*oneMinusBeta*alpha*alpha/(24.0*A);
+            const Real T2 = 0.25*rho*beta*nu*alpha/sqrtA;
+            const Real T3 = (2.0-3.0*rho*rho)*(nu*nu/24.0);
+            const Real d = 1.0 + expiryTime*(T1+T2+T3);
+            const Real dd_dAlpha = expiryTime*(2.0*T1+T2)/alpha;
+            const Real dd_dBeta = expiryTime *
+                (alpha*alpha/(24.0*A)*oneMinusBeta*(oneMinusBeta*logFK-2.0)
+                 + 0.25*rho*nu*alpha/sqrtA*(1.0+0.5*beta*logFK));
+            const Real dd_dNu = expiryTime *
+                (0.25*rho*beta*alpha/sqrtA + (2.0-3.0*rho*rho)*nu/12.0);
+            const Real dd_dRho = expiryTime *
+                (0.25*beta*nu*alpha/sqrtA - 0.25*rho*nu*nu);
+
+            const Real alphaOverD = alpha/D;
+            const Real vol = alphaOverD*multiplier*d;
+            jacobian[i][0] = vol/alpha + alphaOverD *
+                (dMult_dz*dz_dAlpha*d + multiplier*dd_dAlpha);
+            jacobian[i][1] = alphaOverD *
+                (dMult_dz*dz_dBeta*d + multiplier*dd_dBeta) - vol*dD_dBeta/D;
+            jacobian[i][2] = alphaOverD *
+                (dMult_dz*dz_dNu*d + multiplier*dd_dNu);
+            jacobian[i][3] = alphaOverD *
+                (dMult_dRho*d + multiplier*dd_dRho);
+            if (volatilities != 0)
+                (*volatilities)[i] = vol;
+        }
+        return jacobian;
+    }
+
     void validateSabrParameters(Real alpha,
                                 Real beta,
                                 Real nu,
@@ -98,4 +238,54 @@ namespace QuantLib {
                                     alpha, beta, nu, rho);
     }
 
+    namespace {
+
+        void validateSabrInputs(const std::vector<Rate>& strikes,
+                                Rate forward,
+                                Time expiryTime,
+                                Real alpha,
+                                Real beta,
+                                Real nu,
+                                Real rho) {
+            for (Size i=0; i<strikes.size(); ++i)
+                QL_REQUIRE(strikes[i]>0.0, "strike must be positive: "
+                           << io::rate(strikes[i]) << " not allowed");
+            QL_REQUIRE(forward>0.0, "at the money forward rate must be "
+                       "positive: " << io::rate(forward) << " not allowed");
+            QL_REQUIRE(expiryTime>=0.0, "expiry time must be non-negative: "
+                                       << expiryTime << " not allowed");
+            validateSabrParameters(alpha, beta, nu, rho);
+        }
+
+    }
+
+    std::vector<Real> sabrVolatilities(const std::vector<Rate>& strikes,
+                                       Rate forward,
+                                       Time expiryTime,
+                                       Real alpha,
+                                       Real beta,
+                                       Real nu,
+                                       Real rho) {
+        validateSabrInputs(strikes, forward, expiryTime,
+                           alpha, beta, nu, rho);
+        return unsafeSabrVolatilities(strikes, forward, expiryTime,
+                                      alpha, beta, nu, rho);
+    }
+
+    Disposable<Matrix> sabrVolatilityJacobian(
+                                   const std::vector<Rate>& strikes,
+                                   Rate forward,
+                                   Time expiryTime,
+                                   Real alpha,
+                                   Real beta,
+                                   Real nu,
+                                   Real rho,
+                                   std::vector<Real>* volatilities) {
+        validateSabrInputs(strikes, forward, expiryTime,
+                           alpha, beta, nu, rho);
+        return unsafeSabrVolatilityJacobian(strikes, forward, expiryTime,
+                                            alpha, beta, nu, rho,
+                                            volatilities);
+    }
+
 }
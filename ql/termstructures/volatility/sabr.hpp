@@ -26,7 +26,8 @@
 #ifndef quantlib_sabr_hpp
 #define quantlib_sabr_hpp
 
-#include <ql/types.hpp>
+#include <ql/math/matrix.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -46,6 +47,53 @@ namespace QuantLib {
                         Real nu,
                         Real rho);
 
+    //! Hagan volatilities for several strikes
+    /*! The strike-independent parts of the expansion are computed
+        once; each result equals the corresponding
+        unsafeSabrVolatility() value.
+    */
+    std::vector<Real> unsafeSabrVolatilities(const std::vector<Rate>& strikes,
+                                             Rate forward,
+                                             Time expiryTime,
+                                             Real alpha,
+                                             Real beta,
+                                             Real nu,
+                                             Real rho);
+
+    std::vector<Real> sabrVolatilities(const std::vector<Rate>& strikes,
+                                       Rate forward,
+                                       Time expiryTime,
+                                       Real alpha,
+                                       Real beta,
+                                       Real nu,
+                                       Real rho);
+
+    //! derivatives of the Hagan volatilities w.r.t. the SABR parameters
+    /*! The returned matrix has one row per strike; its columns hold
+        the derivatives with respect to alpha, beta, nu and rho.
+        If volatilities is not null, it is filled with the
+        volatilities computed along the way.
+    */
+    Disposable<Matrix> unsafeSabrVolatilityJacobian(
+                                   const std::vector<Rate>& strikes,
+                                   Rate forward,
+                                   Time expiryTime,
+                                   Real alpha,
+                                   Real beta,
+                                   Real nu,
+                                   Real rho,
+                                   std::vector<Real>* volatilities = 0);
+
+    Disposable<Matrix> sabrVolatilityJacobian(
+                                   const std::vector<Rate>& strikes,
+                                   Rate forward,
+                                   Time expiryTime,
+                                   Real alpha,
+                                   Real beta,
+                                   Real nu,
+                                   Real rho,
+                                   std::vector<Real>* volatilities = 0);
+
     void validateSabrParameters(Real alpha,
                                 Real beta,
                                 Real nu,
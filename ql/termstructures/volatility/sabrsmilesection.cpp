@@ -65,4 +65,10 @@ namespace QuantLib {
             exerciseTime(), alpha_, beta_, nu_, rho_);
      }
 
+     std::vector<Volatility> SabrSmileSection::volatilities(
+                                   const std::vector<Rate>& strikes) const {
+        return unsafeSabrVolatilities(strikes, forward_,
+            exerciseTime(), alpha_, beta_, nu_, rho_);
+     }
+
 }
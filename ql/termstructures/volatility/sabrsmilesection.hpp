@@ -42,6 +42,9 @@ namespace QuantLib {
         Real minStrike () const { return 0.0; }
         Real maxStrike () const { return QL_MAX_REAL; }
         Real atmLevel() const { return forward_; }
+        //! volatilities for several strikes, evaluated in one pass
+        std::vector<Volatility> volatilities(
+                                   const std::vector<Rate>& strikes) const;
       protected:
         Real varianceImpl(Rate strike) const;
         Volatility volatilityImpl(Rate strike) const;
@@ -22,6 +22,8 @@
 #include <ql/math/interpolations/flatextrapolation2d.hpp>
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/math/interpolations/sabrinterpolation.hpp>
+#include <ql/math/optimization/levenbergmarquardt.hpp>
+#include <ql/utilities/parallelerrors.hpp>
 #include <ql/quote.hpp>
 
 #ifndef SWAPTIONVOLCUBE_VEGAWEIGHTED_TOL
@@ -33,6 +35,23 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        /* Levenberg-Marquardt keeps the problem being solved, so
+           that concurrent fits need their own copy; other methods
+           can't be copied and are shared */
+        boost::shared_ptr<OptimizationMethod> sabrOptimizationMethod(
+                     const boost::shared_ptr<OptimizationMethod>& given) {
+            const LevenbergMarquardt* lm =
+                dynamic_cast<const LevenbergMarquardt*>(given.get());
+            if (lm == 0)
+                return given;
+            return boost::shared_ptr<OptimizationMethod>(
+                                              new LevenbergMarquardt(*lm));
+        }
+
+    }
+
     //=======================================================================//
     //                        SwaptionVolCube1                   //
     //=======================================================================//
@@ -51,14 +70,17 @@ namespace QuantLib {
                 bool isAtmCalibrated,
                 const boost::shared_ptr<EndCriteria>& endCriteria,
                 Real maxErrorTolerance,
-                const boost::shared_ptr<OptimizationMethod>& optMethod)
+                const boost::shared_ptr<OptimizationMethod>& optMethod,
+                bool parallelCalibration,
+                bool warmStart)
     : SwaptionVolatilityCube(atmVolStructure, optionTenors, swapTenors,
                              strikeSpreads, volSpreads, swapIndexBase,
                              shortSwapIndexBase,
                              vegaWeightedSmileFit),
       parametersGuessQuotes_(parametersGuess),
       isParameterFixed_(isParameterFixed), isAtmCalibrated_(isAtmCalibrated),
-      endCriteria_(endCriteria), optMethod_(optMethod)
+      endCriteria_(endCriteria), optMethod_(optMethod),
+      parallelCalibration_(parallelCalibration), warmStart_(warmStart)
     {
         if (maxErrorTolerance != Null<Rate>()) {
             maxErrorTolerance_ = maxErrorTolerance;
@@ -81,6 +103,11 @@ namespace QuantLib {
 
         SwaptionVolatilityDiscrete::performCalculations();
 
+        previousNodes_.clear();
+        if (warmStart_)
+            previousNodes_.swap(calibrationNodes_);
+        calibrationNodes_.clear();
+
         //! set parametersGuess_ by parametersGuessQuotes_
         parametersGuess_ = Cube(optionDates_, swapTenors_,
                                 optionTimes_, swapLengths_, 4);
@@ -142,25 +169,81 @@ namespace QuantLib {
 
         const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
 
-        std::vector<Real> strikes(strikeSpreads_.size());
-        std::vector<Real> volatilities(strikeSpreads_.size());
-
-        for (Size j=0; j<optionTimes.size(); j++) {
-            for (Size k=0; k<swapLengths.size(); k++) {
-                Rate atmForward = atmStrike(optionDates[j], swapTenors[k]);
-                for (Size i=0; i<nStrikes_; i++){
-                    strikes[i] = atmForward+strikeSpreads_[i];
-                    volatilities[i] = tmpMarketVolCube[i][j][k];
+        // collect the nodes; those whose inputs were already
+        // calibrated are not fitted again
+        const Size nOptions = optionTimes.size(), nSwaps = swapLengths.size();
+        std::vector<CalibrationNode> nodes(nOptions*nSwaps);
+        std::vector<Size> toBeFitted;
+        for (Size j=0; j<nOptions; j++) {
+            for (Size k=0; k<nSwaps; k++) {
+                CalibrationNode& node = nodes[j*nSwaps+k];
+                node.forward = atmStrike(optionDates[j], swapTenors[k]);
+                node.volatilities.resize(nStrikes_);
+                for (Size i=0; i<nStrikes_; i++)
+                    node.volatilities[i] = tmpMarketVolCube[i][j][k];
+
+                const std::pair<Time, Time> key(optionTimes[j],
+                                                swapLengths[k]);
+                const CalibrationNode* previous = 0;
+                CalibrationNodes::const_iterator calibrated =
+                    calibrationNodes_.find(key);
+                if (calibrated != calibrationNodes_.end()) {
+                    previous = &calibrated->second;
+                } else {
+                    calibrated = previousNodes_.find(key);
+                    if (calibrated != previousNodes_.end())
+                        previous = &calibrated->second;
                 }
 
-                const std::vector<Real>& guess = parametersGuess_.operator()(
-                    optionTimes[j], swapLengths[k]);
+                node.guess = parametersGuess_(optionTimes[j], swapLengths[k]);
+                if (previous != 0) {
+                    bool sameInputs = previous->forward == node.forward
+                        && previous->volatilities == node.volatilities;
+                    for (Size i=0; i<4; ++i) {
+                        if (isParameterFixed_[i])
+                            sameInputs = sameInputs
+                                && previous->guess[i] == node.guess[i];
+                    }
+                    if (sameInputs) {
+                        node.result = previous->result;
+                        node.endCriteria = previous->endCriteria;
+                        continue;
+                    }
+                    if (warmStart_) {
+                        for (Size i=0; i<4; ++i) {
+                            if (!isParameterFixed_[i])
+                                node.guess[i] = previous->result[i];
+                        }
+                    }
+                }
+                toBeFitted.push_back(j*nSwaps+k);
+            }
+        }
 
-                const boost::shared_ptr<SABRInterpolation> sabrInterpolation =
-                    boost::shared_ptr<SABRInterpolation>(new
-                        SABRInterpolation(strikes.begin(), strikes.end(),
-                                          volatilities.begin(),
-                                          optionTimes[j], atmForward,
+        // the fits are independent; a user-given optimization method
+        // other than Levenberg-Marquardt would be shared among them,
+        // so that they must be serial then
+        const Integer nFits = Integer(toBeFitted.size());
+        const bool parallelFits = parallelCalibration_ && (!optMethod_
+            || dynamic_cast<const LevenbergMarquardt*>(optMethod_.get()));
+        ParallelErrors failures;
+        #if defined(_OPENMP)
+        #pragma omp parallel for schedule(dynamic) if (parallelFits)
+        #endif
+        for (Integer n=0; n<nFits; ++n) {
+            const Size node = toBeFitted[n];
+            const Size j = node / nSwaps;
+            CalibrationNode& calibration = nodes[node];
+            const std::vector<Real>& guess = calibration.guess;
+            try {
+                std::vector<Real> strikes(nStrikes_);
+                for (Size i=0; i<nStrikes_; i++)
+                    strikes[i] = calibration.forward+strikeSpreads_[i];
+
+                SABRInterpolation sabrInterpolation(
+                                          strikes.begin(), strikes.end(),
+                                          calibration.volatilities.begin(),
+                                          optionTimes[j], calibration.forward,
                                           guess[0], guess[1],
                                           guess[2], guess[3],
                                           isParameterFixed_[0],
@@ -169,21 +252,48 @@ namespace QuantLib {
                                           isParameterFixed_[3],
                                           vegaWeightedSmileFit_,
                                           endCriteria_,
-                                          optMethod_));
-                sabrInterpolation->update();
-
-                Real rmsError = sabrInterpolation->rmsError();
-                Real maxError = sabrInterpolation->maxError();
-                alphas     [j][k] = sabrInterpolation->alpha();
-                betas      [j][k] = sabrInterpolation->beta();
-                nus        [j][k] = sabrInterpolation->nu();
-                rhos       [j][k] = sabrInterpolation->rho();
-                forwards   [j][k] = atmForward;
-                errors     [j][k] = rmsError;
-                maxErrors  [j][k] = maxError;
-                endCriteria[j][k] = sabrInterpolation->endCriteria();
-
-                QL_ENSURE(endCriteria[j][k]!=EndCriteria::MaxIterations,
+                                          sabrOptimizationMethod(optMethod_));
+                sabrInterpolation.update();
+
+                calibration.result.resize(7);
+                calibration.result[0] = sabrInterpolation.alpha();
+                calibration.result[1] = sabrInterpolation.beta();
+                calibration.result[2] = sabrInterpolation.nu();
+                calibration.result[3] = sabrInterpolation.rho();
+                calibration.result[4] = calibration.forward;
+                calibration.result[5] = sabrInterpolation.rmsError();
+                calibration.result[6] = sabrInterpolation.maxError();
+                calibration.endCriteria = sabrInterpolation.endCriteria();
+            } catch (...) {
+                failures.record(n);
+            }
+        }
+        if (!failures.empty()) {
+            const Size node = toBeFitted[failures.index()];
+            try {
+                failures.rethrow();
+            } catch (std::exception& e) {
+                QL_FAIL("global swaptions calibration failed: " << "\n" <<
+                        "option maturity = " << optionDates[node/nSwaps]
+                        << ", \n" <<
+                        "swap tenor = " << swapTenors[node%nSwaps] << "\n" <<
+                        e.what());
+            }
+        }
+
+        for (Size j=0; j<nOptions; j++) {
+            for (Size k=0; k<nSwaps; k++) {
+                const CalibrationNode& node = nodes[j*nSwaps+k];
+                alphas     [j][k] = node.result[0];
+                betas      [j][k] = node.result[1];
+                nus        [j][k] = node.result[2];
+                rhos       [j][k] = node.result[3];
+                forwards   [j][k] = node.result[4];
+                errors     [j][k] = node.result[5];
+                maxErrors  [j][k] = node.result[6];
+                endCriteria[j][k] = node.endCriteria;
+
+                QL_ENSURE(node.endCriteria!=EndCriteria::MaxIterations,
                           "global swaptions calibration failed: "
                           "MaxIterations reached: " << "\n" <<
                           "option maturity = " << optionDates[j] << ", \n" <<
@@ -209,6 +319,9 @@ namespace QuantLib {
                           "   nu = " << nus[j][k]   << "\n" <<
                           "   rho = " << rhos[j][k]
                           );
+
+                calibrationNodes_.insert(std::make_pair(
+                    std::make_pair(optionTimes[j], swapLengths[k]), node));
             }
         }
         Cube sabrParametersCube(optionDates, swapTenors,
@@ -506,17 +619,38 @@ namespace QuantLib {
             }
         }
 
+        std::vector<Real> moneyness(nStrikes_);
         for (Size k=0; k<nStrikes_; k++){
             const Real strike = atmForward + strikeSpreads_[k];
-            const Real moneyness = atmForward/strike;
+            moneyness[k] = atmForward/strike;
+        }
+
+        // each node smile is evaluated on all its strikes at once
+        std::vector<Real> nodeStrikes(nStrikes_);
+        std::vector<std::vector<Real> > nodeVols(4);
+        for (Size i=0; i<2; i++){
+            for (Size j=0; j<2; j++){
+                for (Size k=0; k<nStrikes_; k++)
+                    nodeStrikes[k] = atmForwards[i][j]/moneyness[k];
+                boost::shared_ptr<SabrSmileSection> sabrSmile =
+                    boost::dynamic_pointer_cast<SabrSmileSection>(
+                                                             smiles[i][j]);
+                std::vector<Real>& vols = nodeVols[2*i+j];
+                if (sabrSmile) {
+                    vols = sabrSmile->volatilities(nodeStrikes);
+                } else {
+                    vols.resize(nStrikes_);
+                    for (Size k=0; k<nStrikes_; k++)
+                        vols[k] = smiles[i][j]->volatility(nodeStrikes[k]);
+                }
+            }
+        }
 
-            Matrix strikes(2,2,0.);
+        for (Size k=0; k<nStrikes_; k++){
             Matrix spreadVols(2,2,0.);
             for (Size i=0; i<2; i++){
                 for (Size j=0; j<2; j++){
-                    strikes[i][j] = atmForwards[i][j]/moneyness;
-                    spreadVols[i][j] =
-                        smiles[i][j]->volatility(strikes[i][j]) - atmVols[i][j];
+                    spreadVols[i][j] = nodeVols[2*i+j][k] - atmVols[i][j];
                 }
             }
            Cube localInterpolator(optionsDateNodes, swapTenorNodes,
@@ -25,14 +25,35 @@
 #define quantlib_swaption_volcube_fit_early_interpolate_later_h
 
 #include <ql/termstructures/volatility/swaption/swaptionvolcube.hpp>
+#include <ql/math/optimization/endcriteria.hpp>
 #include <ql/math/matrix.hpp>
+#include <map>
 
 namespace QuantLib {
 
     class Interpolation2D;
-    class EndCriteria;
     class OptimizationMethod;
 
+    //! Swaption volatility cube, fit-early-interpolate-later approach
+    /*! A SABR smile is calibrated at each node of the cube. Nodes
+        whose forward and volatilities are the same as those of an
+        already calibrated node (e.g., the quoted nodes of the
+        ATM-calibrated cube) reuse its parameters.
+
+        If parallelCalibration is set, the SABR fits of the nodes are
+        spread across threads when OpenMP is enabled; this requires
+        either the default optimization method or a
+        LevenbergMarquardt instance, which is copied for each fit
+        (e.g., LevenbergMarquardt(1e-8, 1e-8, 1e-8, true) for fits
+        using the analytic SABR jacobian). Any other given method
+        would be shared among the fits, which are serial then.
+
+        If warmStart is set, the fits of a recalculation start from
+        the parameters calibrated at the same node in the previous
+        one (fixed parameters are still taken from the guess
+        quotes), and nodes whose quotes didn't move are not refitted
+        at all. Results then depend on the calculation history.
+    */
     class SwaptionVolCube1 : public SwaptionVolatilityCube {
         class Cube {
           public:
@@ -102,7 +123,9 @@ namespace QuantLib {
                 = boost::shared_ptr<EndCriteria>(),
             Real maxErrorTolerance = Null<Real>(),
             const boost::shared_ptr<OptimizationMethod>& optMethod
-                = boost::shared_ptr<OptimizationMethod>());
+                = boost::shared_ptr<OptimizationMethod>(),
+            bool parallelCalibration = false,
+            bool warmStart = false);
         //! \name LazyObject interface
         //@{
         void performCalculations() const;
@@ -140,6 +163,14 @@ namespace QuantLib {
         std::vector<Real> spreadVolInterpolation(const Date& atmOptionDate,
                                                  const Period& atmSwapTenor) const;
       private:
+        struct CalibrationNode {
+            Real forward;
+            std::vector<Real> volatilities, guess;
+            std::vector<Real> result;
+            EndCriteria::Type endCriteria;
+        };
+        typedef std::map<std::pair<Time, Time>, CalibrationNode>
+                                                          CalibrationNodes;
         mutable Cube marketVolCube_;
         mutable Cube volCubeAtmCalibrated_;
         mutable Cube sparseParameters_;
@@ -153,6 +184,8 @@ namespace QuantLib {
         const boost::shared_ptr<EndCriteria> endCriteria_;
         Real maxErrorTolerance_;
         const boost::shared_ptr<OptimizationMethod> optMethod_;
+        bool parallelCalibration_, warmStart_;
+        mutable CalibrationNodes calibrationNodes_, previousNodes_;
     };
 
 }
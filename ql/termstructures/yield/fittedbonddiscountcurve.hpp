@@ -265,6 +265,7 @@ namespace QuantLib {
     }
 
     inline void FittedBondDiscountCurve::update() {
+        clearDiscountCache();
         TermStructure::update();
         LazyObject::update();
     }
@@ -229,6 +229,8 @@ namespace QuantLib {
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::update() {
 
+        this->clearDiscountCache();
+
         // it dispatches notifications only if (!calculated_ && !frozen_)
         LazyObject::update();
 
@@ -249,8 +251,17 @@ namespace QuantLib {
 
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::performCalculations() const {
-        // just delegate to the bootstrapper
-        bootstrap_.calculate();
+        // just delegate to the bootstrapper; the nodes change
+        // during the bootstrap without notification, so the
+        // discount cache must be bypassed meanwhile.
+        this->suspendDiscountCache();
+        try {
+            bootstrap_.calculate();
+        } catch (...) {
+            this->resumeDiscountCache();
+            throw;
+        }
+        this->resumeDiscountCache();
     }
 
 }
@@ -35,7 +35,7 @@ namespace QuantLib {
                                     const std::vector<Date>& jumpDates)
     : TermStructure(dc), jumps_(jumps),
       jumpDates_(jumpDates), jumpTimes_(jumpDates.size()),
-      nJumps_(jumps_.size()) {
+      nJumps_(jumps_.size()), cacheDiscounts_(false), cacheSuspended_(false) {
         setJumps();
         for (Size i=0; i<nJumps_; ++i)
             registerWith(jumps_[i]);
@@ -49,7 +49,7 @@ namespace QuantLib {
                                     const std::vector<Date>& jumpDates)
     : TermStructure(referenceDate, cal, dc), jumps_(jumps),
       jumpDates_(jumpDates), jumpTimes_(jumpDates.size()),
-      nJumps_(jumps_.size()) {
+      nJumps_(jumps_.size()), cacheDiscounts_(false), cacheSuspended_(false) {
         setJumps();
         for (Size i=0; i<nJumps_; ++i)
             registerWith(jumps_[i]);
@@ -63,7 +63,7 @@ namespace QuantLib {
                                     const std::vector<Date>& jumpDates)
     : TermStructure(settlementDays, cal, dc), jumps_(jumps),
       jumpDates_(jumpDates), jumpTimes_(jumpDates.size()),
-      nJumps_(jumps_.size()) {
+      nJumps_(jumps_.size()), cacheDiscounts_(false), cacheSuspended_(false) {
         setJumps();
         for (Size i=0; i<nJumps_; ++i)
             registerWith(jumps_[i]);
@@ -86,6 +86,47 @@ namespace QuantLib {
         latestReference_ = referenceDate();
     }
 
+    void YieldTermStructure::clearDiscountCache() const {
+        ParallelLock::Guard guard(cacheLock_);
+        discountCache_.clear();
+        cacheReference_ = Date();
+    }
+
+    DiscountFactor YieldTermStructure::cachedDiscount(const Date& d,
+                                                      bool extrapolate) const {
+        const Date today = referenceDate();
+        if (d < today)
+            return discount(timeFromReference(d), extrapolate);
+
+        const Size i = d - today;
+        DiscountFactor result = Null<DiscountFactor>();
+        {
+            // lookups only share the lock; values stored for another
+            // reference date are discarded when inserting
+            ParallelLock::SharedGuard guard(cacheLock_);
+            if (cacheReference_ == today && i < discountCache_.size())
+                result = discountCache_[i];
+        }
+        if (result != Null<DiscountFactor>())
+            return result;
+
+        // the range check is performed here; only values for dates
+        // within the curve range are stored, so that later lookups
+        // don't need to repeat it.
+        result = discount(timeFromReference(d), extrapolate);
+        if (d <= maxDate()) {
+            ParallelLock::Guard guard(cacheLock_);
+            if (cacheReference_ != today) {
+                discountCache_.clear();
+                cacheReference_ = today;
+            }
+            if (i >= discountCache_.size())
+                discountCache_.resize(i+1, Null<DiscountFactor>());
+            discountCache_[i] = result;
+        }
+        return result;
+    }
+
     DiscountFactor YieldTermStructure::discount(Time t,
                                                 bool extrapolate) const {
         checkRange(t, extrapolate);
@@ -29,6 +29,7 @@
 #include <ql/termstructure.hpp>
 #include <ql/interestrate.hpp>
 #include <ql/quote.hpp>
+#include <ql/utilities/parallellock.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -152,6 +153,29 @@ namespace QuantLib {
         const std::vector<Time>& jumpTimes() const;
         //@}
 
+        /*! \name Discount cache
+
+            When enabled, the discount factors returned for given
+            dates are stored and returned again without converting
+            the date into a time and without calling discountImpl.
+            This is useful when many instruments are priced on the
+            same curve, e.g., a large book of swaps whose payment
+            dates are shared.
+
+            The stored values are discarded whenever the curve is
+            notified of a change or its reference date moves.
+            Lookups can be performed concurrently from several
+            threads when the library is compiled with OpenMP; they
+            share a lock owned by the curve, which is only acquired
+            exclusively to store new values, so that lookups don't
+            wait for each other.
+        */
+        //@{
+        void enableDiscountCache(bool b = true);
+        void disableDiscountCache();
+        bool discountCacheEnabled() const;
+        //@}
+
         //! \name Observer interface
         //@{
         void update();
@@ -168,15 +192,31 @@ namespace QuantLib {
         //! discount factor calculation
         virtual DiscountFactor discountImpl(Time) const = 0;
         //@}
+        /*! derived classes that override update() without calling
+            YieldTermStructure::update() must call this method.
+        */
+        void clearDiscountCache() const;
+        /*! derived classes whose data change without notification,
+            e.g., while being bootstrapped, must bypass the cache
+            by calling these methods around the changes.
+        */
+        void suspendDiscountCache() const;
+        void resumeDiscountCache() const;
       private:
         // methods
         void setJumps();
+        DiscountFactor cachedDiscount(const Date& d, bool extrapolate) const;
         // data members
         std::vector<Handle<Quote> > jumps_;
         std::vector<Date> jumpDates_;
         std::vector<Time> jumpTimes_;
         Size nJumps_;
         Date latestReference_;
+        bool cacheDiscounts_;
+        mutable bool cacheSuspended_;
+        mutable Date cacheReference_;
+        mutable std::vector<DiscountFactor> discountCache_;
+        ParallelLock cacheLock_;
     };
 
     // inline definitions
@@ -184,6 +224,8 @@ namespace QuantLib {
     inline
     DiscountFactor YieldTermStructure::discount(const Date& d,
                                                 bool extrapolate) const {
+        if (cacheDiscounts_ && !cacheSuspended_)
+            return cachedDiscount(d, extrapolate);
         return discount(timeFromReference(d), extrapolate);
     }
 
@@ -205,7 +247,30 @@ namespace QuantLib {
         return this->jumpTimes_;
     }
 
+    inline void YieldTermStructure::enableDiscountCache(bool b) {
+        cacheDiscounts_ = b;
+        clearDiscountCache();
+    }
+
+    inline void YieldTermStructure::disableDiscountCache() {
+        enableDiscountCache(false);
+    }
+
+    inline bool YieldTermStructure::discountCacheEnabled() const {
+        return cacheDiscounts_;
+    }
+
+    inline void YieldTermStructure::suspendDiscountCache() const {
+        cacheSuspended_ = true;
+    }
+
+    inline void YieldTermStructure::resumeDiscountCache() const {
+        clearDiscountCache();
+        cacheSuspended_ = false;
+    }
+
     inline void YieldTermStructure::update() {
+        clearDiscountCache();
         TermStructure::update();
         if (referenceDate() != latestReference_)
             setJumps();
@@ -78,4 +78,10 @@
 //#   define QL_ENABLE_SESSIONS
 #endif
 
+/* Define this if matrix operations should use BLAS and LAPACK. You will
+   have to link with the corresponding libraries. */
+#ifndef QL_USE_LAPACK
+//#   define QL_USE_LAPACK
+#endif
+
 #endif
@@ -7,6 +7,8 @@
 #include <ql/utilities/disposable.hpp>
 #include <ql/utilities/null.hpp>
 #include <ql/utilities/observablevalue.hpp>
+#include <ql/utilities/parallelerrors.hpp>
+#include <ql/utilities/parallellock.hpp>
 #include <ql/utilities/steppingiterator.hpp>
 #include <ql/utilities/tracing.hpp>
 #include <ql/utilities/vectors.hpp>
@@ -37,6 +37,9 @@ namespace QuantLib {
               returned value. This is by design, as this possibility
               would necessarily bypass the notification code; client
               code should modify the value via re-assignment instead.
+        \note this class is used for global data such as the
+              evaluation date; therefore, observers can register
+              with it from several threads (see GlobalObservable).
     */
     template <class T>
     class ObservableValue {
@@ -64,15 +67,15 @@ namespace QuantLib {
 
     template <class T>
     ObservableValue<T>::ObservableValue()
-    : value_(), observable_(new Observable) {}
+    : value_(), observable_(new GlobalObservable) {}
 
     template <class T>
     ObservableValue<T>::ObservableValue(const T& t)
-    : value_(t), observable_(new Observable) {}
+    : value_(t), observable_(new GlobalObservable) {}
 
     template <class T>
     ObservableValue<T>::ObservableValue(const ObservableValue<T>& t)
-    : value_(t.value_), observable_(new Observable) {}
+    : value_(t.value_), observable_(new GlobalObservable) {}
 
     template <class T>
     ObservableValue<T>& ObservableValue<T>::operator=(const T& t) {
@@ -0,0 +1,67 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/utilities/parallelerrors.hpp>
+#include <ql/errors.hpp>
+#include <exception>
+
+namespace QuantLib {
+
+    ParallelErrors::ParallelErrors()
+    : failed_(false), index_(0) {}
+
+    void ParallelErrors::record(Size index) {
+        std::string message;
+        try {
+            throw;
+        } catch (std::exception& e) {
+            message = e.what();
+        } catch (...) {
+            message = "unknown error";
+        }
+
+        #if defined(_OPENMP)
+        #pragma omp critical(ql_parallel_errors)
+        #endif
+        {
+            if (!failed_ || index < index_) {
+                failed_ = true;
+                index_ = index;
+                message_.swap(message);
+            }
+        }
+    }
+
+    Size ParallelErrors::index() const {
+        QL_REQUIRE(failed_, "no error recorded");
+        return index_;
+    }
+
+    void ParallelErrors::rethrow(const std::string& label) {
+        if (!failed_)
+            return;
+
+        failed_ = false;
+        std::string message;
+        message.swap(message_);
+        if (label.empty())
+            QL_FAIL(message);
+        else
+            QL_FAIL(label << " " << index_ << " failed: " << message);
+    }
+
+}
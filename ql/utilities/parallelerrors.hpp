@@ -0,0 +1,74 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file parallelerrors.hpp
+    \brief errors raised inside parallel loops
+*/
+
+#ifndef quantlib_parallel_errors_hpp
+#define quantlib_parallel_errors_hpp
+
+#include <ql/types.hpp>
+#include <string>
+
+namespace QuantLib {
+
+    //! errors raised inside OpenMP parallel loops
+    /*! Exceptions can't leave an OpenMP parallel region.  The loop
+        body catches them and records them together with the index
+        of the failed iteration; after the loop, rethrow() raises the
+        error recorded for the lowest index, so that the reported
+        error doesn't depend on thread scheduling:
+        \code
+        ParallelErrors errors;
+        #pragma omp parallel for
+        for (Integer i=0; i<n; ++i) {
+            try {
+                ...
+            } catch (...) {
+                errors.record(i);
+            }
+        }
+        errors.rethrow();
+        \endcode
+        No memory is allocated unless an error is recorded.
+    */
+    class ParallelErrors {
+      public:
+        ParallelErrors();
+        //! records the exception being handled
+        /*! \pre it must be called from inside a catch block. */
+        void record(Size index);
+        bool empty() const { return !failed_; }
+        //! index of the recorded error
+        /*! \pre an error must have been recorded. */
+        Size index() const;
+        //! throws the recorded error, if any, and clears it
+        /*! If a label is given, the error message is prefixed by
+            the label and the index of the failed iteration.
+        */
+        void rethrow(const std::string& label = std::string());
+      private:
+        bool failed_;
+        Size index_;
+        std::string message_;
+    };
+
+}
+
+
+#endif
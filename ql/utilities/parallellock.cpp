@@ -0,0 +1,139 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/utilities/parallellock.hpp>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace QuantLib {
+
+    #if defined(_OPENMP)
+
+    // writers are serialized by the OpenMP lock; readers only
+    // update a counter, unless OpenMP lacks atomic reads and writes
+    struct ParallelLock::Impl {
+        Impl() : readers(0), writing(0) { omp_init_lock(&lock); }
+        ~Impl() { omp_destroy_lock(&lock); }
+        omp_lock_t lock;
+        int readers, writing;
+    };
+
+    ParallelLock::ParallelLock() : impl_(new Impl) {}
+
+    ParallelLock::ParallelLock(const ParallelLock&) : impl_(new Impl) {}
+
+    ParallelLock::~ParallelLock() {
+        delete impl_;
+    }
+
+    #if _OPENMP >= 201107
+
+    void ParallelLock::acquire() const {
+        omp_set_lock(&impl_->lock);
+        #pragma omp atomic write
+        impl_->writing = 1;
+        // a reader registering from now on sees the flag; those
+        // registered before must leave first
+        #pragma omp flush
+        int readers;
+        do {
+            #pragma omp atomic read
+            readers = impl_->readers;
+        } while (readers != 0);
+        #pragma omp flush
+    }
+
+    void ParallelLock::release() const {
+        #pragma omp flush
+        #pragma omp atomic write
+        impl_->writing = 0;
+        omp_unset_lock(&impl_->lock);
+    }
+
+    void ParallelLock::acquireShared() const {
+        for (;;) {
+            #pragma omp atomic
+            ++impl_->readers;
+            #pragma omp flush
+            int writing;
+            #pragma omp atomic read
+            writing = impl_->writing;
+            if (writing == 0)
+                break;
+            // step back until the writer is done
+            #pragma omp atomic
+            --impl_->readers;
+            do {
+                #pragma omp atomic read
+                writing = impl_->writing;
+            } while (writing != 0);
+        }
+        #pragma omp flush
+    }
+
+    void ParallelLock::releaseShared() const {
+        #pragma omp flush
+        #pragma omp atomic
+        --impl_->readers;
+    }
+
+    #else
+
+    void ParallelLock::acquire() const {
+        omp_set_lock(&impl_->lock);
+    }
+
+    void ParallelLock::release() const {
+        omp_unset_lock(&impl_->lock);
+    }
+
+    void ParallelLock::acquireShared() const {
+        acquire();
+    }
+
+    void ParallelLock::releaseShared() const {
+        release();
+    }
+
+    #endif
+
+    #else
+
+    struct ParallelLock::Impl {};
+
+    ParallelLock::ParallelLock() : impl_(0) {}
+
+    ParallelLock::ParallelLock(const ParallelLock&) : impl_(0) {}
+
+    ParallelLock::~ParallelLock() {}
+
+    void ParallelLock::acquire() const {}
+
+    void ParallelLock::release() const {}
+
+    void ParallelLock::acquireShared() const {}
+
+    void ParallelLock::releaseShared() const {}
+
+    #endif
+
+    ParallelLock& ParallelLock::operator=(const ParallelLock&) {
+        return *this;
+    }
+
+}
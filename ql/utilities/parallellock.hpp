@@ -0,0 +1,91 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file parallellock.hpp
+    \brief lock protecting the data of a single object
+*/
+
+#ifndef quantlib_parallel_lock_hpp
+#define quantlib_parallel_lock_hpp
+
+namespace QuantLib {
+
+    //! lock protecting the data of a single object
+    /*! Unlike named OpenMP critical sections, which are shared by
+        all instances of a class, each instance of this class owns
+        its lock; it can be used as a data member to protect, e.g.,
+        a cache, without serializing the accesses to the caches of
+        other objects.
+
+        When the library is compiled without OpenMP, locking and
+        unlocking do nothing.  The size of the class doesn't depend
+        on the compilation flags.
+
+        The lock can also be acquired in shared mode by readers of
+        the data, which then don't wait for each other; acquire()
+        waits until all shared owners have released the lock, and
+        shared acquisitions wait for the exclusive owner.  With
+        OpenMP versions before 3.1, which lack atomic reads and
+        writes, shared acquisitions are exclusive.  A thread must
+        not acquire the lock again, in either mode, while owning it.
+
+        Copies and assignments don't share or change the lock: a
+        copy owns a new one.
+    */
+    class ParallelLock {
+      public:
+        ParallelLock();
+        ParallelLock(const ParallelLock&);
+        ParallelLock& operator=(const ParallelLock&);
+        ~ParallelLock();
+        void acquire() const;
+        void release() const;
+        void acquireShared() const;
+        void releaseShared() const;
+        //! acquires the lock and releases it when going out of scope
+        class Guard {
+          public:
+            explicit Guard(const ParallelLock& lock) : lock_(lock) {
+                lock_.acquire();
+            }
+            ~Guard() { lock_.release(); }
+          private:
+            Guard(const Guard&);
+            Guard& operator=(const Guard&);
+            const ParallelLock& lock_;
+        };
+        //! acquires the lock in shared mode for the current scope
+        class SharedGuard {
+          public:
+            explicit SharedGuard(const ParallelLock& lock) : lock_(lock) {
+                lock_.acquireShared();
+            }
+            ~SharedGuard() { lock_.releaseShared(); }
+          private:
+            SharedGuard(const SharedGuard&);
+            SharedGuard& operator=(const SharedGuard&);
+            const ParallelLock& lock_;
+        };
+      private:
+        struct Impl;
+        Impl* impl_;
+    };
+
+}
+
+
+#endif
@@ -556,6 +556,71 @@ void AmericanOptionTest::testFdShoutGreeks() {
     testFdGreeks<FDShoutEngine<CrankNicolson> >();
 }
 
+void AmericanOptionTest::testFdEngineReuse() {
+
+    BOOST_MESSAGE("Testing reuse of finite-difference American engine...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.03));
+    Handle<YieldTermStructure> qTS(flatRate(qRate, dc));
+    boost::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.05));
+    Handle<YieldTermStructure> rTS(flatRate(rRate, dc));
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.25));
+    Handle<BlackVolTermStructure> volTS(flatVol(vol, dc));
+
+    boost::shared_ptr<BlackScholesMertonProcess> stochProcess(
+                            new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                                          qTS, rTS, volTS));
+
+    boost::shared_ptr<Exercise> exercise(
+                            new AmericanExercise(today, today + 1*Years));
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                            new PlainVanillaPayoff(Option::Put, 100.0));
+
+    // the engine keeps its operator between calculations; it must
+    // be rebuilt whenever the grid or the market changes
+    boost::shared_ptr<PricingEngine> engine(
+                    new FDAmericanEngine<CrankNicolson>(stochProcess, 100, 100));
+    VanillaOption option(payoff, exercise);
+    option.setPricingEngine(engine);
+
+    Real tolerance = 1.0e-12;
+
+    for (Size i=0; i<4; ++i) {
+        switch (i) {
+          case 1: vol->setValue(0.35);   break;
+          case 2: rRate->setValue(0.02); break;
+          case 3: spot->setValue(90.0);  break;
+          default: break;
+        }
+
+        // reprice with the same engine, twice to hit the cache
+        option.recalculate();
+        option.NPV();
+        option.recalculate();
+        Real calculated = option.NPV();
+
+        VanillaOption reference(payoff, exercise);
+        reference.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                 new FDAmericanEngine<CrankNicolson>(stochProcess, 100, 100)));
+        Real expected = reference.NPV();
+
+        Real error = std::fabs(calculated-expected);
+        if (error > tolerance) {
+            REPORT_FAILURE("value", payoff, exercise, spot->value(),
+                           qRate->value(), rRate->value(), today,
+                           vol->value(), expected, calculated,
+                           error, tolerance);
+        }
+    }
+}
+
 test_suite* AmericanOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("American option tests");
     suite->add(
@@ -570,6 +635,7 @@ test_suite* AmericanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdAmericanGreeks));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdShoutGreeks));
+    suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdEngineReuse));
     return suite;
 }
 
@@ -32,6 +32,7 @@
 #include <ql/pricingengines/barrier/fdblackscholesbarrierengine.hpp>
 #include <ql/experimental/barrieroption/perturbativebarrieroptionengine.hpp>
 #include <ql/pricingengines/barrier/mcbarrierengine.hpp>
+#include <ql/pricingengines/richardsonextrapolationengine.hpp>
 #include <ql/termstructures/yield/zerocurve.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
@@ -699,6 +700,62 @@ void BarrierOptionTest::testLocalVolAndHestonComparison() {
 }
 
 
+void BarrierOptionTest::testRichardsonExtrapolation() {
+
+    BOOST_MESSAGE("Testing Richardson extrapolation of FD barrier "
+                  "option values...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today(28, March, 2004);
+    const Date exerciseDate(28, March, 2005);
+    Settings::instance().evaluationDate() = today;
+
+    Handle<Quote> spot(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    Handle<BlackVolTermStructure> volTS(flatVol(today, 0.25, dc));
+
+    boost::shared_ptr<BlackScholesMertonProcess> bsProcess(
+                      new BlackScholesMertonProcess(spot, qTS, rTS, volTS));
+
+    boost::shared_ptr<Exercise> exercise(new EuropeanExercise(exerciseDate));
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                   new PlainVanillaPayoff(Option::Put, 105));
+
+    // the engines refine both the time and the space grid
+    std::vector<boost::shared_ptr<PricingEngine> > engines;
+    for (Size tGrid=25, xGrid=50; tGrid <= 100; tGrid*=2, xGrid*=2) {
+        engines.push_back(boost::shared_ptr<PricingEngine>(
+            new FdBlackScholesBarrierEngine(bsProcess, tGrid, xGrid, 0,
+                                            FdmSchemeDesc::Douglas())));
+    }
+
+    BarrierOption barrierOption(Barrier::DownOut, 90.0, 0.0,
+                                payoff, exercise);
+    barrierOption.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                  new AnalyticBarrierEngine(bsProcess)));
+    const Real expected = barrierOption.NPV();
+
+    barrierOption.setPricingEngine(engines.back());
+    const Real finestError = std::fabs(barrierOption.NPV() - expected);
+
+    // the barrier isn't on the grid, hence first-order convergence
+    barrierOption.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new RichardsonExtrapolationEngine<BarrierOption::arguments>(
+                                                     engines, 2.0, 1.0)));
+    const Real calculated = barrierOption.NPV();
+
+    if (std::fabs(calculated - expected) > 0.01*finestError) {
+        BOOST_ERROR("Failed to extrapolate barrier option value"
+                    << "\n    calculated:  " << calculated
+                    << "\n    expected:    " << expected
+                    << "\n    finest grid: " << expected + finestError);
+    }
+}
+
+
 test_suite* BarrierOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Barrier option tests");
     suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testHaugValues));
@@ -707,5 +764,7 @@ test_suite* BarrierOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testPerturbative));
     suite->add(QUANTLIB_TEST_CASE(
                         &BarrierOptionTest::testLocalVolAndHestonComparison));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &BarrierOptionTest::testRichardsonExtrapolation));
     return suite;
 }
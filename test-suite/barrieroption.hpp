@@ -32,6 +32,7 @@ class BarrierOptionTest {
     static void testBeagleholeValues();
     static void testPerturbative();
     static void testLocalVolAndHestonComparison();
+    static void testRichardsonExtrapolation();
     static boost::unit_test_framework::test_suite* suite();
 };
 
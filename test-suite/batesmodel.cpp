@@ -34,6 +34,7 @@
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanhestonengine.hpp>
 #include <ql/pricingengines/vanilla/fdbatesvanillaengine.hpp>
+#include <ql/experimental/variancegamma/fftbatesengine.hpp>
 #include <ql/models/equity/batesmodel.hpp>
 #include <ql/models/equity/hestonmodelhelper.hpp>
 #include <ql/time/period.hpp>
@@ -533,12 +534,94 @@ void BatesModelTest::testDAXCalibration() {
     }
 }
 
+void BatesModelTest::testFourierEngines() {
+    BOOST_MESSAGE("Testing FFT and COS Bates engines...");
+
+    SavedSettings backup;
+
+    Date settlementDate(27, December, 2004);
+    Settings::instance().evaluationDate() = settlementDate;
+    DayCounter dayCounter = ActualActual();
+
+    Handle<YieldTermStructure> riskFreeTS(flatRate(0.05, dayCounter));
+    Handle<YieldTermStructure> dividendTS(flatRate(0.02, dayCounter));
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    boost::shared_ptr<BatesModel> model(new BatesModel(
+        boost::shared_ptr<BatesProcess>(
+            new BatesProcess(riskFreeTS, dividendTS, s0,
+                             0.04, 1.5, 0.09, 0.6, -0.7,
+                             1.0, -0.1, 0.15))));
+
+    boost::shared_ptr<PricingEngine> analyticEngine(
+                                                new BatesEngine(model, 160));
+    boost::shared_ptr<FFTEngine> engines[] = {
+        boost::shared_ptr<FFTEngine>(new FFTBatesEngine(model)),
+        boost::shared_ptr<FFTEngine>(new COSBatesEngine(model))
+    };
+    std::string names[] = { "FFT", "COS" };
+    Real tolerances[] = { 1e-4, 1e-6 };
+
+    Date exerciseDates[] = { Date(28, March, 2005),
+                             Date(27, December, 2006) };
+
+    std::vector<boost::shared_ptr<Instrument> > options;
+    std::vector<Real> expected;
+    for (Size i=0; i<LENGTH(exerciseDates); ++i) {
+        boost::shared_ptr<Exercise> exercise(
+                                     new EuropeanExercise(exerciseDates[i]));
+        for (Real strike = 60.0; strike <= 150.0; strike += 10.0) {
+            for (Size k=0; k<2; ++k) {
+                Option::Type type = (k == 0) ? Option::Call : Option::Put;
+                boost::shared_ptr<VanillaOption> option(new VanillaOption(
+                    boost::shared_ptr<StrikedTypePayoff>(
+                                     new PlainVanillaPayoff(type, strike)),
+                    exercise));
+                option->setPricingEngine(analyticEngine);
+                expected.push_back(option->NPV());
+                options.push_back(option);
+            }
+        }
+    }
+
+    for (Size i=0; i<LENGTH(engines); ++i) {
+        engines[i]->precalculate(options);
+
+        for (Size j=0; j<options.size(); ++j) {
+            boost::shared_ptr<VanillaOption> option =
+                boost::dynamic_pointer_cast<VanillaOption>(options[j]);
+            option->setPricingEngine(engines[i]);
+            Real calculated = option->NPV();
+
+            if (std::fabs(calculated - expected[j]) > tolerances[i]) {
+                boost::shared_ptr<StrikedTypePayoff> payoff =
+                    boost::dynamic_pointer_cast<StrikedTypePayoff>(
+                                                         option->payoff());
+                BOOST_ERROR("failed to reproduce analytic Bates price"
+                            << "\n    engine:     " << names[i]
+                            << "\n    expiry:     "
+                            << option->exercise()->lastDate()
+                            << "\n    type:       " << payoff->optionType()
+                            << "\n    strike:     " << payoff->strike()
+                            << QL_FIXED << std::setprecision(8)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected[j]
+                            << QL_SCIENTIFIC
+                            << "\n    error:      "
+                            << std::fabs(calculated - expected[j])
+                            << "\n    tolerance:  " << tolerances[i]);
+            }
+        }
+    }
+}
+
 test_suite* BatesModelTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Bates model tests");
     suite->add(QUANTLIB_TEST_CASE(&BatesModelTest::testAnalyticVsBlack));
     suite->add(QUANTLIB_TEST_CASE(
                         &BatesModelTest::testAnalyticAndMcVsJumpDiffusion));
     suite->add(QUANTLIB_TEST_CASE(&BatesModelTest::testAnalyticVsMCPricing));
+    suite->add(QUANTLIB_TEST_CASE(&BatesModelTest::testFourierEngines));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&BatesModelTest::testDAXCalibration));
     return suite;
@@ -256,9 +256,52 @@ void CdoTest::testHW() {
     }
 }
 
+void CdoTest::testConditionalProbabilities() {
+
+    BOOST_MESSAGE ("Testing batched conditional default probabilities...");
+
+    boost::shared_ptr<SimpleQuote> correlation(new SimpleQuote(0.3));
+    Handle<Quote> hCorrelation(correlation);
+
+    std::vector<boost::shared_ptr<OneFactorCopula> > copulas;
+    copulas.push_back(boost::shared_ptr<OneFactorCopula>(
+                            new OneFactorGaussianCopula(hCorrelation)));
+    copulas.push_back(boost::shared_ptr<OneFactorCopula>(
+                            new OneFactorStudentCopula(hCorrelation, 5, 5)));
+
+    // a vanishing probability is skipped by the copula
+    Real p[] = { 0.0, 0.001, 0.01, 0.05, 0.2, 0.5 };
+    vector<Real> prob(p, p + LENGTH(p));
+    Real f[] = { -3.0, -1.0, 0.0, 0.5, 2.5 };
+    vector<Real> m(f, f + LENGTH(f));
+
+    Real tolerance = 1.0e-14;
+
+    for (Size k = 0; k < copulas.size(); k++) {
+        Matrix grid = copulas[k]->conditionalProbability(prob, m);
+        vector<Real> y = copulas[k]->thresholds(prob);
+        vector<Real> batched;
+        for (Size j = 0; j < m.size(); j++) {
+            copulas[k]->conditionalProbability(prob, y, m[j], batched);
+            for (Size i = 0; i < prob.size(); i++) {
+                Real expected =
+                    copulas[k]->conditionalProbability(prob[i], m[j]);
+                BOOST_CHECK_MESSAGE (fabs(batched[i] - expected) < tolerance
+                                     && fabs(grid[j][i] - expected) < tolerance,
+                                     "copula " << k << ", p = " << prob[i]
+                                     << ", m = " << m[j] << ": "
+                                     << batched[i] << " (thresholds), "
+                                     << grid[j][i] << " (grid) vs. "
+                                     << expected);
+            }
+        }
+    }
+}
+
 
 test_suite* CdoTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("CDO tests");
     suite->add(QUANTLIB_TEST_CASE(&CdoTest::testHW));
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testConditionalProbabilities));
     return suite;
 }
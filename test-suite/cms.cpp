@@ -477,10 +477,117 @@ void CmsTest::testParity() {
     }
 }
 
+void CmsTest::testStoredReplications() {
+
+    BOOST_MESSAGE("Testing reuse of replication integrals across coupons...");
+
+    CommonVars vars;
+
+    // three identical trades, each with its own index instance
+    std::vector<shared_ptr<Swap> > cms(3);
+    for (Size i=0; i<cms.size(); ++i) {
+        shared_ptr<SwapIndex> swapIndex(new
+            EuriborSwapIsdaFixA(10*Years,
+                                vars.iborIndex->forwardingTermStructure()));
+        cms[i] = MakeCms(Period(5, Years), swapIndex,
+                         vars.iborIndex, 0.0, 10*Days);
+    }
+    const Leg& firstLeg = cms[0]->leg(0);
+    const Leg& secondLeg = cms[1]->leg(0);
+    const Leg& thirdLeg = cms[2]->leg(0);
+
+    const Date referenceDate = vars.termStructure->referenceDate();
+    const Rate levels[] = { 0.05, 0.055 };
+    Handle<Quote> zeroMeanRev(shared_ptr<Quote>(new SimpleQuote(0.0)));
+    const Real tolerance = 1.0e-10;
+
+    for (Size j=0; j<vars.yieldCurveModels.size(); ++j) {
+        shared_ptr<NumericHaganPricer> pricer =
+            boost::dynamic_pointer_cast<NumericHaganPricer>(
+                                                   vars.numericalPricers[j]);
+        pricer->setSwaptionVolatility(vars.atmVol);
+        if (pricer->storedReplications() != 0)
+            BOOST_ERROR("replication integrals not cleared on notification"
+                        "\nYieldCurve Model:    " << vars.yieldCurveModels[j]);
+
+        setCouponPricer(firstLeg, pricer);
+        setCouponPricer(secondLeg, pricer);
+
+        for (Size k=0; k<LENGTH(levels); ++k) {
+            // a curve scenario must clear the stored values
+            vars.termStructure.linkTo(flatRate(referenceDate, levels[k],
+                                               Actual365Fixed()));
+            if (pricer->storedReplications() != 0)
+                BOOST_ERROR("replication integrals not cleared on "
+                            "curve change"
+                            "\nYieldCurve Model:    "
+                            << vars.yieldCurveModels[j] <<
+                            "\nrate level:          " << levels[k]);
+
+            std::vector<Rate> expected(firstLeg.size());
+            for (Size i=0; i<firstLeg.size(); ++i)
+                expected[i] =
+                    boost::dynamic_pointer_cast<Coupon>(firstLeg[i])->rate();
+            Size stored = pricer->storedReplications();
+
+            // the second leg is priced backwards; the stored values
+            // don't depend on the order
+            std::vector<Rate> calculated(secondLeg.size());
+            for (Size i=secondLeg.size(); i>0; --i)
+                calculated[i-1] = boost::dynamic_pointer_cast<Coupon>(
+                                                 secondLeg[i-1])->rate();
+            if (pricer->storedReplications() != stored)
+                BOOST_ERROR("replication integrals not reused by identical "
+                            "coupons:"
+                            "\nYieldCurve Model:    "
+                            << vars.yieldCurveModels[j] <<
+                            "\nstored after first leg:  " << stored <<
+                            "\nstored after second leg: " <<
+                            pricer->storedReplications());
+
+            for (Size i=0; i<expected.size(); ++i) {
+                // a new pricer for each coupon doesn't reuse anything
+                setCouponPricer(Leg(1, thirdLeg[i]),
+                                shared_ptr<FloatingRateCouponPricer>(new
+                                    NumericHaganPricer(vars.atmVol,
+                                                       vars.yieldCurveModels[j],
+                                                       zeroMeanRev)));
+                Rate uncached =
+                    boost::dynamic_pointer_cast<Coupon>(thirdLeg[i])->rate();
+
+                if (calculated[i] != expected[i]
+                    || std::fabs(calculated[i] - uncached) > tolerance)
+                    BOOST_ERROR("\nCoupon #" << i <<
+                                "\nYieldCurve Model:    "
+                                << vars.yieldCurveModels[j] <<
+                                "\nrate level:          " << levels[k] <<
+                                "\nexpected rate:       "
+                                << io::rate(expected[i]) <<
+                                "\ncalculated rate:     "
+                                << io::rate(calculated[i]) <<
+                                "\nuncached rate:       "
+                                << io::rate(uncached));
+            }
+        }
+
+        // so must a change of evaluation date, which the stored
+        // values don't depend on otherwise
+        Date today = Settings::instance().evaluationDate();
+        Settings::instance().evaluationDate() = today + 1;
+        if (pricer->storedReplications() != 0)
+            BOOST_ERROR("replication integrals not cleared on "
+                        "evaluation-date change"
+                        "\nYieldCurve Model:    "
+                        << vars.yieldCurveModels[j]);
+        Settings::instance().evaluationDate() = today;
+    }
+}
+
 test_suite* CmsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cms tests");
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testFairRate));
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testCmsSwap));
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testParity));
+    suite->add(QUANTLIB_TEST_CASE(&CmsTest::testStoredReplications));
     return suite;
 }
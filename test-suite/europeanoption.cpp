@@ -27,6 +27,7 @@
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
+#include <ql/pricingengines/blackformula.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/binomialengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
@@ -34,10 +35,12 @@
 #include <ql/pricingengines/vanilla/fdeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/integralengine.hpp>
+#include <ql/pricingengines/richardsonextrapolationengine.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/yield/zerocurve.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/termstructures/volatility/equityfx/blackvariancesurface.hpp>
+#include <ql/termstructures/volatility/equityfx/interpolatedlocalvolsurface.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <boost/progress.hpp>
 #include <map>
@@ -926,6 +929,105 @@ void EuropeanOptionTest::testImpliedVol() {
 }
 
 
+void EuropeanOptionTest::testBatchedImpliedVol() {
+
+    BOOST_MESSAGE("Testing batched Black formula and implied volatility...");
+
+    Real fwds[] = { 100.0 };
+    Real stdDevs[] = { 0.01, 0.05, 0.2, 0.5, 1.0 };
+    Real moneyness[] = { 0.0, 0.7, 0.9, 0.97, 1.0, 1.03, 1.1, 1.5, 2.5 };
+    Real displacements[] = { 0.0, 25.0 };
+    Option::Type types[] = { Option::Call, Option::Put };
+
+    std::vector<Real> strikes, sd, discounts;
+    for (Size i=0; i<LENGTH(stdDevs); ++i) {
+        for (Size j=0; j<LENGTH(moneyness); ++j) {
+            strikes.push_back(fwds[0]*moneyness[j]);
+            sd.push_back(stdDevs[i]);
+            discounts.push_back(std::exp(-0.01*(i+1)));
+        }
+    }
+    const std::vector<Real> forwards(fwds, fwds+LENGTH(fwds));
+
+    for (Size k=0; k<LENGTH(types); ++k) {
+        for (Size d=0; d<LENGTH(displacements); ++d) {
+            const Option::Type type = types[k];
+            const Real displacement = displacements[d];
+
+            const std::vector<Real> prices = blackFormula(
+                       type, strikes, forwards, sd, discounts, displacement);
+            const std::vector<Real> vegas = blackFormulaStdDevDerivative(
+                             strikes, forwards, sd, discounts, displacement);
+
+            for (Size i=0; i<strikes.size(); ++i) {
+                const Real expected = blackFormula(type, strikes[i],
+                    forwards[0], sd[i], discounts[i], displacement);
+                const Real expectedVega = blackFormulaStdDevDerivative(
+                    strikes[i], forwards[0], sd[i], discounts[i],
+                    displacement);
+                if (std::fabs(prices[i]-expected) > 1e-12
+                    || std::fabs(vegas[i]-expectedVega) > 1e-12) {
+                    BOOST_FAIL("batched Black formula differs from "
+                               "scalar one:"
+                               << "\n    type:          " << type
+                               << "\n    strike:        " << strikes[i]
+                               << "\n    std dev:       " << sd[i]
+                               << "\n    displacement:  " << displacement
+                               << "\n    price:         " << prices[i]
+                               << "\n    expected:      " << expected
+                               << "\n    vega:          " << vegas[i]
+                               << "\n    expected vega: " << expectedVega);
+                }
+            }
+
+            // prices without time value carry no volatility information
+            std::vector<Real> k2, sd2, p2, disc2;
+            for (Size i=0; i<strikes.size(); ++i) {
+                const Real intrinsic = discounts[i]*std::max(
+                              type*(forwards[0]-strikes[i]), Real(0.0));
+                if (prices[i] - intrinsic > 1e-8) {
+                    k2.push_back(strikes[i]);
+                    sd2.push_back(sd[i]);
+                    p2.push_back(prices[i]);
+                    disc2.push_back(discounts[i]);
+                }
+            }
+            const std::vector<Real> implied = blackFormulaImpliedStdDev(
+                                type, k2, forwards, p2, disc2, displacement);
+
+            const Real tol = 1e-8;
+            for (Size i=0; i<k2.size(); ++i) {
+                if (std::fabs(implied[i]-sd2[i]) > tol) {
+                    BOOST_FAIL("failed to recover std dev from batched "
+                               "implied volatility:"
+                               << "\n    type:          " << type
+                               << "\n    strike:        " << k2[i]
+                               << "\n    displacement:  " << displacement
+                               << "\n    price:         " << p2[i]
+                               << "\n    implied:       " << implied[i]
+                               << "\n    expected:      " << sd2[i]);
+                }
+            }
+
+            // as in the scalar version, running out of iterations
+            // must not return the last iterate
+            bool failed = false;
+            try {
+                blackFormulaImpliedStdDev(type, k2, forwards, p2, disc2,
+                                          displacement, 1.0e-12, 1);
+            } catch (Error&) {
+                failed = true;
+            }
+            if (!failed)
+                BOOST_FAIL("batched implied volatility returned without "
+                           "converging in a single iteration"
+                           << "\n    type:          " << type
+                           << "\n    displacement:  " << displacement);
+        }
+    }
+}
+
+
 void EuropeanOptionTest::testImpliedVolContainment() {
 
     BOOST_MESSAGE("Testing self-containment of "
@@ -1479,6 +1581,18 @@ void EuropeanOptionTest::testLocalVolatility() {
     volTS->setInterpolation<Bicubic>();
     const boost::shared_ptr<GeneralizedBlackScholesProcess> process =
                                               makeProcess(s0, qTS, rTS,volTS);
+
+    // same local volatility, precomputed on a grid
+    const Handle<LocalVolTermStructure> gridLocalVol(
+        boost::shared_ptr<LocalVolTermStructure>(
+            new InterpolatedLocalVolSurface<Bilinear>(
+                process->localVolatility(), 2.0, 200, 500.0, 20000.0, 400,
+                0.35)));
+    const boost::shared_ptr<GeneralizedBlackScholesProcess> gridProcess(
+        new GeneralizedBlackScholesProcess(
+                        Handle<Quote>(s0), Handle<YieldTermStructure>(qTS),
+                        Handle<YieldTermStructure>(rTS),
+                        Handle<BlackVolTermStructure>(volTS), gridLocalVol));
     
     for (Size i=2; i < dates.size(); ++i) {
         for (Size j=3; j < strikes.size()-5; j+=5) {
@@ -1542,11 +1656,102 @@ void EuropeanOptionTest::testLocalVolatility() {
                            << "\n    calculated: " << calculatedNPV
                            << "\n    expected:   " << expectedNPV);
             }
+
+            // check pricing with the interpolated local vol grid
+            option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                    new FdBlackScholesVanillaEngine(gridProcess, 25, 400, 0,
+                                                    FdmSchemeDesc::Douglas(),
+                                                    true, 0.35)));
+            calculatedNPV = option.NPV();
+            if (std::fabs(expectedNPV - calculatedNPV) > tol*expectedNPV) {
+                BOOST_FAIL("Failed to reproduce option price with "
+                           "interpolated local vol for "
+                           << "\n    strike:     " << payoff->strike()
+                           << "\n    maturity:   " << exDate
+                           << "\n    calculated: " << calculatedNPV
+                           << "\n    expected:   " << expectedNPV);
+            }
         }
     }
 }
 
 
+void EuropeanOptionTest::testRichardsonExtrapolation() {
+
+    BOOST_MESSAGE("Testing Richardson extrapolation of FD results...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today(28, March, 2004);
+    const Date exerciseDate(28, March, 2005);
+    Settings::instance().evaluationDate() = today;
+
+    Handle<Quote> spot(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    Handle<BlackVolTermStructure> volTS(flatVol(today, 0.25, dc));
+
+    boost::shared_ptr<BlackScholesMertonProcess> bsProcess(
+                      new BlackScholesMertonProcess(spot, qTS, rTS, volTS));
+
+    boost::shared_ptr<Exercise> exercise(new EuropeanExercise(exerciseDate));
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                   new PlainVanillaPayoff(Option::Put, 105));
+
+    // the engines refine both the time and the space grid
+    std::vector<boost::shared_ptr<PricingEngine> > engines;
+    for (Size tGrid=25, xGrid=50; tGrid <= 100; tGrid*=2, xGrid*=2) {
+        engines.push_back(boost::shared_ptr<PricingEngine>(
+            new FdBlackScholesVanillaEngine(bsProcess, tGrid, xGrid, 0,
+                                            FdmSchemeDesc::Douglas())));
+    }
+
+    VanillaOption option(payoff, exercise);
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                  new AnalyticEuropeanEngine(bsProcess)));
+    const Real expected = option.NPV();
+    const Real expectedDelta = option.delta();
+
+    option.setPricingEngine(engines.back());
+    const Real finestError = std::fabs(option.NPV() - expected);
+
+    // second-order convergence, with even powers in the error
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new RichardsonExtrapolationEngine<DividendVanillaOption::arguments>(
+                                                 engines, 2.0, 2.0, true)));
+    const Real calculated = option.NPV();
+    const Real calculatedDelta = option.delta();
+
+    if (std::fabs(calculated - expected) > 0.01*finestError
+        || std::fabs(calculatedDelta - expectedDelta) > 1e-5
+        || option.errorEstimate() > finestError) {
+        BOOST_ERROR("Failed to extrapolate European option value"
+                    << "\n    calculated:      " << calculated
+                    << "\n    expected:        " << expected
+                    << "\n    finest grid:     " << expected + finestError
+                    << "\n    error estimate:  " << option.errorEstimate()
+                    << "\n    calculated delta:" << calculatedDelta
+                    << "\n    expected delta:  " << expectedDelta);
+    }
+
+    // parallel evaluation requires separate engines
+    std::vector<boost::shared_ptr<PricingEngine> > sharedEngines(
+                                                        2, engines.front());
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new RichardsonExtrapolationEngine<DividendVanillaOption::arguments>(
+                                           sharedEngines, 2.0, 2.0, true)));
+    bool raised = false;
+    try {
+        option.NPV();
+    } catch (Error&) {
+        raised = true;
+    }
+    if (!raised)
+        BOOST_ERROR("engine shared by parallel evaluations not detected");
+}
+
+
 test_suite* EuropeanOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("European option tests");
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testValues));
@@ -1555,6 +1760,8 @@ test_suite* EuropeanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testImpliedVol));
     suite->add(QUANTLIB_TEST_CASE(
                            &EuropeanOptionTest::testImpliedVolContainment));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &EuropeanOptionTest::testBatchedImpliedVol));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testJRBinomialEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testCRRBinomialEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testEQPBinomialEngines));
@@ -1575,6 +1782,8 @@ test_suite* EuropeanOptionTest::suite() {
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testPriceCurve));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testLocalVolatility));
+    suite->add(QUANTLIB_TEST_CASE(
+                          &EuropeanOptionTest::testRichardsonExtrapolation));
 
     return suite;
 }
@@ -33,6 +33,7 @@ class EuropeanOptionTest {
     static void testGreeks();
     static void testImpliedVol();
     static void testImpliedVolContainment();
+    static void testBatchedImpliedVol();
     static void testJRBinomialEngines();
     static void testCRRBinomialEngines();
     static void testEQPBinomialEngines();
@@ -47,6 +48,7 @@ class EuropeanOptionTest {
     static void testFFTEngines();
     static void testPriceCurve();
     static void testLocalVolatility();
+    static void testRichardsonExtrapolation();
     static boost::unit_test_framework::test_suite* suite();
 };
 
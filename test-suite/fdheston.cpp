@@ -33,6 +33,7 @@
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/barrier/fdhestonbarrierengine.hpp>
 #include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
+#include <ql/pricingengines/vanilla/fdbatesvanillaengine.hpp>
 #include <ql/pricingengines/barrier/fdblackscholesbarrierengine.hpp>
 
 using namespace QuantLib;
@@ -593,6 +594,75 @@ void FdHestonTest::testFdmHestonConvergence() {
     }
  }
 
+void FdHestonTest::testFdmHestonImplicitSolvers() {
+
+    BOOST_MESSAGE("Testing implicit FDM Heston steps with "
+                  "ILU-preconditioned GMRES...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date todaysDate(28, March, 2004);
+    const Date exerciseDate(28, March, 2005);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    Handle<Quote> spot(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> qTS(flatRate(0.02, dc));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, dc));
+
+    boost::shared_ptr<HestonModel> model(new HestonModel(
+        boost::shared_ptr<HestonProcess>(new HestonProcess(
+                            rTS, qTS, spot, 0.04, 1.5, 0.04, 0.3, -0.6))));
+
+    boost::shared_ptr<Exercise> exercise(new EuropeanExercise(exerciseDate));
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                   new PlainVanillaPayoff(Option::Put, 105));
+    VanillaOption option(payoff, exercise);
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                       new AnalyticHestonEngine(model)));
+    const Real expected = option.NPV();
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+         new FdHestonVanillaEngine(model, 50, 100, 30, 0,
+                                   FdmSchemeDesc::ImplicitEuler())));
+    const Real biCGstab = option.NPV();
+
+    const FdmSchemeDesc gmresScheme =
+        FdmSchemeDesc::ImplicitEuler().withSolver(ImplicitEulerScheme::GMRESType);
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+         new FdHestonVanillaEngine(model, 50, 100, 30, 0, gmresScheme)));
+    const Real gmres = option.NPV();
+
+    // both solvers solve the same linear systems, each one up to
+    // its own stopping criterion at every step
+    const Real solverTol = 1e-4;
+    // the implicit-Euler scheme is only first order in time
+    const Real tol = 0.02;
+    if (std::fabs(gmres - biCGstab) > solverTol
+        || std::fabs(gmres - expected) > tol) {
+        BOOST_ERROR("Failed to reproduce implicit FDM Heston price"
+                    << "\n    GMRES:      " << gmres
+                    << "\n    BiCGstab:   " << biCGstab
+                    << "\n    analytic:   " << expected);
+    }
+
+    // the Bates jump integral can't be assembled as a CSR matrix
+    boost::shared_ptr<BatesModel> batesModel(new BatesModel(
+        boost::shared_ptr<BatesProcess>(new BatesProcess(
+                            rTS, qTS, spot, 0.04, 1.5, 0.04, 0.3, -0.6,
+                            1.0, -0.1, 0.15))));
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+         new FdBatesVanillaEngine(batesModel, 50, 100, 30, 0, gmresScheme)));
+    bool failed = false;
+    try {
+        option.NPV();
+    } catch (Error&) {
+        failed = true;
+    }
+    if (!failed)
+        BOOST_ERROR("GMRES solver accepted for the Bates operator");
+}
 
 test_suite* FdHestonTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Finite Difference Heston tests");
@@ -606,5 +676,7 @@ test_suite* FdHestonTest::suite() {
                     &FdHestonTest::testFdmHestonEuropeanWithDividends));
 
     suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testFdmHestonConvergence));
+    suite->add(QUANTLIB_TEST_CASE(
+                         &FdHestonTest::testFdmHestonImplicitSolvers));
     return suite;
 }
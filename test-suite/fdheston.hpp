@@ -34,6 +34,7 @@ public:
     static void testFdmHestonEuropeanWithDividends();
     static void testFdmHestonConvergence();
     static void testFdmHestonBlackScholes();
+    static void testFdmHestonImplicitSolvers();
     static boost::unit_test_framework::test_suite* suite();
 };
 
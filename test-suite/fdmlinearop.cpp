@@ -35,10 +35,16 @@
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/termstructures/yield/zerocurve.hpp>
+#include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/blackcalculator.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 #include <ql/pricingengines/vanilla/mchestonhullwhiteengine.hpp>
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/gmres.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+#include <ql/math/matrixutilities/csrilupreconditioner.hpp>
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
@@ -56,9 +62,15 @@
 #include <ql/methods/finitedifferences/meshers/fdmhestonvariancemesher.hpp>
 #include <ql/methods/finitedifferences/operators/fdmhestonop.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmhestonsolver.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmhestonhullwhitesolver.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmndimsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdm3dimsolver.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmmultipayoffsolver.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmforwardsolver.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmblackscholessolver.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholesfwdop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmhestonfwdop.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmamericanstepcondition.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmdividendhandler.hpp>
@@ -73,6 +85,7 @@
 #endif
 
 #include <boost/bind.hpp>
+#include <set>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -117,6 +130,15 @@ namespace {
         const boost::shared_ptr<FdmMesher> mesher_;
     };
 
+    // records the times at which the solver applies it
+    class FdmTimeRecorder : public StepCondition<Array> {
+      public:
+        void applyTo(Array&, Time t) const { times_.insert(t); }
+        const std::set<Time>& times() const { return times_; }
+      private:
+        mutable std::set<Time> times_;
+    };
+
     class ExpressPayoff : public Payoff {
       public:
         std::string name() const { return "ExpressPayoff";}
@@ -205,6 +227,14 @@ void FdmLinearOpTest::testFdmLinearOpLayout() {
                             << " but should be " << calculatedIndex);
                     }
                 }
+
+                const FdmLinearOpIterator iterAt
+                                            = layout.iter_at(iter.index());
+                if (iterAt.index() != iter.index()
+                    || iterAt.coordinates() != iter.coordinates()) {
+                    BOOST_FAIL("iterator at index " << iter.index()
+                               << " has wrong coordinates");
+                }
             }
         }
     }
@@ -1136,6 +1166,152 @@ void FdmLinearOpTest::testBiCGstab() {
 #endif
 }
 
+void FdmLinearOpTest::testCSRMatrixAssembly() {
+    BOOST_MESSAGE("Testing CSR assembly of the Heston operator...");
+
+    SavedSettings backup;
+
+    Size dims[] = {41, 21};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> index(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>(3.8, 4.905274778));
+    boundaries.push_back(std::pair<Real, Real>(0.0, 1.0));
+
+    boost::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(index, boundaries));
+
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.02, Actual365Fixed()));
+
+    boost::shared_ptr<HestonProcess> hestonProcess(
+        new HestonProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8));
+
+    FdmHestonOp hestonOp(mesher, hestonProcess);
+    hestonOp.setTime(0.5, 0.6);
+
+    Array x(index->size());
+    MersenneTwisterUniformRng rng(1234);
+    for (Size i=0; i < x.size(); ++i) {
+        x[i] = rng.next().value;
+    }
+
+    const Real tol = 1e-12;
+
+    const CSRMatrix csr = hestonOp.toCSRMatrix();
+    const Array expected = hestonOp.apply(x);
+    const Array calculated = csr.apply(x);
+    for (Size i=0; i < x.size(); ++i) {
+        if (std::fabs(expected[i] - calculated[i])
+                > tol*std::max(1.0, std::fabs(expected[i]))) {
+            QL_FAIL("CSR matrix does not reproduce the Heston operator"
+                    << "\n index:      " << i
+                    << "\n expected:   " << expected[i]
+                    << "\n calculated: " << calculated[i]);
+        }
+    }
+
+    for (Size i=0; i < csr.rows(); ++i) {
+        for (Size k=csr.rowPointers()[i]; k < csr.rowPointers()[i+1]; ++k) {
+            const Size j = csr.columnIndices()[k];
+            if (k > csr.rowPointers()[i] && j <= csr.columnIndices()[k-1]) {
+                QL_FAIL("CSR column indices are not strictly increasing "
+                        "in row " << i);
+            }
+            if (csr(i, j) != csr.values()[k]) {
+                QL_FAIL("CSR element access failed at (" << i << ", "
+                        << j << ")");
+            }
+        }
+    }
+}
+
+void FdmLinearOpTest::testGMRES() {
+    BOOST_MESSAGE("Testing GMRES with ILU(0) preconditioned CSR matrix...");
+
+    SavedSettings backup;
+
+    const Size n=41, m=21;
+    const Real theta = 1.0;
+
+    std::vector<Size> rows, columns;
+    std::vector<Real> values;
+
+    for (Size i=0; i < n; ++i) {
+        for (Size j=0; j < m; ++j) {
+            const Size k = i*m+j;
+            rows.push_back(k); columns.push_back(k); values.push_back(1.0);
+
+            if (i > 0 && j > 0 && i <n-1 && j < m-1) {
+                const Size im1 = i-1;
+                const Size ip1 = i+1;
+                const Size jm1 = j-1;
+                const Size jp1 = j+1;
+                const Real delta = theta/((ip1-im1)*(jp1-jm1));
+
+                rows.push_back(k); columns.push_back(im1*m+jm1);
+                values.push_back(delta);
+                rows.push_back(k); columns.push_back(im1*m+jp1);
+                values.push_back(-delta);
+                rows.push_back(k); columns.push_back(ip1*m+jm1);
+                values.push_back(-delta);
+                rows.push_back(k); columns.push_back(ip1*m+jp1);
+                values.push_back(delta);
+            }
+        }
+    }
+
+    const CSRMatrix a(n*m, n*m, rows, columns, values);
+
+    boost::function<Disposable<Array>(const Array&)> matmult(
+                                 boost::bind(&CSRMatrix::apply, &a, _1));
+
+    const CSRILUPreconditioner ilu(a);
+    boost::function<Disposable<Array>(const Array&)> precond(
+                     boost::bind(&CSRILUPreconditioner::apply, &ilu, _1));
+
+    Array b(n*m);
+    MersenneTwisterUniformRng rng(1234);
+    for (Size i=0; i < b.size(); ++i) {
+        b[i] = rng.next().value;
+    }
+
+    const Real tol = 1e-10;
+
+    const GMRES gmres(matmult, n*m, tol, precond);
+    const Array x = gmres.solve(b).x;
+
+    Real error = std::sqrt(DotProduct(b-a.apply(x), b-a.apply(x))
+                           /DotProduct(b,b));
+    if (error > tol) {
+        QL_FAIL("Error calculating the inverse using GMRES" <<
+                "\n tolerance:  " << tol <<
+                "\n error:      " << error);
+    }
+
+    const Array y = GMRES(matmult, n*m, tol).solveWithRestart(10, b).x;
+    error = std::sqrt(DotProduct(b-a.apply(y), b-a.apply(y))
+                      /DotProduct(b,b));
+    if (error > tol) {
+        QL_FAIL("Error calculating the inverse using restarted GMRES" <<
+                "\n tolerance:  " << tol <<
+                "\n error:      " << error);
+    }
+
+    const Array z = BiCGstab(matmult, n*m, tol, precond).solve(b).x;
+    error = std::sqrt(DotProduct(b-a.apply(z), b-a.apply(z))
+                      /DotProduct(b,b));
+    if (error > tol) {
+        QL_FAIL("Error calculating the inverse using BiCGstab "
+                "with ILU(0) preconditioner" <<
+                "\n tolerance:  " << tol <<
+                "\n error:      " << error);
+    }
+}
+
 void FdmLinearOpTest::testCrankNicolsonWithDamping() {
 
     BOOST_MESSAGE("Testing Crank-Nicolson with initial implicit damping steps "
@@ -1230,6 +1406,774 @@ void FdmLinearOpTest::testCrankNicolsonWithDamping() {
 }
 
 
+void FdmLinearOpTest::testAdaptiveTimeStepping() {
+
+    BOOST_MESSAGE("Testing adaptive time stepping "
+                  "for a digital option...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.06, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.06, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.35, dc);
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                             new CashOrNothingPayoff(Option::Put, 100, 10.0));
+
+    Time maturity = 0.75;
+    Date exDate = today + Integer(maturity*360+0.5);
+    boost::shared_ptr<Exercise> exercise(new EuropeanExercise(exDate));
+
+    boost::shared_ptr<BlackScholesMertonProcess> process(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+                                  Handle<YieldTermStructure>(qTS),
+                                  Handle<YieldTermStructure>(rTS),
+                                  Handle<BlackVolTermStructure>(volTS)));
+    boost::shared_ptr<PricingEngine> engine(
+                                new AnalyticEuropeanEngine(process));
+
+    VanillaOption opt(payoff, exercise);
+    opt.setPricingEngine(engine);
+    Real expectedPV = opt.NPV();
+
+    // a few initial steps only; the solver must refine them
+    const Size initialSteps = 2, dampingSteps = 1, xGrid = 400;
+    const std::vector<Size> dim(1, xGrid);
+
+    boost::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+    const boost::shared_ptr<Fdm1dMesher> equityMesher(
+        new FdmBlackScholesMesher(
+                dim[0], process, maturity, payoff->strike(),
+                Null<Real>(), Null<Real>(), 0.0001, 1.5,
+                std::pair<Real, Real>(payoff->strike(), 0.01)));
+
+    boost::shared_ptr<FdmMesher> mesher (
+        new FdmMesherComposite(layout,
+              std::vector<boost::shared_ptr<Fdm1dMesher> >(1, equityMesher)));
+
+    boost::shared_ptr<FdmBlackScholesOp> map(
+                     new FdmBlackScholesOp(mesher, process, payoff->strike()));
+
+    boost::shared_ptr<FdmInnerValueCalculator> calculator(
+                                  new FdmLogInnerValue(payoff, mesher, 0));
+
+    const FdmSchemeDesc schemes[] = {
+        FdmSchemeDesc::Douglas().withTolerance(1e-5),
+        FdmSchemeDesc::Hundsdorfer().withTolerance(1e-5),
+        FdmSchemeDesc::ImplicitEuler().withTolerance(1e-5)
+    };
+
+    // a stopping time off the initial grid, which must be hit exactly
+    const Time stoppingTime = 0.3;
+
+    Array x(layout->size()), payoffValues(layout->size());
+    const FdmLinearOpIterator endIter = layout->end();
+    for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+         ++iter) {
+        payoffValues[iter.index()] =
+            calculator->avgInnerValue(iter, maturity);
+        x[iter.index()] = mesher->location(iter, 0);
+    }
+
+    for (Size i=0; i < LENGTH(schemes); ++i) {
+        // more damping steps than initial ones must not carry the
+        // damping interval beyond the rollback interval
+        const Size damping[] = { dampingSteps, 2*initialSteps };
+
+        for (Size j=0; j < LENGTH(damping); ++j) {
+            const boost::shared_ptr<FdmTimeRecorder> recorder(
+                                                       new FdmTimeRecorder);
+            const boost::shared_ptr<FdmStepConditionComposite> condition(
+                new FdmStepConditionComposite(
+                    std::list<std::vector<Time> >(
+                                     1, std::vector<Time>(1, stoppingTime)),
+                    FdmStepConditionComposite::Conditions(1, recorder)));
+
+            Array rhs(payoffValues);
+            FdmBackwardSolver solver(map, FdmBoundaryConditionSet(),
+                                     condition, schemes[i]);
+            solver.rollback(rhs, maturity, 0.0, initialSteps, damping[j]);
+
+            MonotonicCubicNaturalSpline spline(x.begin(), x.end(),
+                                               rhs.begin());
+            Real calculatedPV = spline(std::log(spot->value()));
+
+            Real relTol = 2e-3;
+            if (std::fabs(calculatedPV - expectedPV) > relTol*expectedPV) {
+                QL_FAIL("Error calculating the PV of the digital option" <<
+                        "\n scheme:          " << i <<
+                        "\n damping steps:   " << damping[j] <<
+                        "\n rel. tolerance:  " << relTol <<
+                        "\n expected:        " << expectedPV <<
+                        "\n calculated:      " << calculatedPV);
+            }
+
+            // the fixed grid stops at the initial steps and at the
+            // stopping time only
+            const std::set<Time>& times = recorder->times();
+            if (times.size() <= initialSteps + damping[j] + 1)
+                BOOST_ERROR("time steps not refined:"
+                            "\n scheme:          " << i <<
+                            "\n damping steps:   " << damping[j] <<
+                            "\n initial steps:   " << initialSteps <<
+                            "\n times visited:   " << times.size());
+            if (times.find(stoppingTime) == times.end())
+                BOOST_ERROR("stopping time " << stoppingTime
+                            << " not hit exactly:"
+                            "\n scheme:          " << i <<
+                            "\n damping steps:   " << damping[j]);
+        }
+    }
+}
+
+
+void FdmLinearOpTest::testTripleBandLineSolve() {
+
+    BOOST_MESSAGE("Testing triple-band map solution on a 3d grid...");
+
+    Size dims[] = {40, 25, 20};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>(-1.0, 1.0));
+    boundaries.push_back(std::pair<Real, Real>( 0.0, 2.0));
+    boundaries.push_back(std::pair<Real, Real>( 0.5, 1.5));
+
+    boost::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, boundaries));
+
+    Array u(layout->size());
+    for (Size i=0; i < layout->size(); ++i)
+        u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+    const Real a = -0.2;
+    for (Size direction=0; direction < dim.size(); ++direction) {
+        TripleBandLinearOp op(SecondDerivativeOp(direction, mesher));
+        op.axpyb(Array(1, 0.3), FirstDerivativeOp(direction, mesher),
+                 op, Array(1, -0.05));
+
+        // the independent lines might be solved by several threads
+        const Array x = op.solve_splitting(u, a, 1.0);
+        const Array y = op.solve_splitting(u, a, 1.0);
+        const Array r = x + a*op.apply(x);
+
+        for (Size i=0; i < u.size(); ++i) {
+            if (std::fabs(r[i] - u[i]) > 1e-10) {
+                QL_FAIL("solve and apply are not consistent "
+                        << "\n direction     : " << direction
+                        << "\n expected      : " << u[i]
+                        << "\n calculated    : " << r[i]);
+            }
+            if (x[i] != y[i]) {
+                QL_FAIL("repeated solutions differ "
+                        << "\n direction     : " << direction
+                        << "\n first         : " << x[i]
+                        << "\n second        : " << y[i]);
+            }
+        }
+    }
+}
+
+
+void FdmLinearOpTest::testMultiPayoffRollback() {
+
+    BOOST_MESSAGE("Testing simultaneous rollback of several payoffs...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual365Fixed();
+    Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+    Date exDate(28, March, 2005);
+    const Time maturity = dc.yearFraction(today, exDate);
+
+    Handle<Quote> spot(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+
+    const Real strikes[] = { 90.0, 100.0, 110.0 };
+    const bool american[] = { true, false, true };
+
+    boost::shared_ptr<BlackScholesMertonProcess> bsProcess(
+        new BlackScholesMertonProcess(spot, qTS, rTS,
+            Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc))));
+    boost::shared_ptr<HestonProcess> hestonProcess(
+        new HestonProcess(rTS, qTS, spot, 0.04, 2.5, 0.04, 0.66, -0.8));
+
+    std::vector<Size> bsDim(1, 200);
+    boost::shared_ptr<FdmMesher> bsMesher(
+        new FdmMesherComposite(
+            boost::shared_ptr<FdmLinearOpLayout>(new FdmLinearOpLayout(bsDim)),
+            std::vector<boost::shared_ptr<Fdm1dMesher> >(1,
+                boost::shared_ptr<Fdm1dMesher>(
+                    new FdmBlackScholesMesher(bsDim[0], bsProcess,
+                                              maturity, 100.0)))));
+
+    Size hestonDims[] = { 100, 50 };
+    std::vector<Size> hestonDim(hestonDims, hestonDims+LENGTH(hestonDims));
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>(3.8, std::log(220.0)));
+    boundaries.push_back(std::pair<Real, Real>(0.0, 1.0));
+    boost::shared_ptr<FdmMesher> hestonMesher(
+        new UniformGridMesher(boost::shared_ptr<FdmLinearOpLayout>(
+                                  new FdmLinearOpLayout(hestonDim)),
+                              boundaries));
+
+    // the last case solves the stacked payoffs with GMRES, which
+    // works on one grid vector at a time
+    const boost::shared_ptr<FdmMesher> meshers[] = {
+        bsMesher, hestonMesher, hestonMesher
+    };
+    const boost::shared_ptr<FdmLinearOpComposite> ops[] = {
+        boost::shared_ptr<FdmLinearOpComposite>(
+                       new FdmBlackScholesOp(bsMesher, bsProcess, 100.0)),
+        boost::shared_ptr<FdmLinearOpComposite>(
+                       new FdmHestonOp(hestonMesher, hestonProcess)),
+        boost::shared_ptr<FdmLinearOpComposite>(
+                       new FdmHestonOp(hestonMesher, hestonProcess))
+    };
+    const FdmSchemeDesc schemes[] = {
+        FdmSchemeDesc::Douglas(), FdmSchemeDesc::Hundsdorfer(),
+        FdmSchemeDesc::ImplicitEuler().withSolver(
+                                        ImplicitEulerScheme::GMRESType)
+    };
+    const Size timeSteps = 50, dampingSteps = 2;
+
+    for (Size m=0; m < LENGTH(meshers); ++m) {
+        const boost::shared_ptr<FdmMesher> mesher = meshers[m];
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+
+        // puts vanish at the upper boundary of the asset
+        const FdmBoundaryConditionSet bcSet(1,
+            boost::shared_ptr<FdmDirichletBoundary>(
+                new FdmDirichletBoundary(mesher, 0.0, 0,
+                                         FdmDirichletBoundary::Upper)));
+
+        std::vector<boost::shared_ptr<FdmInnerValueCalculator> > calculators;
+        std::vector<boost::shared_ptr<FdmStepConditionComposite> > conditions;
+        for (Size i=0; i < LENGTH(strikes); ++i) {
+            boost::shared_ptr<Payoff> payoff(
+                            new PlainVanillaPayoff(Option::Put, strikes[i]));
+            calculators.push_back(boost::shared_ptr<FdmInnerValueCalculator>(
+                                    new FdmLogInnerValue(payoff, mesher, 0)));
+            if (american[i]) {
+                conditions.push_back(
+                    FdmStepConditionComposite::vanillaComposite(
+                        DividendSchedule(),
+                        boost::shared_ptr<Exercise>(
+                                     new AmericanExercise(today, exDate)),
+                        mesher, calculators.back(), today, dc));
+            }
+            else {
+                conditions.push_back(
+                    boost::shared_ptr<FdmStepConditionComposite>());
+            }
+        }
+
+        FdmMultiPayoffSolver solver(mesher, bcSet, calculators, conditions,
+                                    maturity, timeSteps, dampingSteps,
+                                    schemes[m], ops[m]);
+
+        for (Size i=0; i < LENGTH(strikes); ++i) {
+            Array rhs(layout->size());
+            const FdmLinearOpIterator endIter = layout->end();
+            for (FdmLinearOpIterator iter = layout->begin();
+                 iter != endIter; ++iter) {
+                rhs[iter.index()] =
+                    calculators[i]->avgInnerValue(iter, maturity);
+            }
+
+            FdmBackwardSolver(ops[m], bcSet, conditions[i], schemes[m])
+                .rollback(rhs, maturity, 0.0, timeSteps, dampingSteps);
+
+            // the implicit damping steps are solved iteratively,
+            // for the batch as a whole; hence the tolerance.
+            const Array& calculated = solver.values(i);
+            for (Size j=0; j < rhs.size(); ++j) {
+                if (std::fabs(calculated[j] - rhs[j]) > 1e-6) {
+                    QL_FAIL("simultaneous and separate rollbacks differ"
+                            << "\n dimensions    : " << layout->dim().size()
+                            << "\n strike        : " << strikes[i]
+                            << "\n american      : " << american[i]
+                            << "\n grid point    : " << j
+                            << "\n simultaneous  : " << calculated[j]
+                            << "\n separate      : " << rhs[j]);
+                }
+            }
+        }
+
+        // the payoffs are ordered by strike, as must be their values
+        const Real x = std::log(spot->value());
+        for (Size i=1; i < LENGTH(strikes); ++i) {
+            const Real npv1 = (m == 0) ? solver.interpolateAt(i-1, x)
+                                       : solver.interpolateAt(i-1, x, 0.04);
+            const Real npv2 = (m == 0) ? solver.interpolateAt(i, x)
+                                       : solver.interpolateAt(i, x, 0.04);
+            if (npv1 >= npv2 || npv1 <= 0.0) {
+                QL_FAIL("inconsistent values of put options"
+                        << "\n dimensions    : " << layout->dim().size()
+                        << "\n strike " << strikes[i-1] << "    : " << npv1
+                        << "\n strike " << strikes[i] << "    : " << npv2);
+            }
+        }
+    }
+}
+
+
+void FdmLinearOpTest::testForwardSolver() {
+
+    BOOST_MESSAGE("Testing forward solver for European option prices...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual365Fixed();
+    Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    Handle<Quote> spot(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+
+    const Real strikeValues[] = { 70.0, 85.0, 100.0, 115.0, 140.0 };
+    const Integer days[] = { 91, 182, 365 };
+    const std::vector<Real> strikes(strikeValues,
+                                    strikeValues+LENGTH(strikeValues));
+    std::vector<Time> maturities;
+    for (Size i=0; i < LENGTH(days); ++i)
+        maturities.push_back(dc.yearFraction(today, today+days[i]));
+    const Option::Type types[] = { Option::Call, Option::Put };
+
+    // Black-Scholes model, with and without local volatility
+    const Volatility vol = 0.25;
+    boost::shared_ptr<BlackScholesMertonProcess> bsProcess(
+        new BlackScholesMertonProcess(spot, qTS, rTS,
+            Handle<BlackVolTermStructure>(flatVol(today, vol, dc))));
+
+    const std::vector<Size> bsDim(1, 400);
+    const boost::shared_ptr<FdmMesher> bsMesher(
+        new FdmMesherComposite(
+            boost::shared_ptr<FdmLinearOpLayout>(new FdmLinearOpLayout(bsDim)),
+            std::vector<boost::shared_ptr<Fdm1dMesher> >(1,
+                boost::shared_ptr<Fdm1dMesher>(
+                    new FdmBlackScholesMesher(bsDim[0], bsProcess,
+                                              maturities.back(), 100.0,
+                                              Null<Real>(), Null<Real>(),
+                                              0.00001, 1.5)))));
+
+    for (Size l=0; l < 2; ++l) {
+        const bool localVol = (l == 1);
+        FdmForwardSolver solver(
+            bsMesher,
+            boost::shared_ptr<FdmLinearOpComposite>(
+                new FdmBlackScholesFwdOp(bsMesher, bsProcess, 100.0,
+                                         localVol)),
+            std::vector<Real>(1, std::log(spot->value())),
+            maturities, 200, 4);
+
+        for (Size k=0; k < LENGTH(types); ++k) {
+            const Matrix npvs = solver.prices(types[k], strikes);
+            for (Size i=0; i < maturities.size(); ++i) {
+                const Time t = maturities[i];
+                const DiscountFactor df = rTS->discount(t);
+                const Real fwd = spot->value()*qTS->discount(t)/df;
+                for (Size j=0; j < strikes.size(); ++j) {
+                    const Real expected = blackFormula(
+                        types[k], strikes[j], fwd, vol*std::sqrt(t), df);
+                    const Real tol = 2e-2;
+                    if (std::fabs(npvs[i][j] - expected) > tol) {
+                        QL_FAIL("failed to reproduce Black-Scholes prices"
+                                << "\n local vol     : " << localVol
+                                << "\n type          : " << types[k]
+                                << "\n maturity      : " << t
+                                << "\n strike        : " << strikes[j]
+                                << "\n calculated    : " << npvs[i][j]
+                                << "\n expected      : " << expected
+                                << "\n tolerance     : " << tol);
+                    }
+                }
+            }
+        }
+    }
+
+    // Heston model; the Feller condition holds
+    boost::shared_ptr<HestonProcess> hestonProcess(
+        new HestonProcess(rTS, qTS, spot, 0.04, 1.5, 0.04, 0.3, -0.5));
+
+    const boost::shared_ptr<FdmHestonVarianceMesher> varianceMesher(
+        new FdmHestonVarianceMesher(60, hestonProcess, maturities.back()));
+    const boost::shared_ptr<Fdm1dMesher> equityMesher(
+        new FdmBlackScholesMesher(
+            200, FdmBlackScholesMesher::processHelper(
+                     spot, rTS, qTS, varianceMesher->volaEstimate()),
+            maturities.back(), 100.0, Null<Real>(), Null<Real>(),
+            0.00001, 1.5));
+
+    std::vector<boost::shared_ptr<Fdm1dMesher> > meshers;
+    meshers.push_back(equityMesher);
+    meshers.push_back(varianceMesher);
+    std::vector<Size> hestonDim;
+    hestonDim.push_back(equityMesher->size());
+    hestonDim.push_back(varianceMesher->size());
+    const boost::shared_ptr<FdmMesher> hestonMesher(
+        new FdmMesherComposite(boost::shared_ptr<FdmLinearOpLayout>(
+                                   new FdmLinearOpLayout(hestonDim)),
+                               meshers));
+
+    std::vector<Real> initialLocation;
+    initialLocation.push_back(std::log(spot->value()));
+    initialLocation.push_back(hestonProcess->v0());
+
+    FdmForwardSolver solver(
+        hestonMesher,
+        boost::shared_ptr<FdmLinearOpComposite>(
+                          new FdmHestonFwdOp(hestonMesher, hestonProcess)),
+        initialLocation, maturities, 100, 4, FdmSchemeDesc::Hundsdorfer());
+
+    boost::shared_ptr<PricingEngine> engine(new AnalyticHestonEngine(
+          boost::shared_ptr<HestonModel>(new HestonModel(hestonProcess))));
+
+    for (Size k=0; k < LENGTH(types); ++k) {
+        const Matrix npvs = solver.prices(types[k], strikes);
+        for (Size i=0; i < maturities.size(); ++i) {
+            for (Size j=0; j < strikes.size(); ++j) {
+                VanillaOption option(
+                    boost::shared_ptr<StrikedTypePayoff>(
+                        new PlainVanillaPayoff(types[k], strikes[j])),
+                    boost::shared_ptr<Exercise>(
+                        new EuropeanExercise(today+days[i])));
+                option.setPricingEngine(engine);
+                const Real expected = option.NPV();
+                // the density is not smooth at zero variance, which
+                // slows down the convergence in the variance direction
+                const Real tol = 0.15;
+                if (std::fabs(npvs[i][j] - expected) > tol) {
+                    QL_FAIL("failed to reproduce Heston prices"
+                            << "\n type          : " << types[k]
+                            << "\n maturity      : " << maturities[i]
+                            << "\n strike        : " << strikes[j]
+                            << "\n calculated    : " << npvs[i][j]
+                            << "\n expected      : " << expected
+                            << "\n tolerance     : " << tol);
+                }
+            }
+        }
+    }
+}
+
+void FdmLinearOpTest::testLocalInterpolation() {
+
+    BOOST_MESSAGE("Testing local interpolation of FDM results...");
+
+    SavedSettings backup;
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    const Time maturity = 1.0;
+    const Size interpolationPoints = 12;
+
+    boost::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+                                            = createHestonHullWhite(maturity);
+    const boost::shared_ptr<HestonProcess> hestonProcess
+                                            = jointProcess->hestonProcess();
+    const Real v0 = hestonProcess->v0();
+
+    // Heston model, interpolated by Fdm2DimSolver
+    Size dims[] = {51, 21, 15};
+    std::vector<boost::shared_ptr<Fdm1dMesher> > meshers;
+    meshers.push_back(boost::shared_ptr<Fdm1dMesher>(
+            new Uniform1dMesher(std::log(22.0), std::log(440.0), dims[0])));
+    meshers.push_back(boost::shared_ptr<Fdm1dMesher>(
+            new FdmHestonVarianceMesher(dims[1], hestonProcess, maturity)));
+    const boost::shared_ptr<FdmMesher> mesher(
+        new FdmMesherComposite(
+            boost::shared_ptr<FdmLinearOpLayout>(
+                new FdmLinearOpLayout(std::vector<Size>(dims, dims+2))),
+            meshers));
+
+    const boost::shared_ptr<FdmStepConditionComposite> conditions(
+        new FdmStepConditionComposite(
+                                 std::list<std::vector<Time> >(),
+                                 FdmStepConditionComposite::Conditions()));
+    const boost::shared_ptr<FdmInnerValueCalculator> calculator(
+        new FdmLogInnerValue(boost::shared_ptr<Payoff>(
+                                 new PlainVanillaPayoff(Option::Put, 100.0)),
+                             mesher, 0));
+    const FdmBoundaryConditionSet bcSet;
+
+    const FdmSolverDesc globalDesc = { mesher, bcSet, conditions,
+                                       calculator, maturity, 50, 0 };
+    const FdmSolverDesc localDesc = { mesher, bcSet, conditions,
+                                      calculator, maturity, 50, 0,
+                                      interpolationPoints };
+
+    const Handle<HestonProcess> hestonHandle(hestonProcess);
+    const FdmHestonSolver globalSolver(hestonHandle, globalDesc);
+    const FdmHestonSolver localSolver(hestonHandle, localDesc);
+
+    const Real spots[] = { 70.0, 100.0, 100.5, 130.0 };
+    const Real tol = 1e-4;
+    for (Size i=0; i < LENGTH(spots); ++i) {
+        const Real s = spots[i];
+        const Real diffs[] = {
+            localSolver.valueAt(s, v0) - globalSolver.valueAt(s, v0),
+            localSolver.deltaAt(s, v0) - globalSolver.deltaAt(s, v0),
+            localSolver.gammaAt(s, v0) - globalSolver.gammaAt(s, v0),
+            localSolver.thetaAt(s, v0) - globalSolver.thetaAt(s, v0),
+            localSolver.meanVarianceDeltaAt(s, v0)
+                                  - globalSolver.meanVarianceDeltaAt(s, v0)
+        };
+        for (Size j=0; j < LENGTH(diffs); ++j) {
+            if (std::fabs(diffs[j]) > tol) {
+                BOOST_ERROR("failed to reproduce results on the whole grid"
+                            " in the Heston model"
+                            << "\n spot       : " << s
+                            << "\n result     : " << j
+                            << "\n difference : " << diffs[j]
+                            << "\n tolerance  : " << tol);
+            }
+        }
+    }
+
+    // Heston Hull-White model, interpolated by Fdm3DimSolver
+    const FdmSolverDesc desc3d = createSolverDesc(
+                                std::vector<Size>(dims, dims+3), jointProcess);
+    const FdmSolverDesc localDesc3d = { desc3d.mesher, desc3d.bcSet,
+                                        desc3d.condition, desc3d.calculator,
+                                        desc3d.maturity, desc3d.timeSteps,
+                                        desc3d.dampingSteps,
+                                        interpolationPoints };
+
+    const boost::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+                                            = jointProcess->hullWhiteProcess();
+    const Handle<HullWhiteProcess> hwProcess(
+        boost::shared_ptr<HullWhiteProcess>(
+            new HullWhiteProcess(hestonProcess->riskFreeRate(),
+                                 hwFwdProcess->a(), hwFwdProcess->sigma())));
+
+    const FdmHestonHullWhiteSolver globalSolver3d(
+                 hestonHandle, hwProcess, jointProcess->eta(), desc3d);
+    const FdmHestonHullWhiteSolver localSolver3d(
+                 hestonHandle, hwProcess, jointProcess->eta(), localDesc3d);
+
+    const Rate rates[] = { -0.01, 0.0, 0.015 };
+    for (Size i=0; i < LENGTH(spots); ++i) {
+        for (Size k=0; k < LENGTH(rates); ++k) {
+            const Real s = spots[i];
+            const Rate r = rates[k];
+            const Real diffs[] = {
+                localSolver3d.valueAt(s, v0, r)
+                                   - globalSolver3d.valueAt(s, v0, r),
+                localSolver3d.thetaAt(s, v0, r)
+                                   - globalSolver3d.thetaAt(s, v0, r)
+            };
+            for (Size j=0; j < LENGTH(diffs); ++j) {
+                if (std::fabs(diffs[j]) > tol) {
+                    BOOST_ERROR("failed to reproduce results on the whole"
+                                " grid in the Heston Hull-White model"
+                                << "\n spot       : " << s
+                                << "\n rate       : " << r
+                                << "\n result     : " << j
+                                << "\n difference : " << diffs[j]
+                                << "\n tolerance  : " << tol);
+                }
+            }
+        }
+    }
+
+    // a patch of fewer than four points can't carry cubic splines
+    const FdmSolverDesc tooSmallDesc = { mesher, bcSet, conditions,
+                                         calculator, maturity, 50, 0, 3 };
+    bool rejected = false;
+    try {
+        FdmHestonSolver(hestonHandle, tooSmallDesc).valueAt(100.0, v0);
+    } catch (Error&) {
+        rejected = true;
+    }
+    if (!rejected)
+        BOOST_ERROR("patch of 3 interpolation points accepted");
+}
+
+
+void FdmLinearOpTest::testGreekSurfaces() {
+
+    BOOST_MESSAGE("Testing greek surfaces from a single FDM rollback...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual365Fixed();
+    Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    const Rate r = 0.05, q = 0.02;
+    const Volatility vol = 0.25;
+    const Real strike = 100.0;
+    const Time maturity = 1.0;
+
+    Handle<Quote> spot(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    boost::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(spot,
+            Handle<YieldTermStructure>(flatRate(today, q, dc)),
+            Handle<YieldTermStructure>(flatRate(today, r, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, vol, dc))));
+
+    const std::vector<Size> dim(1, 400);
+    const boost::shared_ptr<FdmMesher> mesher(
+        new FdmMesherComposite(
+            boost::shared_ptr<FdmLinearOpLayout>(new FdmLinearOpLayout(dim)),
+            std::vector<boost::shared_ptr<Fdm1dMesher> >(1,
+                boost::shared_ptr<Fdm1dMesher>(
+                    new FdmBlackScholesMesher(dim[0], process, maturity,
+                                              strike, Null<Real>(),
+                                              Null<Real>(), 0.0001, 1.5,
+                                              std::make_pair(strike, 0.1))))));
+
+    const boost::shared_ptr<StrikedTypePayoff> payoff(
+                                new PlainVanillaPayoff(Option::Put, strike));
+    const boost::shared_ptr<FdmInnerValueCalculator> calculator(
+                                new FdmLogInnerValue(payoff, mesher, 0));
+    const boost::shared_ptr<FdmStepConditionComposite> conditions(
+        new FdmStepConditionComposite(
+                                 std::list<std::vector<Time> >(),
+                                 FdmStepConditionComposite::Conditions()));
+    const FdmSolverDesc solverDesc = { mesher, FdmBoundaryConditionSet(),
+                                       conditions, calculator,
+                                       maturity, 200, 2 };
+
+    const Time timeValues[] = { 0.75, 0.0, 0.25, 0.5 };
+    const Real spotValues[] = { 80.0, 90.0, 100.0, 110.0, 120.0 };
+    const std::vector<Time> times(timeValues, timeValues+LENGTH(timeValues));
+    const std::vector<Real> spots(spotValues, spotValues+LENGTH(spotValues));
+
+    const FdmBlackScholesSolver solver(
+        Handle<GeneralizedBlackScholesProcess>(process), strike,
+        solverDesc, FdmSchemeDesc::Douglas(), false, -Null<Real>(), times);
+
+    const Matrix values = solver.valueSurface(spots);
+    const Matrix deltas = solver.deltaSurface(spots);
+    const Matrix gammas = solver.gammaSurface(spots);
+    const Matrix thetas = solver.thetaSurface(spots);
+
+    const std::vector<Time>& sortedTimes = solver.snapshotTimes();
+    if (sortedTimes.size() != times.size() || sortedTimes.front() != 0.0)
+        BOOST_FAIL("snapshot times are not sorted");
+
+    // the surfaces at the valuation time are the usual results
+    for (Size j=0; j < spots.size(); ++j) {
+        const Real s = spots[j];
+        const Real diffs[] = {
+            values[0][j] - solver.valueAt(s),
+            deltas[0][j] - solver.deltaAt(s),
+            gammas[0][j] - solver.gammaAt(s),
+            thetas[0][j] - solver.thetaAt(s)
+        };
+        for (Size k=0; k < LENGTH(diffs); ++k) {
+            if (std::fabs(diffs[k]) > 1e-10) {
+                BOOST_ERROR("greek surfaces differ from solver results"
+                            << "\n spot       : " << s
+                            << "\n result     : " << k
+                            << "\n difference : " << diffs[k]);
+            }
+        }
+    }
+
+    for (Size i=0; i < sortedTimes.size(); ++i) {
+        const Time tau = maturity - sortedTimes[i];
+        const Real tols[] = { 2e-3, 2e-4, 2e-4, 4e-2 };
+        for (Size j=0; j < spots.size(); ++j) {
+            const Real s = spots[j];
+            const BlackCalculator calculator(
+                payoff, s*std::exp((r-q)*tau), vol*std::sqrt(tau),
+                std::exp(-r*tau));
+
+            const Real calculated[] = {
+                values[i][j], deltas[i][j], gammas[i][j], thetas[i][j]
+            };
+            const Real expected[] = {
+                calculator.value(), calculator.delta(s),
+                calculator.gamma(s), calculator.theta(s, tau)
+            };
+            for (Size k=0; k < LENGTH(expected); ++k) {
+                if (std::fabs(calculated[k] - expected[k]) > tols[k]) {
+                    BOOST_ERROR("failed to reproduce Black-Scholes greeks"
+                                << "\n time       : " << sortedTimes[i]
+                                << "\n spot       : " << s
+                                << "\n result     : " << k
+                                << "\n calculated : " << calculated[k]
+                                << "\n expected   : " << expected[k]
+                                << "\n tolerance  : " << tols[k]);
+                }
+            }
+        }
+    }
+}
+
+
+void FdmLinearOpTest::testMixedDerivativeApply() {
+
+    BOOST_MESSAGE("Testing mixed derivatives on a three-dimensional grid...");
+
+    SavedSettings backup;
+
+    Size dims[] = {7, 5, 6};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+    boost::shared_ptr<FdmLinearOpLayout> index(new FdmLinearOpLayout(dim));
+
+    std::vector<boost::shared_ptr<Fdm1dMesher> > meshers;
+    meshers.push_back(boost::shared_ptr<Fdm1dMesher>(
+                                    new Uniform1dMesher(-1.0, 2.0, dim[0])));
+    meshers.push_back(boost::shared_ptr<Fdm1dMesher>(
+                                    new Uniform1dMesher(0.0, 0.5, dim[1])));
+    meshers.push_back(boost::shared_ptr<Fdm1dMesher>(
+                                    new Uniform1dMesher(1.0, 4.0, dim[2])));
+    boost::shared_ptr<FdmMesher> mesher(
+                                    new FdmMesherComposite(index, meshers));
+
+    // two vectors stacked one after the other
+    const Size n = index->size();
+    Array x(2*n), weights(n);
+    MersenneTwisterUniformRng rng(1234);
+    for (Size i=0; i < x.size(); ++i)
+        x[i] = rng.next().value;
+    for (Size i=0; i < n; ++i)
+        weights[i] = rng.next().value;
+
+    const Size directions[][2] = { {0, 1}, {1, 0}, {0, 2}, {2, 1} };
+    const Real tol = 1e-12;
+
+    for (Size d=0; d < LENGTH(directions); ++d) {
+        const NinePointLinearOp op =
+            SecondOrderMixedDerivativeOp(directions[d][0], directions[d][1],
+                                         mesher).mult(weights);
+        const CSRMatrix csr = op.toCSRMatrix();
+        const Array calculated = op.apply(x);
+
+        for (Size k=0; k < 2; ++k) {
+            const Array expected =
+                csr.apply(Array(x.begin()+k*n, x.begin()+(k+1)*n));
+            for (Size i=0; i < n; ++i) {
+                if (std::fabs(calculated[k*n+i] - expected[i])
+                        > tol*std::max(1.0, std::fabs(expected[i]))) {
+                    QL_FAIL("failed to apply mixed derivative operator"
+                            << "\n directions: " << directions[d][0]
+                            << ", " << directions[d][1]
+                            << "\n vector:     " << k
+                            << "\n index:      " << i
+                            << "\n expected:   " << expected[i]
+                            << "\n calculated: " << calculated[k*n+i]);
+                }
+            }
+        }
+    }
+}
+
+
 test_suite* FdmLinearOpTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("linear operator tests");
 
@@ -1245,13 +2189,25 @@ test_suite* FdmLinearOpTest::suite() {
             &FdmLinearOpTest::testSecondOrderMixedDerivativesMapApply));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testTripleBandMapSolve));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testTripleBandLineSolve));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonBarrier));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonAmerican));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonExpress));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonHullWhiteOp));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testBiCGstab));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCSRMatrixAssembly));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testGMRES));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCrankNicolsonWithDamping));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testAdaptiveTimeStepping));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testMultiPayoffRollback));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testForwardSolver));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testLocalInterpolation));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testGreekSurfaces));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testMixedDerivativeApply));
 
     return suite;
     
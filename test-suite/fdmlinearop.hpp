@@ -35,12 +35,21 @@ public:
     static void testSecondDerivativesMapApply();
     static void testSecondOrderMixedDerivativesMapApply();
     static void testTripleBandMapSolve();
+    static void testTripleBandLineSolve();
     static void testFdmHestonBarrier();
     static void testFdmHestonAmerican();
     static void testFdmHestonExpress();
     static void testFdmHestonHullWhiteOp();
     static void testBiCGstab();
+    static void testCSRMatrixAssembly();
+    static void testGMRES();
     static void testCrankNicolsonWithDamping();
+    static void testAdaptiveTimeStepping();
+    static void testMultiPayoffRollback();
+    static void testForwardSolver();
+    static void testLocalInterpolation();
+    static void testGreekSurfaces();
+    static void testMixedDerivativeApply();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -36,6 +36,7 @@
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanhestonengine.hpp>
+#include <ql/experimental/variancegamma/ffthestonengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
@@ -994,6 +995,148 @@ void HestonModelTest::testMultipleStrikesEngine() {
 
 
 
+void HestonModelTest::testAnalyticMultipleStrikes() {
+    BOOST_MESSAGE("Testing multi-strike analytic Heston pricing...");
+
+    SavedSettings backup;
+
+    Date settlementDate(27, December, 2004);
+    Settings::instance().evaluationDate() = settlementDate;
+    DayCounter dayCounter = ActualActual();
+    Date exerciseDate(28, March, 2006);
+
+    Handle<YieldTermStructure> riskFreeTS(flatRate(0.05, dayCounter));
+    Handle<YieldTermStructure> dividendTS(flatRate(0.02, dayCounter));
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    boost::shared_ptr<HestonModel> model(new HestonModel(
+        boost::shared_ptr<HestonProcess>(
+            new HestonProcess(riskFreeTS, dividendTS, s0,
+                              0.04, 1.5, 0.09, 0.6, -0.7))));
+    boost::shared_ptr<Exercise> exercise(new EuropeanExercise(exerciseDate));
+
+    std::vector<boost::shared_ptr<PlainVanillaPayoff> > payoffs;
+    for (Real strike = 60.0; strike <= 150.0; strike += 5.0) {
+        payoffs.push_back(boost::shared_ptr<PlainVanillaPayoff>(
+                              new PlainVanillaPayoff(Option::Call, strike)));
+        payoffs.push_back(boost::shared_ptr<PlainVanillaPayoff>(
+                              new PlainVanillaPayoff(Option::Put, strike)));
+    }
+
+    AnalyticHestonEngine::Integration integrations[] = {
+        AnalyticHestonEngine::Integration::gaussLaguerre(128),
+        AnalyticHestonEngine::Integration::gaussLegendre(256),
+        AnalyticHestonEngine::Integration::gaussChebyshev(256)
+    };
+
+    const Real tolerance = 1e-10;
+    for (Size i=0; i<LENGTH(integrations); ++i) {
+        boost::shared_ptr<AnalyticHestonEngine> engine(
+            new AnalyticHestonEngine(model, AnalyticHestonEngine::Gatheral,
+                                     integrations[i]));
+        std::vector<Real> calculated =
+            engine->calculate(exerciseDate, payoffs);
+
+        for (Size j=0; j<payoffs.size(); ++j) {
+            VanillaOption option(payoffs[j], exercise);
+            option.setPricingEngine(engine);
+            Real expected = option.NPV();
+
+            if (std::fabs(calculated[j] - expected) > tolerance) {
+                BOOST_ERROR("failed to reproduce single-strike price"
+                            << "\n    integration: " << i
+                            << "\n    type:        "
+                            << payoffs[j]->optionType()
+                            << "\n    strike:      " << payoffs[j]->strike()
+                            << QL_FIXED << std::setprecision(12)
+                            << "\n    calculated:  " << calculated[j]
+                            << "\n    expected:    " << expected);
+            }
+        }
+    }
+}
+
+void HestonModelTest::testFourierEngines() {
+    BOOST_MESSAGE("Testing FFT and COS Heston engines...");
+
+    SavedSettings backup;
+
+    Date settlementDate(27, December, 2004);
+    Settings::instance().evaluationDate() = settlementDate;
+    DayCounter dayCounter = ActualActual();
+
+    Handle<YieldTermStructure> riskFreeTS(flatRate(0.05, dayCounter));
+    Handle<YieldTermStructure> dividendTS(flatRate(0.02, dayCounter));
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    boost::shared_ptr<HestonModel> model(new HestonModel(
+        boost::shared_ptr<HestonProcess>(
+            new HestonProcess(riskFreeTS, dividendTS, s0,
+                              0.04, 1.5, 0.09, 0.6, -0.7))));
+
+    boost::shared_ptr<PricingEngine> analyticEngine(
+                                          new AnalyticHestonEngine(model));
+    boost::shared_ptr<FFTEngine> engines[] = {
+        boost::shared_ptr<FFTEngine>(new FFTHestonEngine(model)),
+        boost::shared_ptr<FFTEngine>(new COSHestonEngine(model))
+    };
+    std::string names[] = { "FFT", "COS" };
+    Real tolerances[] = { 1e-4, 1e-6 };
+
+    Date exerciseDates[] = { Date(28, March, 2005),
+                             Date(28, March, 2006),
+                             Date(27, December, 2009) };
+
+    std::vector<boost::shared_ptr<Instrument> > options;
+    std::vector<Real> expected;
+    for (Size i=0; i<LENGTH(exerciseDates); ++i) {
+        boost::shared_ptr<Exercise> exercise(
+                                     new EuropeanExercise(exerciseDates[i]));
+        for (Real strike = 60.0; strike <= 150.0; strike += 5.0) {
+            for (Size k=0; k<2; ++k) {
+                Option::Type type = (k == 0) ? Option::Call : Option::Put;
+                boost::shared_ptr<VanillaOption> option(new VanillaOption(
+                    boost::shared_ptr<StrikedTypePayoff>(
+                                     new PlainVanillaPayoff(type, strike)),
+                    exercise));
+                option->setPricingEngine(analyticEngine);
+                expected.push_back(option->NPV());
+                options.push_back(option);
+            }
+        }
+    }
+
+    for (Size i=0; i<LENGTH(engines); ++i) {
+        engines[i]->precalculate(options);
+
+        for (Size j=0; j<options.size(); ++j) {
+            boost::shared_ptr<VanillaOption> option =
+                boost::dynamic_pointer_cast<VanillaOption>(options[j]);
+            option->setPricingEngine(engines[i]);
+            Real calculated = option->NPV();
+
+            if (std::fabs(calculated - expected[j]) > tolerances[i]) {
+                boost::shared_ptr<StrikedTypePayoff> payoff =
+                    boost::dynamic_pointer_cast<StrikedTypePayoff>(
+                                                         option->payoff());
+                BOOST_ERROR("failed to reproduce analytic Heston price"
+                            << "\n    engine:     " << names[i]
+                            << "\n    expiry:     "
+                            << option->exercise()->lastDate()
+                            << "\n    type:       " << payoff->optionType()
+                            << "\n    strike:     " << payoff->strike()
+                            << QL_FIXED << std::setprecision(8)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected[j]
+                            << QL_SCIENTIFIC
+                            << "\n    error:      "
+                            << std::fabs(calculated - expected[j])
+                            << "\n    tolerance:  " << tolerances[i]);
+            }
+        }
+    }
+}
+
 void HestonModelTest::testAnalyticPiecewiseTimeDependent() {
     BOOST_MESSAGE("Testing analytic piecewise time dependent Heston prices...");
 
@@ -1130,6 +1273,9 @@ test_suite* HestonModelTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticVsCached));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testKahlJaeckelCase));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testDifferentIntegrals));
+    suite->add(QUANTLIB_TEST_CASE(
+                            &HestonModelTest::testAnalyticMultipleStrikes));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testFourierEngines));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testFdBarrierVsCached));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testFdVanillaVsCached));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testMultipleStrikesEngine));
@@ -36,6 +36,8 @@ class HestonModelTest {
     static void testFdBarrierVsCached();    
     static void testFdVanillaVsCached();    
     static void testDifferentIntegrals();
+    static void testAnalyticMultipleStrikes();
+    static void testFourierEngines();
     static void testMultipleStrikesEngine();
     static void testAnalyticPiecewiseTimeDependent();
     static void testDAXCalibrationOfTimeDependentModel();
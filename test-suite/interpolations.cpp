@@ -1246,6 +1246,8 @@ void InterpolationTest::testSabrInterpolation(){
     std::vector<boost::shared_ptr<OptimizationMethod> > methods_;
     methods_.push_back( boost::shared_ptr<OptimizationMethod>(new Simplex(0.01)));
     methods_.push_back( boost::shared_ptr<OptimizationMethod>(new LevenbergMarquardt(1e-8, 1e-8, 1e-8)));
+    // same, using the analytic jacobian of the SABR expansion
+    methods_.push_back( boost::shared_ptr<OptimizationMethod>(new LevenbergMarquardt(1e-8, 1e-8, 1e-8, true)));
     // Initialize end criteria
     boost::shared_ptr<EndCriteria> endCriteria(new
                   EndCriteria(100000, 100, 1e-8, 1e-8, 1e-8));
@@ -1326,6 +1328,69 @@ void InterpolationTest::testSabrInterpolation(){
     }
 }
 
+void InterpolationTest::testSabrJacobian() {
+
+    BOOST_MESSAGE("Testing Sabr batched volatilities and jacobian...");
+
+    std::vector<Real> strikes;
+    for (Size i=0; i<31; ++i)
+        strikes.push_back(0.01 + 0.003*i);
+    // include the forward itself to exercise the atm expansions
+    Real forward = 0.045;
+    strikes.push_back(forward);
+    Time expiry = 3.0;
+    Real params[] = { 0.04, 0.6, 0.45, -0.35 };
+
+    std::vector<Real> volatilities =
+        sabrVolatilities(strikes, forward, expiry,
+                         params[0], params[1], params[2], params[3]);
+    for (Size i=0; i<strikes.size(); ++i) {
+        Real expected = sabrVolatility(strikes[i], forward, expiry,
+                                       params[0], params[1],
+                                       params[2], params[3]);
+        if (volatilities[i] != expected)
+            BOOST_ERROR("batched Sabr volatility differs from scalar one"
+                        << "\n    strike:     " << strikes[i]
+                        << "\n    expected:   " << expected
+                        << "\n    calculated: " << volatilities[i]);
+    }
+
+    std::vector<Real> jacobianVols;
+    Matrix jacobian = sabrVolatilityJacobian(strikes, forward, expiry,
+                                             params[0], params[1],
+                                             params[2], params[3],
+                                             &jacobianVols);
+    const char* names[] = { "alpha", "beta", "nu", "rho" };
+    Real h = 1.0e-6, tolerance = 1.0e-8;
+    for (Size j=0; j<4; ++j) {
+        Real up[4], down[4];
+        std::copy(params, params+4, up);
+        std::copy(params, params+4, down);
+        up[j] += h;
+        down[j] -= h;
+        for (Size i=0; i<strikes.size(); ++i) {
+            Real fd = (sabrVolatility(strikes[i], forward, expiry,
+                                      up[0], up[1], up[2], up[3])
+                       - sabrVolatility(strikes[i], forward, expiry,
+                                        down[0], down[1], down[2], down[3]))
+                / (2.0*h);
+            if (std::fabs(jacobian[i][j]-fd) > tolerance*(1.0+std::fabs(fd)))
+                BOOST_ERROR("failed to calculate Sabr derivative w.r.t. "
+                            << names[j]
+                            << "\n    strike:        " << strikes[i]
+                            << "\n    finite diff.:  " << fd
+                            << "\n    analytic:      " << jacobian[i][j]);
+        }
+    }
+    for (Size i=0; i<strikes.size(); ++i) {
+        if (std::fabs(jacobianVols[i]-volatilities[i]) > 1.0e-15)
+            BOOST_ERROR("volatility returned with the jacobian differs"
+                        << "\n    strike:     " << strikes[i]
+                        << "\n    expected:   " << volatilities[i]
+                        << "\n    calculated: " << jacobianVols[i]);
+    }
+}
+
 
 void InterpolationTest::testKernelInterpolation() {
 
@@ -1632,6 +1697,7 @@ test_suite* InterpolationTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testBackwardFlat));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testForwardFlat));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testSabrInterpolation));
+    suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testSabrJacobian));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testKernelInterpolation));
     suite->add(QUANTLIB_TEST_CASE(
                               &InterpolationTest::testKernelInterpolation2D));
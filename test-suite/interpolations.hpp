@@ -43,6 +43,7 @@ class InterpolationTest {
     static void testBackwardFlat();
     static void testForwardFlat();
     static void testSabrInterpolation();
+    static void testSabrJacobian();
     static void testKernelInterpolation();
     static void testKernelInterpolation2D();
     static void testBicubicDerivatives();
@@ -22,6 +22,7 @@
 #include "matrices.hpp"
 #include "utilities.hpp"
 #include <ql/math/matrix.hpp>
+#include <ql/math/matrixutilities/choleskydecomposition.hpp>
 #include <ql/math/matrixutilities/pseudosqrt.hpp>
 #include <ql/math/matrixutilities/svd.hpp>
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
@@ -470,6 +471,144 @@ void MatricesTest::testOrthogonalProjection() {
 
 
 
+void MatricesTest::testProduct() {
+
+    BOOST_MESSAGE("Testing matrix product against plain inner products...");
+
+    // sizes spanning several tiles of the blocked product, with
+    // incomplete tiles at the edges
+    const Size rows = 37, inner = 70, columns = 45;
+    MersenneTwisterUniformRng rng(1234);
+    Matrix A(rows, inner), B(inner, columns);
+    for (Size i=0; i<rows; i++)
+        for (Size k=0; k<inner; k++)
+            A[i][k] = rng.next().value - 0.5;
+    for (Size k=0; k<inner; k++)
+        for (Size j=0; j<columns; j++)
+            B[k][j] = rng.next().value - 0.5;
+
+    const Matrix C = A*B;
+    if (C.rows() != rows || C.columns() != columns)
+        BOOST_FAIL("wrong product size: " << C.rows() << "x" << C.columns()
+                   << " instead of " << rows << "x" << columns);
+
+    const Real tol = 1.0e-14;
+    for (Size i=0; i<rows; i++) {
+        for (Size j=0; j<columns; j++) {
+            Real expected = 0.0;
+            for (Size k=0; k<inner; k++)
+                expected += A[i][k]*B[k][j];
+            if (std::fabs(C[i][j]-expected) > tol)
+                BOOST_FAIL("product element (" << i << "," << j << ")"
+                           << "\n    calculated: " << C[i][j]
+                           << "\n    expected:   " << expected);
+        }
+    }
+}
+
+namespace {
+
+    /* The n x n matrix T with 2 on the diagonal and -1 on the
+       off-diagonals has eigenvalues 2-2cos(k pi/(n+1)) and
+       eigenvectors sqrt(2/(n+1)) sin(jk pi/(n+1)), k = 1...n.
+       The returned columns are sorted by decreasing eigenvalue. */
+    Matrix tridiagonalEigenvectors(Size n, Array& eigenvalues) {
+        Matrix v(n, n);
+        eigenvalues = Array(n);
+        for (Size c=0; c<n; c++) {
+            const Size k = n-c;
+            eigenvalues[c] = 2.0 - 2.0*std::cos(k*M_PI/(n+1));
+            for (Size j=0; j<n; j++)
+                v[j][c] = std::sqrt(2.0/(n+1))*std::sin((j+1)*k*M_PI/(n+1));
+        }
+        return v;
+    }
+
+}
+
+void MatricesTest::testDecompositionReferences() {
+
+    BOOST_MESSAGE("Testing matrix decompositions against analytic values...");
+
+    setup();
+
+    const Real tol = 1.0e-14;
+
+    // Cholesky: T = L L^T with L[j][j] = sqrt((j+2)/(j+1))
+    // and L[j+1][j] = -sqrt((j+1)/(j+2))
+    Matrix L = CholeskyDecomposition(M5);
+    for (Size i=0; i<L.rows(); i++) {
+        for (Size j=0; j<L.columns(); j++) {
+            Real expected = 0.0;
+            if (i == j)
+                expected = std::sqrt((j+2.0)/(j+1.0));
+            else if (i == j+1)
+                expected = -std::sqrt((j+1.0)/(j+2.0));
+            if (std::fabs(L[i][j]-expected) > tol)
+                BOOST_FAIL("Cholesky factor element (" << i << "," << j
+                           << ")\n    calculated: " << L[i][j]
+                           << "\n    expected:   " << expected);
+        }
+    }
+
+    // Schur: eigenvectors are normalized with a positive first
+    // component, which the reference ones have
+    Array lambda;
+    Matrix expectedVectors = tridiagonalEigenvectors(M5.rows(), lambda);
+    SymmetricSchurDecomposition schur(M5);
+    for (Size c=0; c<lambda.size(); c++) {
+        if (std::fabs(schur.eigenvalues()[c]-lambda[c]) > tol)
+            BOOST_FAIL("eigenvalue #" << c
+                       << "\n    calculated: " << schur.eigenvalues()[c]
+                       << "\n    expected:   " << lambda[c]);
+        for (Size j=0; j<lambda.size(); j++)
+            if (std::fabs(schur.eigenvectors()[j][c]
+                          - expectedVectors[j][c]) > tol)
+                BOOST_FAIL("eigenvector #" << c << ", element " << j
+                           << "\n    calculated: "
+                           << schur.eigenvectors()[j][c]
+                           << "\n    expected:   "
+                           << expectedVectors[j][c]);
+    }
+
+    /* SVD of A = P S Q^T, with P made of the first three columns
+       of the 4x4 eigenvector matrix above and Q the 3x3 one.
+       Singular vectors are only defined up to a common sign of
+       each (u, v) pair, which is not fixed by the decomposition. */
+    Array dummy;
+    const Matrix P = tridiagonalEigenvectors(4, dummy);
+    const Matrix Q = tridiagonalEigenvectors(3, dummy);
+    const Real sigma[] = { 3.0, 2.0, 0.5 };
+    Matrix S(3, 3, 0.0);
+    for (Size i=0; i<3; i++)
+        S[i][i] = sigma[i];
+    Matrix P3(4, 3);
+    for (Size i=0; i<4; i++)
+        for (Size j=0; j<3; j++)
+            P3[i][j] = P[i][j];
+    SVD svd(P3*S*transpose(Q));
+
+    for (Size c=0; c<3; c++) {
+        if (std::fabs(svd.singularValues()[c]-sigma[c]) > tol)
+            BOOST_FAIL("singular value #" << c
+                       << "\n    calculated: " << svd.singularValues()[c]
+                       << "\n    expected:   " << sigma[c]);
+        const Real sign = svd.V()[0][c]*Q[0][c] > 0.0 ? 1.0 : -1.0;
+        for (Size j=0; j<3; j++)
+            if (std::fabs(sign*svd.V()[j][c] - Q[j][c]) > tol)
+                BOOST_FAIL("right singular vector #" << c
+                           << ", element " << j
+                           << "\n    calculated: " << sign*svd.V()[j][c]
+                           << "\n    expected:   " << Q[j][c]);
+        for (Size i=0; i<4; i++)
+            if (std::fabs(sign*svd.U()[i][c] - P3[i][c]) > tol)
+                BOOST_FAIL("left singular vector #" << c
+                           << ", element " << i
+                           << "\n    calculated: " << sign*svd.U()[i][c]
+                           << "\n    expected:   " << P3[i][c]);
+    }
+}
+
 test_suite* MatricesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Matrix tests");
 
@@ -477,6 +616,8 @@ test_suite* MatricesTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testEigenvectors));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testSqrt));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testSVD));
+    suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testProduct));
+    suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testDecompositionReferences));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testHighamSqrt));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testQRDecomposition));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testQRSolve));
@@ -37,6 +37,8 @@ class MatricesTest {
     static void testInverse();
     static void testDeterminant();
     static void testOrthogonalProjection();
+    static void testProduct();
+    static void testDecompositionReferences();
     static boost::unit_test_framework::test_suite* suite();
 };
 
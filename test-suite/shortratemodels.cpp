@@ -25,6 +25,7 @@
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
 #include <ql/models/shortrate/calibrationhelpers/swaptionhelper.hpp>
 #include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
+#include <ql/pricingengines/swaption/treeswaptionengine.hpp>
 #include <ql/pricingengines/swap/treeswapengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
@@ -37,6 +38,7 @@
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/time/schedule.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <ql/discretizedasset.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -49,6 +51,20 @@ namespace {
         Volatility volatility;
     };
 
+    // asset with node-dependent values, used to check multi-asset rollback
+    class DiscretizedRamp : public DiscretizedAsset {
+      public:
+        explicit DiscretizedRamp(Real slope) : slope_(slope) {}
+        void reset(Size size) {
+            values_ = Array(size, 1.0, slope_);
+        }
+        std::vector<Time> mandatoryTimes() const {
+            return std::vector<Time>();
+        }
+      private:
+        Real slope_;
+    };
+
 }
 
 
@@ -128,6 +144,168 @@ void ShortRateModelTest::testCachedHullWhite() {
 }
 
 
+void ShortRateModelTest::testParallelCalibration() {
+    BOOST_MESSAGE("Testing parallel evaluation of calibration helpers...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+    CalibrationData data[] = {{ 1, 5, 0.1148 },
+                              { 2, 4, 0.1108 },
+                              { 3, 3, 0.1070 },
+                              { 4, 2, 0.1021 },
+                              { 5, 1, 0.1000 }};
+    boost::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+
+    boost::shared_ptr<HullWhite> serialModel(new HullWhite(termStructure));
+    boost::shared_ptr<HullWhite> parallelModel(new HullWhite(termStructure));
+    boost::shared_ptr<PricingEngine> sharedEngine(
+                                  new JamshidianSwaptionEngine(serialModel));
+
+    std::vector<boost::shared_ptr<CalibrationHelper> > serialHelpers,
+                                                       parallelHelpers;
+    for (Size i=0; i<LENGTH(data); i++) {
+        boost::shared_ptr<Quote> vol(new SimpleQuote(data[i].volatility));
+        for (Size k=0; k<2; k++) {
+            boost::shared_ptr<CalibrationHelper> helper(
+                             new SwaptionHelper(Period(data[i].start, Years),
+                                                Period(data[i].length, Years),
+                                                Handle<Quote>(vol),
+                                                index,
+                                                Period(1, Years), Thirty360(),
+                                                Actual360(), termStructure));
+            if (k == 0) {
+                helper->setPricingEngine(sharedEngine);
+                serialHelpers.push_back(helper);
+            } else {
+                // one engine per helper, as required in parallel mode
+                helper->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                              new JamshidianSwaptionEngine(parallelModel)));
+                parallelHelpers.push_back(helper);
+            }
+        }
+    }
+
+    LevenbergMarquardt serialMethod(1.0e-8,1.0e-8,1.0e-8);
+    LevenbergMarquardt parallelMethod(1.0e-8,1.0e-8,1.0e-8);
+    EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+
+    serialModel->calibrate(serialHelpers, serialMethod, endCriteria);
+    parallelModel->calibrate(parallelHelpers, parallelMethod, endCriteria,
+                             Constraint(), std::vector<Real>(), true);
+
+    Array serial = serialModel->params();
+    Array parallel = parallelModel->params();
+    Real tolerance = 1.0e-12;
+    for (Size i=0; i<serial.size(); i++) {
+        if (std::fabs(serial[i]-parallel[i]) > tolerance)
+            BOOST_ERROR("failed to reproduce serial calibration:"
+                        << "\n    parameter: " << i
+                        << QL_SCIENTIFIC
+                        << "\n    serial:    " << serial[i]
+                        << "\n    parallel:  " << parallel[i]);
+    }
+
+    // helpers sharing an engine must be rejected in parallel mode
+    bool thrown = false;
+    try {
+        serialModel->calibrate(serialHelpers, serialMethod, endCriteria,
+                               Constraint(), std::vector<Real>(), true);
+    } catch (Error&) {
+        thrown = true;
+    }
+    if (!thrown)
+        BOOST_ERROR("shared pricing engine not detected in parallel mode");
+}
+
+void ShortRateModelTest::testParallelTreeCalibration() {
+    BOOST_MESSAGE("Testing parallel calibration on a shared tree...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+    CalibrationData data[] = {{ 1, 5, 0.1148 },
+                              { 2, 4, 0.1108 },
+                              { 3, 3, 0.1070 },
+                              { 4, 2, 0.1021 },
+                              { 5, 1, 0.1000 }};
+    boost::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+
+    std::vector<boost::shared_ptr<CalibrationHelper> > serialHelpers,
+                                                       parallelHelpers;
+    std::list<Time> times;
+    for (Size i=0; i<LENGTH(data); i++) {
+        boost::shared_ptr<Quote> vol(new SimpleQuote(data[i].volatility));
+        for (Size k=0; k<2; k++) {
+            boost::shared_ptr<CalibrationHelper> helper(
+                             new SwaptionHelper(Period(data[i].start, Years),
+                                                Period(data[i].length, Years),
+                                                Handle<Quote>(vol),
+                                                index,
+                                                Period(1, Years), Thirty360(),
+                                                Actual360(), termStructure));
+            helper->addTimesTo(times);
+            if (k == 0)
+                serialHelpers.push_back(helper);
+            else
+                parallelHelpers.push_back(helper);
+        }
+    }
+
+    // all the engines use the same grid, so that the helpers of each
+    // model are priced on the same cached tree
+    TimeGrid grid(times.begin(), times.end(), 30);
+    boost::shared_ptr<HullWhite> serialModel(new HullWhite(termStructure));
+    boost::shared_ptr<HullWhite> parallelModel(new HullWhite(termStructure));
+    for (Size i=0; i<LENGTH(data); i++) {
+        serialHelpers[i]->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                   new TreeSwaptionEngine(serialModel, grid)));
+        parallelHelpers[i]->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                 new TreeSwaptionEngine(parallelModel, grid)));
+    }
+
+    LevenbergMarquardt serialMethod(1.0e-8,1.0e-8,1.0e-8);
+    LevenbergMarquardt parallelMethod(1.0e-8,1.0e-8,1.0e-8);
+    EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+
+    serialModel->calibrate(serialHelpers, serialMethod, endCriteria);
+    parallelModel->calibrate(parallelHelpers, parallelMethod, endCriteria,
+                             Constraint(), std::vector<Real>(), true);
+
+    Array serial = serialModel->params();
+    Array parallel = parallelModel->params();
+    Real tolerance = 1.0e-12;
+    for (Size i=0; i<serial.size(); i++) {
+        if (std::fabs(serial[i]-parallel[i]) > tolerance)
+            BOOST_ERROR("failed to reproduce serial calibration:"
+                        << "\n    parameter: " << i
+                        << QL_SCIENTIFIC
+                        << "\n    serial:    " << serial[i]
+                        << "\n    parallel:  " << parallel[i]);
+    }
+
+    for (Size i=0; i<LENGTH(data); i++) {
+        Real serialValue = serialHelpers[i]->modelValue();
+        Real parallelValue = parallelHelpers[i]->modelValue();
+        if (std::fabs(serialValue-parallelValue) > tolerance)
+            BOOST_ERROR("failed to reproduce serial model value:"
+                        << "\n    helper:    " << i
+                        << QL_SCIENTIFIC
+                        << "\n    serial:    " << serialValue
+                        << "\n    parallel:  " << parallelValue);
+    }
+}
+
 void ShortRateModelTest::testSwaps() {
     BOOST_MESSAGE("Testing Hull-White swap pricing against known values...");
 
@@ -268,12 +446,124 @@ void ShortRateModelTest::testFuturesConvexityBias() {
     }
 }
 
+void ShortRateModelTest::testMultiAssetRollback() {
+    BOOST_MESSAGE("Testing multi-asset rollback on Hull-White tree...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+    Handle<YieldTermStructure> termStructure(flatRate(today, 0.04,
+                                                      Actual360()));
+    boost::shared_ptr<HullWhite> model(new HullWhite(termStructure,
+                                                     0.1, 0.01));
+
+    Time maturity = 10.0;
+    boost::shared_ptr<Lattice> lattice = model->tree(TimeGrid(maturity, 120));
+    boost::shared_ptr<OneFactorModel::ShortRateTree> tree =
+        boost::dynamic_pointer_cast<OneFactorModel::ShortRateTree>(lattice);
+    QL_REQUIRE(tree, "short-rate tree expected");
+
+    Real slopes[] = { 0.0, 0.01, -0.005, 0.1 };
+    Size n = LENGTH(slopes);
+
+    std::vector<boost::shared_ptr<DiscretizedAsset> > assets;
+    std::vector<Real> expected;
+    for (Size k=0; k<n; ++k) {
+        DiscretizedRamp single(slopes[k]);
+        single.initialize(lattice, maturity);
+        single.rollback(0.0);
+        expected.push_back(single.presentValue());
+
+        boost::shared_ptr<DiscretizedAsset> asset(
+                                             new DiscretizedRamp(slopes[k]));
+        asset->initialize(lattice, maturity);
+        assets.push_back(asset);
+    }
+
+    tree->rollback(assets, 0.0);
+
+    Real tolerance = 1.0e-12;
+    for (Size k=0; k<n; ++k) {
+        Real calculated = assets[k]->presentValue();
+        if (std::fabs(calculated-expected[k]) > tolerance)
+            BOOST_ERROR("failed to reproduce single-asset rollback:"
+                        << "\n    slope:       " << slopes[k]
+                        << QL_FIXED << std::setprecision(12)
+                        << "\n    single:      " << expected[k]
+                        << "\n    multi-asset: " << calculated);
+    }
+}
+
+void ShortRateModelTest::testCachedTree() {
+    BOOST_MESSAGE("Testing Hull-White tree caching...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+    boost::shared_ptr<SimpleQuote> rate(new SimpleQuote(0.04));
+    Handle<YieldTermStructure> termStructure(flatRate(today, rate,
+                                                      Actual360()));
+    boost::shared_ptr<HullWhite> model(new HullWhite(termStructure,
+                                                     0.1, 0.01));
+
+    Time maturity = 10.0;
+    TimeGrid grid(maturity, 100);
+
+    boost::shared_ptr<Lattice> tree1 = model->tree(grid);
+    boost::shared_ptr<Lattice> tree2 = model->tree(grid);
+    if (tree1 != tree2)
+        BOOST_ERROR("tree not reused for unchanged model and grid");
+
+    Real tolerance = 1.0e-10;
+
+    // term-structure change: the fitting must be redone
+    rate->setValue(0.05);
+    boost::shared_ptr<Lattice> tree3 = model->tree(grid);
+    if (tree3 == tree1)
+        BOOST_ERROR("tree not refitted after term-structure change");
+
+    // parameter change: the branching must be rebuilt as well
+    Array params = model->params();
+    params[1] = 0.015;
+    model->setParams(params);
+    boost::shared_ptr<Lattice> tree4 = model->tree(grid);
+
+    boost::shared_ptr<Lattice> trees[] = { tree3, tree4 };
+    Real sigmas[] = { 0.01, model->sigma() };
+    for (Size k=0; k<LENGTH(trees); ++k) {
+        DiscretizedDiscountBond bond;
+        bond.initialize(trees[k], maturity);
+        bond.rollback(0.0);
+        Real calculated = bond.presentValue();
+
+        HullWhite reference(termStructure, model->a(), sigmas[k]);
+        DiscretizedDiscountBond referenceBond;
+        referenceBond.initialize(reference.tree(grid), maturity);
+        referenceBond.rollback(0.0);
+        Real expected = referenceBond.presentValue();
+
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("failed to reproduce discount bond on fresh tree:"
+                        << "\n    sigma:      " << sigmas[k]
+                        << QL_FIXED << std::setprecision(12)
+                        << "\n    cached:     " << calculated
+                        << "\n    fresh:      " << expected);
+    }
+}
+
 test_suite* ShortRateModelTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Short-rate model tests");
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite));
+    suite->add(QUANTLIB_TEST_CASE(
+                               &ShortRateModelTest::testParallelCalibration));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &ShortRateModelTest::testParallelTreeCalibration));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testSwaps));
     suite->add(QUANTLIB_TEST_CASE(
                               &ShortRateModelTest::testFuturesConvexityBias));
+    suite->add(QUANTLIB_TEST_CASE(
+                              &ShortRateModelTest::testMultiAssetRollback));
+    suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedTree));
     return suite;
 }
 
@@ -29,7 +29,11 @@ class ShortRateModelTest {
   public:
     static void testFuturesConvexityBias();
     static void testCachedHullWhite();
+    static void testParallelCalibration();
+    static void testParallelTreeCalibration();
     static void testSwaps();
+    static void testMultiAssetRollback();
+    static void testCachedTree();
     static boost::unit_test_framework::test_suite* suite();
 };
 
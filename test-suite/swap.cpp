@@ -23,6 +23,7 @@
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/time/daycounters/simpledaycounter.hpp>
@@ -35,6 +36,9 @@
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/currencies/europe.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/experimental/risk/scenarioanalysis.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -99,6 +103,37 @@ namespace {
         }
     };
 
+    class SwapMarketBuilder : public ScenarioMarketBuilder {
+      public:
+        void build(std::vector<boost::shared_ptr<SimpleQuote> >& quotes,
+                   std::vector<boost::shared_ptr<Instrument> >& swaps)
+                                                                    const {
+            quotes.clear();
+            swaps.clear();
+            quotes.push_back(boost::shared_ptr<SimpleQuote>(
+                                                     new SimpleQuote(0.05)));
+            quotes.push_back(boost::shared_ptr<SimpleQuote>(
+                                                     new SimpleQuote(0.04)));
+            Handle<YieldTermStructure> forecasting(
+                boost::shared_ptr<YieldTermStructure>(
+                    new FlatForward(0, TARGET(), Handle<Quote>(quotes[0]),
+                                    Actual365Fixed())));
+            Handle<YieldTermStructure> discounting(
+                boost::shared_ptr<YieldTermStructure>(
+                    new FlatForward(0, TARGET(), Handle<Quote>(quotes[1]),
+                                    Actual365Fixed())));
+            boost::shared_ptr<IborIndex> index(
+                                     new Euribor(6*Months, forecasting));
+            Integer lengths[] = { 2, 5, 10 };
+            for (Size i=0; i<LENGTH(lengths); ++i) {
+                boost::shared_ptr<VanillaSwap> swap =
+                    MakeVanillaSwap(lengths[i]*Years, index, 0.045)
+                    .withDiscountingTermStructure(discounting);
+                swaps.push_back(swap);
+            }
+        }
+    };
+
 }
 
 
@@ -323,6 +358,63 @@ void SwapTest::testCachedValue() {
 }
 
 
+void SwapTest::testScenarioRevaluation() {
+
+    BOOST_MESSAGE("Testing scenario revaluation of vanilla swaps...");
+
+    SavedSettings backup;
+    Settings::instance().evaluationDate() = Date(17, March, 2010);
+
+    std::vector<QuoteShifts> scenarios(6);
+    scenarios[0].push_back(std::make_pair(Size(0), 0.0010));
+    scenarios[1].push_back(std::make_pair(Size(1), -0.0020));
+    scenarios[1].push_back(std::make_pair(Size(0), 0.0005));
+    scenarios[2].push_back(std::make_pair(Size(0), 0.0010));
+    // scenarios[3] is the base scenario
+    scenarios[4].push_back(std::make_pair(Size(0), 0.0002));
+    scenarios[4].push_back(std::make_pair(Size(0), 0.0003));
+    scenarios[4].push_back(std::make_pair(Size(1), -0.0020));
+    scenarios[5].push_back(std::make_pair(Size(1), 0.0030));
+    scenarios[5].push_back(std::make_pair(Size(1), 0.0));
+
+    SwapMarketBuilder builder;
+    Matrix npvs = scenarioNPVs(builder, scenarios, 3);
+
+    std::vector<boost::shared_ptr<SimpleQuote> > quotes;
+    std::vector<boost::shared_ptr<Instrument> > swaps;
+    builder.build(quotes, swaps);
+    std::vector<Real> baseValues(quotes.size());
+    for (Size i=0; i<quotes.size(); ++i)
+        baseValues[i] = quotes[i]->value();
+
+    Real tolerance = 1.0e-10;
+    for (Size i=0; i<scenarios.size(); ++i) {
+        for (Size k=0; k<quotes.size(); ++k)
+            quotes[k]->setValue(baseValues[k]);
+        for (Size k=0; k<scenarios[i].size(); ++k) {
+            boost::shared_ptr<SimpleQuote> q = quotes[scenarios[i][k].first];
+            q->setValue(q->value() + scenarios[i][k].second);
+        }
+        for (Size j=0; j<swaps.size(); ++j) {
+            Real expected = swaps[j]->NPV();
+            if (std::fabs(npvs[i][j]-expected) > tolerance)
+                BOOST_ERROR("failed to reproduce bump-and-reprice value:"
+                            << "\n    scenario:   " << i
+                            << "\n    swap:       " << j
+                            << std::setprecision(12)
+                            << "\n    calculated: " << npvs[i][j]
+                            << "\n    expected:   " << expected);
+        }
+    }
+
+    for (Size j=0; j<swaps.size(); ++j) {
+        if (npvs[0][j] != npvs[2][j] || npvs[1][j] != npvs[4][j])
+            BOOST_ERROR("equivalent scenarios give different values "
+                        "for swap " << j);
+    }
+}
+
+
 test_suite* SwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Swap tests");
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testFairRate));
@@ -331,6 +423,7 @@ test_suite* SwapTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testSpreadDependency));
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testInArrears));
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testCachedValue));
+    suite->add(QUANTLIB_TEST_CASE(&SwapTest::testScenarioRevaluation));
     return suite;
 }
 
@@ -27,6 +27,7 @@
 #include <ql/termstructures/volatility/swaption/swaptionvolcube2.hpp>
 #include <ql/termstructures/volatility/swaption/swaptionvolcube1.hpp>
 #include <ql/termstructures/volatility/swaption/spreadedswaptionvol.hpp>
+#include <ql/math/optimization/levenbergmarquardt.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
 using namespace QuantLib;
@@ -440,6 +441,184 @@ void SwaptionVolatilityCubeTest::testObservability() {
     Settings::instance().evaluationDate() = referenceDate;
 }
 
+void SwaptionVolatilityCubeTest::testWarmStartedSabrCalibration() {
+
+    BOOST_MESSAGE("Testing parallel and warm-started sabr calibration...");
+
+    CommonVars vars;
+
+    std::vector<std::vector<Handle<Quote> > >
+        parametersGuess(vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size());
+    for (Size i=0; i<vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size(); i++) {
+        parametersGuess[i] = std::vector<Handle<Quote> >(4);
+        parametersGuess[i][0] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.2)));
+        parametersGuess[i][1] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.5)));
+        parametersGuess[i][2] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.4)));
+        parametersGuess[i][3] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.0)));
+    }
+    std::vector<bool> isParameterFixed(4, false);
+
+    SwaptionVolCube1 coldCube(vars.atmVolMatrix,
+                              vars.cube.tenors.options,
+                              vars.cube.tenors.swaps,
+                              vars.cube.strikeSpreads,
+                              vars.cube.volSpreadsHandle,
+                              vars.swapIndexBase,
+                              vars.shortSwapIndexBase,
+                              vars.vegaWeighedSmileFit,
+                              parametersGuess,
+                              isParameterFixed,
+                              true);
+    SwaptionVolCube1 warmCube(vars.atmVolMatrix,
+                              vars.cube.tenors.options,
+                              vars.cube.tenors.swaps,
+                              vars.cube.strikeSpreads,
+                              vars.cube.volSpreadsHandle,
+                              vars.swapIndexBase,
+                              vars.shortSwapIndexBase,
+                              vars.vegaWeighedSmileFit,
+                              parametersGuess,
+                              isParameterFixed,
+                              true,
+                              boost::shared_ptr<EndCriteria>(),
+                              Null<Real>(),
+                              boost::shared_ptr<OptimizationMethod>(),
+                              true, true);
+
+    for (Size n=0; n<2; ++n) {
+        // the first pass starts from the static guesses and must
+        // reproduce the default calibration; the second one starts
+        // from the previous results after a quote has been bumped.
+        Real tolerance = (n == 0) ? 1.0e-12 : 1.0e-4;
+        for (Size i=0; i<vars.cube.tenors.options.size(); i++) {
+            for (Size j=0; j<vars.cube.tenors.swaps.size(); j++) {
+                Rate atmStrike = coldCube.atmStrike(vars.cube.tenors.options[i],
+                                                    vars.cube.tenors.swaps[j]);
+                for (Size k=0; k<vars.cube.strikeSpreads.size(); k++) {
+                    Rate strike = atmStrike + vars.cube.strikeSpreads[k];
+                    Volatility expected =
+                        coldCube.volatility(vars.cube.tenors.options[i],
+                                            vars.cube.tenors.swaps[j],
+                                            strike, true);
+                    Volatility calculated =
+                        warmCube.volatility(vars.cube.tenors.options[i],
+                                            vars.cube.tenors.swaps[j],
+                                            strike, true);
+                    Volatility error = std::abs(expected-calculated);
+                    if (error > tolerance)
+                        BOOST_ERROR("\nwarm-started calibration failed:"
+                                    "\n    option tenor = " << vars.cube.tenors.options[i] <<
+                                    "\n      swap tenor = " << vars.cube.tenors.swaps[j] <<
+                                    "\n          strike = " << io::rate(strike) <<
+                                    "\n   expected vol  = " << io::volatility(expected) <<
+                                    "\n calculated vol  = " << io::volatility(calculated) <<
+                                    "\n           error = " << io::volatility(error) <<
+                                    "\n       tolerance = " << tolerance);
+                }
+            }
+        }
+
+        boost::shared_ptr<SimpleQuote> q =
+            boost::dynamic_pointer_cast<SimpleQuote>(
+                                   vars.cube.volSpreadsHandle[4][0].currentLink());
+        q->setValue(q->value() + 0.0010);
+    }
+}
+
+void SwaptionVolatilityCubeTest::testParallelLevenbergMarquardtCalibration() {
+
+    BOOST_MESSAGE("Testing parallel sabr calibration "
+                  "with the analytic jacobian...");
+
+    CommonVars vars;
+
+    // the alpha guess gives at-the-money volatilities of the
+    // right magnitude; Levenberg-Marquardt is a local method
+    std::vector<std::vector<Handle<Quote> > >
+        parametersGuess(vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size());
+    for (Size i=0; i<vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size(); i++) {
+        parametersGuess[i] = std::vector<Handle<Quote> >(4);
+        parametersGuess[i][0] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.04)));
+        parametersGuess[i][1] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.5)));
+        parametersGuess[i][2] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.4)));
+        parametersGuess[i][3] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.0)));
+    }
+    std::vector<bool> isParameterFixed(4, false);
+
+    // each cube gets its own instance; the parallel one copies it
+    // for each fit
+    SwaptionVolCube1 serialCube(vars.atmVolMatrix,
+                                vars.cube.tenors.options,
+                                vars.cube.tenors.swaps,
+                                vars.cube.strikeSpreads,
+                                vars.cube.volSpreadsHandle,
+                                vars.swapIndexBase,
+                                vars.shortSwapIndexBase,
+                                vars.vegaWeighedSmileFit,
+                                parametersGuess,
+                                isParameterFixed,
+                                true,
+                                boost::shared_ptr<EndCriteria>(),
+                                Null<Real>(),
+                                boost::shared_ptr<OptimizationMethod>(
+                                    new LevenbergMarquardt(1e-8, 1e-8, 1e-8,
+                                                           true)));
+    SwaptionVolCube1 parallelCube(vars.atmVolMatrix,
+                                  vars.cube.tenors.options,
+                                  vars.cube.tenors.swaps,
+                                  vars.cube.strikeSpreads,
+                                  vars.cube.volSpreadsHandle,
+                                  vars.swapIndexBase,
+                                  vars.shortSwapIndexBase,
+                                  vars.vegaWeighedSmileFit,
+                                  parametersGuess,
+                                  isParameterFixed,
+                                  true,
+                                  boost::shared_ptr<EndCriteria>(),
+                                  Null<Real>(),
+                                  boost::shared_ptr<OptimizationMethod>(
+                                      new LevenbergMarquardt(1e-8, 1e-8, 1e-8,
+                                                             true)),
+                                  true);
+
+    Real tolerance = 1.0e-12;
+    for (Size i=0; i<vars.cube.tenors.options.size(); i++) {
+        for (Size j=0; j<vars.cube.tenors.swaps.size(); j++) {
+            Rate atmStrike = serialCube.atmStrike(vars.cube.tenors.options[i],
+                                                  vars.cube.tenors.swaps[j]);
+            for (Size k=0; k<vars.cube.strikeSpreads.size(); k++) {
+                Rate strike = atmStrike + vars.cube.strikeSpreads[k];
+                Volatility expected =
+                    serialCube.volatility(vars.cube.tenors.options[i],
+                                          vars.cube.tenors.swaps[j],
+                                          strike, true);
+                Volatility calculated =
+                    parallelCube.volatility(vars.cube.tenors.options[i],
+                                            vars.cube.tenors.swaps[j],
+                                            strike, true);
+                Volatility error = std::abs(expected-calculated);
+                if (error > tolerance)
+                    BOOST_ERROR("\nparallel calibration failed:"
+                                "\n    option tenor = " << vars.cube.tenors.options[i] <<
+                                "\n      swap tenor = " << vars.cube.tenors.swaps[j] <<
+                                "\n          strike = " << io::rate(strike) <<
+                                "\n   expected vol  = " << io::volatility(expected) <<
+                                "\n calculated vol  = " << io::volatility(calculated) <<
+                                "\n           error = " << io::volatility(error) <<
+                                "\n       tolerance = " << tolerance);
+            }
+        }
+    }
+}
+
 test_suite* SwaptionVolatilityCubeTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Swaption Volatility Cube tests");
 
@@ -457,5 +636,11 @@ test_suite* SwaptionVolatilityCubeTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(
                              &SwaptionVolatilityCubeTest::testObservability));
 
+    suite->add(QUANTLIB_TEST_CASE(
+               &SwaptionVolatilityCubeTest::testWarmStartedSabrCalibration));
+
+    suite->add(QUANTLIB_TEST_CASE(
+     &SwaptionVolatilityCubeTest::testParallelLevenbergMarquardtCalibration));
+
     return suite;
 }
@@ -31,6 +31,8 @@
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/indexes/iborindex.hpp>
+#include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmaffinemodeltermstructure.hpp>
 #include <ql/currency.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
@@ -299,6 +301,123 @@ void TermStructureTest::testZSpreadedObs() {
 }
 
 
+void TermStructureTest::testDiscountCache() {
+
+    BOOST_MESSAGE("Testing cached discount factors and fixings...");
+
+    CommonVars vars;
+
+    boost::shared_ptr<SimpleQuote> flatRate(new SimpleQuote(0.03));
+    Handle<Quote> flatRateHandle(flatRate);
+    boost::shared_ptr<YieldTermStructure> flatCurve(
+                          new FlatForward(vars.settlementDays, NullCalendar(),
+                                          flatRateHandle, Actual360()));
+    Handle<YieldTermStructure> flatHandle(flatCurve);
+    boost::shared_ptr<IborIndex> index(new IborIndex("dummy", 6*Months,
+                                                     vars.settlementDays,
+                                                     Currency(),
+                                                     vars.calendar,
+                                                     ModifiedFollowing,
+                                                     false, Actual360(),
+                                                     flatHandle));
+
+    // a moving bootstrapped curve, so that the reference date of
+    // both curves follows the evaluation date
+    boost::shared_ptr<SimpleQuote> depositRate(new SimpleQuote(0.03));
+    Handle<Quote> depositRateHandle(depositRate);
+    Integer months[] = { 1, 3, 6, 12 };
+    std::vector<boost::shared_ptr<RateHelper> > helpers(LENGTH(months));
+    for (Size i=0; i<LENGTH(months); ++i)
+        helpers[i] = boost::shared_ptr<RateHelper>(
+            new DepositRateHelper(depositRateHandle, months[i]*Months,
+                                  vars.settlementDays, vars.calendar,
+                                  ModifiedFollowing, false, Actual360()));
+    boost::shared_ptr<YieldTermStructure> bootstrappedCurve(
+        new PiecewiseYieldCurve<Discount,LogLinear>(vars.settlementDays,
+                                                    vars.calendar, helpers,
+                                                    Actual360()));
+    bootstrappedCurve->enableExtrapolation();
+
+    boost::shared_ptr<YieldTermStructure> curves[] = {
+        flatCurve, bootstrappedCurve
+    };
+    for (Size k=0; k<LENGTH(curves); ++k)
+        curves[k]->enableDiscountCache();
+    index->enableFixingCache();
+
+    Integer days[] = { 10, 30, 60, 120, 360, 720, 3600 };
+    Rate rates[] = { 0.03, 0.05 };
+
+    for (Size r=0; r<LENGTH(rates); ++r) {
+        flatRate->setValue(rates[r]);
+        depositRate->setValue(rates[r]);
+        for (Size s=0; s<2; ++s) {
+            Date today = Settings::instance().evaluationDate();
+            for (Size k=0; k<LENGTH(curves); ++k) {
+                for (Size i=0; i<LENGTH(days); ++i) {
+                    Date d = today + days[i];
+                    // twice, so that the second call hits the cache
+                    curves[k]->discount(d);
+                    DiscountFactor cached = curves[k]->discount(d);
+                    DiscountFactor expected =
+                        curves[k]->discount(curves[k]->timeFromReference(d));
+                    if (cached != expected)
+                        BOOST_ERROR("cached discount differs from "
+                                    "calculated one:"
+                                    << "\n    curve:      " << k
+                                    << "\n    date:       " << d
+                                    << std::setprecision(12)
+                                    << "\n    cached:     " << cached
+                                    << "\n    calculated: " << expected);
+                }
+            }
+
+            for (Size i=0; i<LENGTH(days); ++i) {
+                Date fixingDate = vars.calendar.adjust(today + days[i]);
+                index->fixing(fixingDate);
+                Rate cached = index->fixing(fixingDate);
+                Date d1 = index->valueDate(fixingDate);
+                Date d2 = index->maturityDate(d1);
+                Time t = index->dayCounter().yearFraction(d1, d2);
+                Rate expected = (flatCurve->discount(d1)/
+                                 flatCurve->discount(d2) - 1.0) / t;
+                if (std::fabs(cached - expected) > 1.0e-15)
+                    BOOST_ERROR("cached fixing differs from "
+                                "calculated one:"
+                                << "\n    fixing date: " << fixingDate
+                                << std::setprecision(12)
+                                << "\n    cached:      " << cached
+                                << "\n    calculated:  " << expected);
+            }
+
+            // the cached values must be discarded when the
+            // evaluation date moves
+            Settings::instance().evaluationDate() =
+                vars.calendar.advance(today, 1, Months);
+        }
+    }
+
+    // the FDM term structure changes its state without going
+    // through update()
+    Date today = Settings::instance().evaluationDate();
+    boost::shared_ptr<AffineModel> model(new HullWhite(flatHandle));
+    FdmAffineModelTermStructure fdmCurve(Array(1, 0.03), NullCalendar(),
+                                         Actual360(), today, today, model);
+    fdmCurve.enableDiscountCache();
+    Date d = today + 360;
+    fdmCurve.discount(d);
+    fdmCurve.setVariable(Array(1, 0.05));
+    DiscountFactor cached = fdmCurve.discount(d);
+    DiscountFactor expected =
+        fdmCurve.discount(fdmCurve.timeFromReference(d));
+    if (cached != expected)
+        BOOST_ERROR("cached discount not updated after state change:"
+                    << std::setprecision(12)
+                    << "\n    cached:     " << cached
+                    << "\n    calculated: " << expected);
+}
+
+
 test_suite* TermStructureTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Term structure tests");
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testReferenceChange));
@@ -308,6 +427,7 @@ test_suite* TermStructureTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testFSpreadedObs));
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testZSpreaded));
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testZSpreadedObs));
+    suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testDiscountCache));
     return suite;
 }
 